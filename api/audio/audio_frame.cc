@@ -17,10 +17,9 @@
 
 namespace webrtc {
 
-AudioFrame::AudioFrame() {
-  // Visual Studio doesn't like this in the class definition.
-  static_assert(sizeof(data_) == kMaxDataSizeBytes, "kMaxDataSizeBytes");
-}
+AudioFrame::AudioFrame() = default;
+
+AudioFrame::~AudioFrame() = default;
 
 void AudioFrame::Reset() {
   ResetWithoutMuting();
@@ -65,7 +64,7 @@ void AudioFrame::UpdateFrame(uint32_t timestamp,
   const size_t length = samples_per_channel * num_channels;
   RTC_CHECK_LE(length, kMaxDataSizeSamples);
   if (data != nullptr) {
-    memcpy(data_, data, sizeof(int16_t) * length);
+    memcpy(allocated_data(), data, sizeof(int16_t) * length);
     muted_ = false;
   } else {
     muted_ = true;
@@ -92,7 +91,7 @@ void AudioFrame::CopyFrom(const AudioFrame& src) {
   const size_t length = samples_per_channel_ * num_channels_;
   RTC_CHECK_LE(length, kMaxDataSizeSamples);
   if (!src.muted()) {
-    memcpy(data_, src.data(), sizeof(int16_t) * length);
+    memcpy(allocated_data(), src.data(), sizeof(int16_t) * length);
     muted_ = false;
   }
 }
@@ -110,17 +109,17 @@ int64_t AudioFrame::ElapsedProfileTimeMs() const {
 }
 
 const int16_t* AudioFrame::data() const {
-  return muted_ ? empty_data() : data_;
+  return muted_ ? empty_data() : data_.get();
 }
 
 // TODO(henrik.lundin) Can we skip zeroing the buffer?
 // See https://bugs.chromium.org/p/webrtc/issues/detail?id=5647.
 int16_t* AudioFrame::mutable_data() {
   if (muted_) {
-    memset(data_, 0, kMaxDataSizeBytes);
+    memset(allocated_data(), 0, kMaxDataSizeBytes);
     muted_ = false;
   }
-  return data_;
+  return data_.get();
 }
 
 void AudioFrame::Mute() {
@@ -131,6 +130,13 @@ bool AudioFrame::muted() const {
   return muted_;
 }
 
+int16_t* AudioFrame::allocated_data() {
+  if (!data_) {
+    data_.reset(new int16_t[kMaxDataSizeSamples]);
+  }
+  return data_.get();
+}
+
 // static
 const int16_t* AudioFrame::empty_data() {
   static int16_t* null_data = new int16_t[kMaxDataSizeSamples]();
@@ -14,6 +14,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <memory>
+
 #include "api/audio/channel_layout.h"
 #include "api/rtp_packet_infos.h"
 
@@ -29,6 +31,8 @@ namespace webrtc {
  *   should be prepared for that.
  * - The total number of samples is samples_per_channel_ * num_channels_.
  * - Stereo data is interleaved starting with the left channel.
+ * - The sample buffer is allocated on the first write, so frames that stay
+ *   muted don't carry it.
  */
 class AudioFrame {
  public:
@@ -56,6 +60,7 @@ class AudioFrame {
   };
 
   AudioFrame();
+  ~AudioFrame();
 
   AudioFrame(const AudioFrame&) = delete;
   AudioFrame& operator=(const AudioFrame&) = delete;
@@ -158,7 +163,11 @@ class AudioFrame {
   // buffer per translation unit is to wrap a static in an inline function.
   static const int16_t* empty_data();
 
-  int16_t data_[kMaxDataSizeSamples];
+  // Returns the sample buffer, allocating it if needed. Its contents are
+  // undefined after the allocation.
+  int16_t* allocated_data();
+
+  std::unique_ptr<int16_t[]> data_;
   bool muted_ = true;
 
   // Absolute capture timestamp when this audio frame was originally captured.
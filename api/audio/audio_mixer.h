@@ -13,6 +13,7 @@
 
 #include <memory>
 
+#include "absl/types/optional.h"
 #include "api/audio/audio_frame.h"
 #include "rtc_base/ref_count.h"
 
@@ -48,6 +49,21 @@ class AudioMixer : public rtc::RefCountInterface {
     // with this sample rate or higher will not cause quality loss.
     virtual int PreferredSampleRate() const = 0;
 
+    // Returns the audio level of the most recently received audio in -dBov
+    // (0 is the loudest, 127 is silence), if known without producing a frame,
+    // e.g. from the RFC 6464 audio level header extension. Lets a mixer
+    // rank sources before pulling any audio from them. Sources that have
+    // stopped receiving audio should report silence rather than their last
+    // level.
+    virtual absl::optional<int> AudioLevelHint() const {
+      return absl::nullopt;
+    }
+
+    // Called by a mixer that skipped pulling audio from this source, e.g.
+    // because its AudioLevelHint() ranked too low, before pulling from it
+    // again. The audio buffered meanwhile is stale and should be dropped.
+    virtual void DiscardBufferedAudio() {}
+
     virtual ~Source() {}
   };
 
@@ -63,6 +63,41 @@ TEST(AudioFrameTest, MutedFrameBufferIsZeroed) {
   EXPECT_TRUE(AllSamplesAre(0, frame));
 }
 
+TEST(AudioFrameTest, MutedFrameIsZeroedAfterFirstWrite) {
+  constexpr size_t kNumSamples = kNumChannelsStereo * kSamplesPerChannel;
+  AudioFrame frame;
+  EXPECT_TRUE(frame.muted());
+  EXPECT_TRUE(AllSamplesAre(0, frame));
+
+  int16_t samples[kNumSamples];
+  for (size_t i = 0; i < kNumSamples; ++i) {
+    samples[i] = static_cast<int16_t>(i);
+  }
+  frame.UpdateFrame(kTimestamp, samples, kSamplesPerChannel, kSampleRateHz,
+                    AudioFrame::kNormalSpeech, AudioFrame::kVadActive,
+                    kNumChannelsStereo);
+  EXPECT_FALSE(frame.muted());
+  EXPECT_EQ(0, memcmp(samples, frame.data(), sizeof(samples)));
+
+  frame.Mute();
+  EXPECT_TRUE(AllSamplesAre(0, frame));
+  frame.mutable_data();
+  EXPECT_TRUE(AllSamplesAre(0, frame));
+}
+
+TEST(AudioFrameTest, CopyFromIntoUnwrittenFrame) {
+  AudioFrame frame1;
+  AudioFrame frame2;
+
+  int16_t samples[kNumChannelsMono * kSamplesPerChannel] = {17, -3, 5};
+  frame2.UpdateFrame(kTimestamp, samples, kSamplesPerChannel, kSampleRateHz,
+                     AudioFrame::kNormalSpeech, AudioFrame::kVadActive,
+                     kNumChannelsMono);
+  frame1.CopyFrom(frame2);
+  EXPECT_FALSE(frame1.muted());
+  EXPECT_EQ(0, memcmp(frame2.data(), frame1.data(), sizeof(samples)));
+}
+
 TEST(AudioFrameTest, UpdateFrameMono) {
   AudioFrame frame;
   int16_t samples[kNumChannelsMono * kSamplesPerChannel] = {17};
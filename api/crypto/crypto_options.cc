@@ -63,6 +63,9 @@ bool CryptoOptions::operator==(const CryptoOptions& other) const {
       bool enable_aes128_sha1_80_crypto_cipher;
       bool enable_encrypted_rtp_header_extensions;
     } srtp;
+    struct Dtls {
+      bool enable_session_resumption;
+    } dtls;
     struct SFrame {
       bool require_frame_encryption;
     } sframe;
@@ -78,6 +81,8 @@ bool CryptoOptions::operator==(const CryptoOptions& other) const {
              other.srtp.enable_aes128_sha1_80_crypto_cipher &&
          srtp.enable_encrypted_rtp_header_extensions ==
              other.srtp.enable_encrypted_rtp_header_extensions &&
+         dtls.enable_session_resumption ==
+             other.dtls.enable_session_resumption &&
          sframe.require_frame_encryption ==
              other.sframe.require_frame_encryption;
 }
@@ -58,6 +58,15 @@ struct RTC_EXPORT CryptoOptions {
     bool enable_encrypted_rtp_header_extensions = false;
   } srtp;
 
+  // DTLS Related Peer Connection options.
+  struct Dtls {
+    // If set to true, DTLS sessions are cached for the process and resumed
+    // when a transport with the same local certificate and remote fingerprint
+    // is set up again, e.g. after an ICE restart. This saves the key exchange
+    // and signatures of a full handshake. Both peers must enable it.
+    bool enable_session_resumption = false;
+  } dtls;
+
   // Options to be used when the FrameEncryptor / FrameDecryptor APIs are used.
   struct SFrame {
     // If set all RtpSenders must have an FrameEncryptor attached to them before
@@ -24,6 +24,7 @@ namespace cricket {
 class IceTransportInternal;
 class PortAllocator;
 class IceControllerFactoryInterface;
+class IcePingScheduler;
 }  // namespace cricket
 
 namespace webrtc {
@@ -84,6 +85,13 @@ struct IceTransportInit final {
     return ice_controller_factory_;
   }
 
+  // Shared by the transports of a server, so that their connectivity checks
+  // are paced and sent from the same wakeups. Must outlive the transports.
+  void set_ping_scheduler(cricket::IcePingScheduler* ping_scheduler) {
+    ping_scheduler_ = ping_scheduler;
+  }
+  cricket::IcePingScheduler* ping_scheduler() { return ping_scheduler_; }
+
   const FieldTrialsView* field_trials() { return field_trials_; }
   void set_field_trials(const FieldTrialsView* field_trials) {
     field_trials_ = field_trials;
@@ -96,6 +104,7 @@ struct IceTransportInit final {
   AsyncResolverFactory* async_resolver_factory_ = nullptr;
   RtcEventLog* event_log_ = nullptr;
   cricket::IceControllerFactoryInterface* ice_controller_factory_ = nullptr;
+  cricket::IcePingScheduler* ping_scheduler_ = nullptr;
   const FieldTrialsView* field_trials_ = nullptr;
   // TODO(https://crbug.com/webrtc/12657): Redesign to have const members.
 };
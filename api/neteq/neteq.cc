@@ -31,6 +31,10 @@ std::string NetEq::Config::ToString() const {
      << (enable_fast_accelerate ? "true" : "false")
      << ", enable_muted_state=" << (enable_muted_state ? "true" : "false")
      << ", enable_rtx_handling=" << (enable_rtx_handling ? "true" : "false");
+  if (release_idle_decoders_after_ms) {
+    ss << ", release_idle_decoders_after_ms="
+       << *release_idle_decoders_after_ms;
+  }
   return ss.str();
 }
 
@@ -135,6 +135,10 @@ class NetEq {
     int min_delay_ms = 0;
     bool enable_fast_accelerate = false;
     bool enable_muted_state = false;
+    // If set, the audio decoders are released once the stream has been in
+    // muted state for this long, and created again from the decoder factory
+    // when packets arrive. Only has an effect with `enable_muted_state`.
+    absl::optional<int> release_idle_decoders_after_ms;
     bool enable_rtx_handling = false;
     absl::optional<AudioCodecPairId> codec_pair_id;
     bool for_test_no_time_stretching = false;  // Use only for testing.
@@ -133,6 +133,7 @@
 #include "rtc_base/ref_count.h"
 #include "rtc_base/rtc_certificate.h"
 #include "rtc_base/rtc_certificate_generator.h"
+#include "rtc_base/rtc_certificate_pool.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/ssl_certificate.h"
 #include "rtc_base/ssl_stream_adapter.h"
@@ -1442,6 +1443,10 @@ struct RTC_EXPORT PeerConnectionFactoryDependencies final {
   std::unique_ptr<RtpTransportControllerSendFactoryInterface>
       transport_controller_send_factory;
   std::unique_ptr<Metronome> metronome;
+  // If set, PeerConnections created without a `cert_generator` take their
+  // certificate from this pool when it has a matching one ready, instead of
+  // generating it. The pool may be shared between factories.
+  rtc::scoped_refptr<rtc::RTCCertificatePool> certificate_pool;
 };
 
 // PeerConnectionFactoryInterface is the factory interface used for creating
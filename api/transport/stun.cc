@@ -36,6 +36,38 @@ const int k127Utf8CharactersLengthInBytes = 508;
 const int kMessageIntegrityAttributeLength = 20;
 const int kTheoreticalMaximumAttributeLength = 65535;
 
+// Checks the integrity attribute at `mi_pos` in the message in `data`: the
+// HMAC-SHA1 of the message up to the attribute, with the length in the header
+// adjusted as if the message ended after the attribute (RFC 5389, section
+// 15.4), must start with the `mi_attr_size` bytes of the attribute value.
+// Only the header is copied to adjust the length.
+bool MessageIntegrityMatches(const char* data,
+                             size_t mi_pos,
+                             size_t mi_attr_size,
+                             const StunMessageIntegrityKey& key) {
+  char header[kStunHeaderSize];
+  memcpy(header, data, kStunHeaderSize);
+  // Writing the adjusted length @ Message Length in the copy.
+  //      0                   1                   2                   3
+  //      0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+  //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  //     |0 0|     STUN Message Type     |         Message Length        |
+  //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  const size_t adjusted_length =
+      mi_pos + kStunAttributeHeaderSize + mi_attr_size - kStunHeaderSize;
+  rtc::SetBE16(header + 2, static_cast<uint16_t>(adjusted_length));
+
+  char hmac[kStunMessageIntegritySize];
+  key.ComputeHmac(
+      absl::string_view(header, kStunHeaderSize),
+      absl::string_view(data + kStunHeaderSize, mi_pos - kStunHeaderSize),
+      hmac);
+
+  // Comparing the calculated HMAC with the one present in the message.
+  return memcmp(data + mi_pos + kStunAttributeHeaderSize, hmac,
+                mi_attr_size) == 0;
+}
+
 uint32_t ReduceTransactionId(absl::string_view transaction_id) {
   RTC_DCHECK(transaction_id.length() == cricket::kStunTransactionIdLength ||
              transaction_id.length() == cricket::kStunLegacyTransactionIdLength)
@@ -103,6 +135,38 @@ const int SERVER_NOT_REACHABLE_ERROR = 701;
 
 // StunMessage
 
+StunMessageIntegrityKey::StunMessageIntegrityKey()
+    : StunMessageIntegrityKey(absl::string_view()) {}
+
+StunMessageIntegrityKey::StunMessageIntegrityKey(absl::string_view password)
+    : password_(password),
+      hmac_(rtc::MessageDigestFactory::CreateHmac(rtc::DIGEST_SHA_1,
+                                                  password)) {
+  RTC_DCHECK(hmac_);
+}
+
+StunMessageIntegrityKey::~StunMessageIntegrityKey() = default;
+
+void StunMessageIntegrityKey::SetPassword(absl::string_view password) {
+  if (password == password_) {
+    return;
+  }
+  password_ = std::string(password);
+  hmac_.reset(
+      rtc::MessageDigestFactory::CreateHmac(rtc::DIGEST_SHA_1, password));
+  RTC_DCHECK(hmac_);
+}
+
+void StunMessageIntegrityKey::ComputeHmac(
+    absl::string_view header,
+    absl::string_view body,
+    char hmac[kStunMessageIntegritySize]) const {
+  hmac_->Update(header.data(), header.size());
+  hmac_->Update(body.data(), body.size());
+  size_t ret = hmac_->Finish(hmac, kStunMessageIntegritySize);
+  RTC_DCHECK_EQ(ret, kStunMessageIntegritySize);
+}
+
 StunMessage::StunMessage()
     : StunMessage(STUN_INVALID_MESSAGE_TYPE, EMPTY_TRANSACTION_ID) {}
 
@@ -238,11 +302,16 @@ const StunUInt16ListAttribute* StunMessage::GetUnknownAttributes() const {
 
 StunMessage::IntegrityStatus StunMessage::ValidateMessageIntegrity(
     const std::string& password) {
-  password_ = password;
+  return ValidateMessageIntegrity(StunMessageIntegrityKey(password));
+}
+
+StunMessage::IntegrityStatus StunMessage::ValidateMessageIntegrity(
+    const StunMessageIntegrityKey& key) {
+  password_ = key.password();
   if (GetByteString(STUN_ATTR_MESSAGE_INTEGRITY)) {
     if (ValidateMessageIntegrityOfType(
             STUN_ATTR_MESSAGE_INTEGRITY, kStunMessageIntegritySize,
-            buffer_.c_str(), buffer_.size(), password)) {
+            buffer_.c_str(), buffer_.size(), key)) {
       integrity_ = IntegrityStatus::kIntegrityOk;
     } else {
       integrity_ = IntegrityStatus::kIntegrityBad;
@@ -250,7 +319,7 @@ StunMessage::IntegrityStatus StunMessage::ValidateMessageIntegrity(
   } else if (GetByteString(STUN_ATTR_GOOG_MESSAGE_INTEGRITY_32)) {
     if (ValidateMessageIntegrityOfType(
             STUN_ATTR_GOOG_MESSAGE_INTEGRITY_32, kStunMessageIntegrity32Size,
-            buffer_.c_str(), buffer_.size(), password)) {
+            buffer_.c_str(), buffer_.size(), key)) {
       integrity_ = IntegrityStatus::kIntegrityOk;
     } else {
       integrity_ = IntegrityStatus::kIntegrityBad;
@@ -266,7 +335,7 @@ bool StunMessage::ValidateMessageIntegrity(const char* data,
                                            const std::string& password) {
   return ValidateMessageIntegrityOfType(STUN_ATTR_MESSAGE_INTEGRITY,
                                         kStunMessageIntegritySize, data, size,
-                                        password);
+                                        StunMessageIntegrityKey(password));
 }
 
 bool StunMessage::ValidateMessageIntegrity32(const char* data,
@@ -274,16 +343,17 @@ bool StunMessage::ValidateMessageIntegrity32(const char* data,
                                              const std::string& password) {
   return ValidateMessageIntegrityOfType(STUN_ATTR_GOOG_MESSAGE_INTEGRITY_32,
                                         kStunMessageIntegrity32Size, data, size,
-                                        password);
+                                        StunMessageIntegrityKey(password));
 }
 
 // Verifies a STUN message has a valid MESSAGE-INTEGRITY attribute, using the
 // procedure outlined in RFC 5389, section 15.4.
-bool StunMessage::ValidateMessageIntegrityOfType(int mi_attr_type,
-                                                 size_t mi_attr_size,
-                                                 const char* data,
-                                                 size_t size,
-                                                 const std::string& password) {
+bool StunMessage::ValidateMessageIntegrityOfType(
+    int mi_attr_type,
+    size_t mi_attr_size,
+    const char* data,
+    size_t size,
+    const StunMessageIntegrityKey& key) {
   RTC_DCHECK(mi_attr_size <= kStunMessageIntegritySize);
 
   // Verifying the size of the message.
@@ -328,53 +398,31 @@ bool StunMessage::ValidateMessageIntegrityOfType(int mi_attr_type,
     return false;
   }
 
-  // Getting length of the message to calculate Message Integrity.
-  size_t mi_pos = current_pos;
-  std::unique_ptr<char[]> temp_data(new char[current_pos]);
-  memcpy(temp_data.get(), data, current_pos);
-  if (size > mi_pos + kStunAttributeHeaderSize + mi_attr_size) {
-    // Stun message has other attributes after message integrity.
-    // Adjust the length parameter in stun message to calculate HMAC.
-    size_t extra_offset =
-        size - (mi_pos + kStunAttributeHeaderSize + mi_attr_size);
-    size_t new_adjusted_len = size - extra_offset - kStunHeaderSize;
-
-    // Writing new length of the STUN message @ Message Length in temp buffer.
-    //      0                   1                   2                   3
-    //      0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
-    //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-    //     |0 0|     STUN Message Type     |         Message Length        |
-    //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-    rtc::SetBE16(temp_data.get() + 2, static_cast<uint16_t>(new_adjusted_len));
-  }
-
-  char hmac[kStunMessageIntegritySize];
-  size_t ret =
-      rtc::ComputeHmac(rtc::DIGEST_SHA_1, password.c_str(), password.size(),
-                       temp_data.get(), mi_pos, hmac, sizeof(hmac));
-  RTC_DCHECK(ret == sizeof(hmac));
-  if (ret != sizeof(hmac)) {
-    return false;
-  }
-
-  // Comparing the calculated HMAC with the one present in the message.
-  return memcmp(data + current_pos + kStunAttributeHeaderSize, hmac,
-                mi_attr_size) == 0;
+  return MessageIntegrityMatches(data, current_pos, mi_attr_size, key);
 }
 
 bool StunMessage::AddMessageIntegrity(absl::string_view password) {
+  return AddMessageIntegrity(StunMessageIntegrityKey(password));
+}
+
+bool StunMessage::AddMessageIntegrity(const StunMessageIntegrityKey& key) {
   return AddMessageIntegrityOfType(STUN_ATTR_MESSAGE_INTEGRITY,
-                                   kStunMessageIntegritySize, password);
+                                   kStunMessageIntegritySize, key);
 }
 
 bool StunMessage::AddMessageIntegrity32(absl::string_view password) {
+  return AddMessageIntegrity32(StunMessageIntegrityKey(password));
+}
+
+bool StunMessage::AddMessageIntegrity32(const StunMessageIntegrityKey& key) {
   return AddMessageIntegrityOfType(STUN_ATTR_GOOG_MESSAGE_INTEGRITY_32,
-                                   kStunMessageIntegrity32Size, password);
+                                   kStunMessageIntegrity32Size, key);
 }
 
-bool StunMessage::AddMessageIntegrityOfType(int attr_type,
-                                            size_t attr_size,
-                                            absl::string_view key) {
+bool StunMessage::AddMessageIntegrityOfType(
+    int attr_type,
+    size_t attr_size,
+    const StunMessageIntegrityKey& key) {
   // Add the attribute with a dummy value. Since this is a known attribute, it
   // can't fail.
   RTC_DCHECK(attr_size <= kStunMessageIntegritySize);
@@ -391,19 +439,12 @@ bool StunMessage::AddMessageIntegrityOfType(int attr_type,
   int msg_len_for_hmac = static_cast<int>(
       buf.Length() - kStunAttributeHeaderSize - msg_integrity_attr->length());
   char hmac[kStunMessageIntegritySize];
-  size_t ret =
-      rtc::ComputeHmac(rtc::DIGEST_SHA_1, key.data(), key.size(), buf.Data(),
-                       msg_len_for_hmac, hmac, sizeof(hmac));
-  RTC_DCHECK(ret == sizeof(hmac));
-  if (ret != sizeof(hmac)) {
-    RTC_LOG(LS_ERROR) << "HMAC computation failed. Message-Integrity "
-                         "has dummy value.";
-    return false;
-  }
+  key.ComputeHmac(absl::string_view(buf.Data(), msg_len_for_hmac),
+                  absl::string_view(), hmac);
 
   // Insert correct HMAC into the attribute.
   msg_integrity_attr->CopyBytes(hmac, attr_size);
-  password_ = std::string(key);
+  password_ = key.password();
   integrity_ = IntegrityStatus::kIntegrityOk;
   return true;
 }
@@ -697,6 +738,151 @@ bool StunMessage::EqualAttributes(
   return true;
 }
 
+bool StunMessageView::Parse(const char* data, size_t size) {
+  data_ = data;
+  size_ = size;
+  type_ = STUN_INVALID_MESSAGE_TYPE;
+  attributes_.clear();
+  if (size < kStunHeaderSize || size % 4 != 0 ||
+      rtc::GetBE16(data + 2) != size - kStunHeaderSize ||
+      rtc::GetBE32(data + kStunTransactionIdOffset - kStunMagicCookieLength) !=
+          kStunMagicCookie) {
+    return false;
+  }
+  // RTP and RTCP set the MSB of the first byte.
+  const uint16_t type = rtc::GetBE16(data);
+  if (type & 0x8000) {
+    return false;
+  }
+
+  size_t pos = kStunHeaderSize;
+  while (pos < size) {
+    if (size - pos < kStunAttributeHeaderSize) {
+      return false;
+    }
+    const uint16_t attr_type = rtc::GetBE16(data + pos);
+    const uint16_t attr_length = rtc::GetBE16(data + pos + 2);
+    // Attributes are padded to a multiple of four bytes.
+    const size_t padded_length = (attr_length + 3) & ~size_t{3};
+    if (size - pos - kStunAttributeHeaderSize < padded_length) {
+      return false;
+    }
+    attributes_.push_back(
+        {attr_type, attr_length, static_cast<uint32_t>(pos)});
+    pos += kStunAttributeHeaderSize + padded_length;
+  }
+  type_ = type;
+  return true;
+}
+
+absl::string_view StunMessageView::transaction_id() const {
+  RTC_DCHECK(data_);
+  return absl::string_view(data_ + kStunTransactionIdOffset,
+                           kStunTransactionIdLength);
+}
+
+uint32_t StunMessageView::reduced_transaction_id() const {
+  return ReduceTransactionId(transaction_id());
+}
+
+bool StunMessageView::HasAttribute(int type) const {
+  return FindAttribute(type) != nullptr;
+}
+
+bool StunMessageView::HasOnlyAttributes(rtc::ArrayView<const int> types) const {
+  for (const Attribute& attr : attributes_) {
+    if (std::find(types.begin(), types.end(), attr.type) == types.end()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool StunMessageView::GetUInt32(int type, uint32_t* value) const {
+  const Attribute* attr = FindAttribute(type);
+  if (!attr || attr->length != StunUInt32Attribute::SIZE) {
+    return false;
+  }
+  *value = rtc::GetBE32(data_ + attr->offset + kStunAttributeHeaderSize);
+  return true;
+}
+
+bool StunMessageView::GetUInt64(int type, uint64_t* value) const {
+  const Attribute* attr = FindAttribute(type);
+  if (!attr || attr->length != StunUInt64Attribute::SIZE) {
+    return false;
+  }
+  *value = rtc::GetBE64(data_ + attr->offset + kStunAttributeHeaderSize);
+  return true;
+}
+
+absl::string_view StunMessageView::GetAttributeValue(int type) const {
+  const Attribute* attr = FindAttribute(type);
+  if (!attr) {
+    return absl::string_view();
+  }
+  return absl::string_view(data_ + attr->offset + kStunAttributeHeaderSize,
+                           attr->length);
+}
+
+StunMessage::IntegrityStatus StunMessageView::ValidateMessageIntegrity(
+    absl::string_view password) const {
+  return ValidateMessageIntegrity(StunMessageIntegrityKey(password));
+}
+
+StunMessage::IntegrityStatus StunMessageView::ValidateMessageIntegrity(
+    const StunMessageIntegrityKey& key) const {
+  if (const Attribute* attr = FindAttribute(STUN_ATTR_MESSAGE_INTEGRITY)) {
+    return ValidateMessageIntegrityOfType(*attr, kStunMessageIntegritySize,
+                                          key)
+               ? StunMessage::IntegrityStatus::kIntegrityOk
+               : StunMessage::IntegrityStatus::kIntegrityBad;
+  }
+  if (const Attribute* attr =
+          FindAttribute(STUN_ATTR_GOOG_MESSAGE_INTEGRITY_32)) {
+    return ValidateMessageIntegrityOfType(*attr, kStunMessageIntegrity32Size,
+                                          key)
+               ? StunMessage::IntegrityStatus::kIntegrityOk
+               : StunMessage::IntegrityStatus::kIntegrityBad;
+  }
+  return StunMessage::IntegrityStatus::kNoIntegrity;
+}
+
+bool StunMessageView::ValidateFingerprint() const {
+  if (attributes_.empty()) {
+    return false;
+  }
+  const Attribute& attr = attributes_.back();
+  if (attr.type != STUN_ATTR_FINGERPRINT ||
+      attr.length != StunUInt32Attribute::SIZE) {
+    return false;
+  }
+  const uint32_t fingerprint =
+      rtc::GetBE32(data_ + attr.offset + kStunAttributeHeaderSize);
+  return (fingerprint ^ STUN_FINGERPRINT_XOR_VALUE) ==
+         rtc::ComputeCrc32(data_, attr.offset);
+}
+
+const StunMessageView::Attribute* StunMessageView::FindAttribute(
+    int type) const {
+  for (const Attribute& attr : attributes_) {
+    if (attr.type == type) {
+      return &attr;
+    }
+  }
+  return nullptr;
+}
+
+bool StunMessageView::ValidateMessageIntegrityOfType(
+    const Attribute& mi_attr,
+    size_t mi_attr_size,
+    const StunMessageIntegrityKey& key) const {
+  if (mi_attr.length != mi_attr_size) {
+    return false;
+  }
+  return MessageIntegrityMatches(data_, mi_attr.offset, mi_attr_size, key);
+}
+
 // StunAttribute
 
 StunAttribute::StunAttribute(uint16_t type, uint16_t length)
@@ -22,10 +22,12 @@
 #include <string>
 #include <vector>
 
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
 #include "rtc_base/byte_buffer.h"
 #include "rtc_base/ip_address.h"
+#include "rtc_base/message_digest.h"
 #include "rtc_base/socket_address.h"
 
 namespace cricket {
@@ -130,6 +132,33 @@ const size_t kStunMessageIntegritySize = 20;
 // Size of STUN_ATTR_MESSAGE_INTEGRITY_32
 const size_t kStunMessageIntegrity32Size = 4;
 
+// HMAC-SHA1 key for the MESSAGE-INTEGRITY of messages authenticated with a
+// short-term credential password. The keyed digest state is derived once, so
+// ports and connections that sign and check every connectivity check with the
+// same password keep one instead of rekeying per message. Not thread safe.
+class StunMessageIntegrityKey {
+ public:
+  StunMessageIntegrityKey();
+  explicit StunMessageIntegrityKey(absl::string_view password);
+  ~StunMessageIntegrityKey();
+
+  StunMessageIntegrityKey(const StunMessageIntegrityKey&) = delete;
+  StunMessageIntegrityKey& operator=(const StunMessageIntegrityKey&) = delete;
+
+  // Rekeys unless `password` is the current password.
+  void SetPassword(absl::string_view password);
+  const std::string& password() const { return password_; }
+
+  // Computes the HMAC of `header` followed by `body`.
+  void ComputeHmac(absl::string_view header,
+                   absl::string_view body,
+                   char hmac[kStunMessageIntegritySize]) const;
+
+ private:
+  std::string password_;
+  std::unique_ptr<rtc::MessageDigest> hmac_;
+};
+
 class StunAddressAttribute;
 class StunAttribute;
 class StunByteStringAttribute;
@@ -216,6 +245,7 @@ class StunMessage {
   // Validates that a STUN message has a correct MESSAGE-INTEGRITY value.
   // This uses the buffered raw-format message stored by Read().
   IntegrityStatus ValidateMessageIntegrity(const std::string& password);
+  IntegrityStatus ValidateMessageIntegrity(const StunMessageIntegrityKey& key);
 
   // Returns the current integrity status of the message.
   IntegrityStatus integrity() const { return integrity_; }
@@ -234,10 +264,12 @@ class StunMessage {
 
   // Adds a MESSAGE-INTEGRITY attribute that is valid for the current message.
   bool AddMessageIntegrity(absl::string_view password);
+  bool AddMessageIntegrity(const StunMessageIntegrityKey& key);
 
   // Adds a STUN_ATTR_GOOG_MESSAGE_INTEGRITY_32 attribute that is valid for the
   // current message.
   bool AddMessageIntegrity32(absl::string_view password);
+  bool AddMessageIntegrity32(const StunMessageIntegrityKey& key);
 
   // Verify that a buffer has stun magic cookie and one of the specified
   // methods. Note that it does not check for the existance of FINGERPRINT.
@@ -316,12 +348,13 @@ class StunMessage {
   static bool IsValidTransactionId(absl::string_view transaction_id);
   bool AddMessageIntegrityOfType(int mi_attr_type,
                                  size_t mi_attr_size,
-                                 absl::string_view key);
-  static bool ValidateMessageIntegrityOfType(int mi_attr_type,
-                                             size_t mi_attr_size,
-                                             const char* data,
-                                             size_t size,
-                                             const std::string& password);
+                                 const StunMessageIntegrityKey& key);
+  static bool ValidateMessageIntegrityOfType(
+      int mi_attr_type,
+      size_t mi_attr_size,
+      const char* data,
+      size_t size,
+      const StunMessageIntegrityKey& key);
 
   uint16_t type_ = STUN_INVALID_MESSAGE_TYPE;
   uint16_t length_ = 0;
@@ -334,6 +367,70 @@ class StunMessage {
   std::string password_;
 };
 
+// Read-only view of a serialized RFC 5389 STUN message. Parse() checks the
+// header and indexes the attributes in a single pass, without copying or
+// decoding them, so that connectivity checks can be authenticated and rejected
+// before a StunMessage is built. The parsed buffer must outlive the view.
+class StunMessageView {
+ public:
+  StunMessageView() = default;
+
+  // Returns false unless `data` holds exactly one STUN message with the magic
+  // cookie and well-formed, padded attributes. Legacy RFC 3489 messages are
+  // rejected.
+  bool Parse(const char* data, size_t size);
+
+  // The parsed message.
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+
+  int type() const { return type_; }
+  absl::string_view transaction_id() const;
+  uint32_t reduced_transaction_id() const;
+
+  // Returns true if there is an attribute of `type`.
+  bool HasAttribute(int type) const;
+  // Returns true if every attribute is of one of `types`.
+  bool HasOnlyAttributes(rtc::ArrayView<const int> types) const;
+  // Read the value of the first attribute of `type`. Return false if there is
+  // none, or if its length doesn't match the value.
+  bool GetUInt32(int type, uint32_t* value) const;
+  bool GetUInt64(int type, uint64_t* value) const;
+  // Returns the value of the first attribute of `type`, or an empty string if
+  // there is none.
+  absl::string_view GetAttributeValue(int type) const;
+
+  // Checks the MESSAGE-INTEGRITY attribute, or GOOG-MESSAGE-INTEGRITY-32 if
+  // there is no MESSAGE-INTEGRITY, like StunMessage::ValidateMessageIntegrity.
+  StunMessage::IntegrityStatus ValidateMessageIntegrity(
+      absl::string_view password) const;
+  StunMessage::IntegrityStatus ValidateMessageIntegrity(
+      const StunMessageIntegrityKey& key) const;
+
+  // Returns true if the last attribute is a valid FINGERPRINT.
+  bool ValidateFingerprint() const;
+
+ private:
+  struct Attribute {
+    uint16_t type;
+    uint16_t length;
+    // Offset of the attribute header in the message.
+    uint32_t offset;
+  };
+
+  const Attribute* FindAttribute(int type) const;
+  bool ValidateMessageIntegrityOfType(
+      const Attribute& mi_attr,
+      size_t mi_attr_size,
+      const StunMessageIntegrityKey& key) const;
+
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  int type_ = STUN_INVALID_MESSAGE_TYPE;
+  // Binding requests carry about ten attributes.
+  absl::InlinedVector<Attribute, 16> attributes_;
+};
+
 // Base class for all STUN/TURN attributes.
 class StunAttribute {
  public:
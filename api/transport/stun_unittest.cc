@@ -1263,6 +1263,56 @@ TEST_F(StunTest, AddMessageIntegrity) {
       kRfc5769SampleMsgPassword));
 }
 
+// A key reused across messages and rekeyed gives the same results as the
+// password.
+TEST_F(StunTest, AddAndValidateMessageIntegrityWithKey) {
+  StunMessageIntegrityKey key;
+  key.SetPassword("InvalidPassword");
+  key.SetPassword(kRfc5769SampleMsgPassword);
+  EXPECT_EQ(kRfc5769SampleMsgPassword, key.password());
+
+  const struct {
+    const unsigned char* data;
+    size_t size;
+    const unsigned char* hmac;
+  } kMessages[] = {
+      {kRfc5769SampleRequestWithoutMI, sizeof(kRfc5769SampleRequestWithoutMI),
+       kCalculatedHmac1},
+      {kRfc5769SampleResponseWithoutMI,
+       sizeof(kRfc5769SampleResponseWithoutMI), kCalculatedHmac2},
+  };
+  for (const auto& message : kMessages) {
+    IceMessage msg;
+    rtc::ByteBufferReader buf(reinterpret_cast<const char*>(message.data),
+                              message.size);
+    ASSERT_TRUE(msg.Read(&buf));
+    EXPECT_TRUE(msg.AddMessageIntegrity(key));
+    EXPECT_EQ(kRfc5769SampleMsgPassword, msg.password());
+    const StunByteStringAttribute* mi_attr =
+        msg.GetByteString(STUN_ATTR_MESSAGE_INTEGRITY);
+    ASSERT_TRUE(mi_attr);
+    EXPECT_EQ(0, memcmp(mi_attr->bytes(), message.hmac, 20));
+
+    rtc::ByteBufferWriter out;
+    ASSERT_TRUE(msg.Write(&out));
+    IceMessage received;
+    rtc::ByteBufferReader in(out);
+    ASSERT_TRUE(received.Read(&in));
+    EXPECT_EQ(StunMessage::IntegrityStatus::kIntegrityOk,
+              received.ValidateMessageIntegrity(key));
+    StunMessageView view;
+    ASSERT_TRUE(view.Parse(out.Data(), out.Length()));
+    EXPECT_EQ(StunMessage::IntegrityStatus::kIntegrityOk,
+              view.ValidateMessageIntegrity(key));
+
+    StunMessageIntegrityKey other_key("InvalidPassword");
+    EXPECT_EQ(StunMessage::IntegrityStatus::kIntegrityBad,
+              received.ValidateMessageIntegrity(other_key));
+    EXPECT_EQ(StunMessage::IntegrityStatus::kIntegrityBad,
+              view.ValidateMessageIntegrity(other_key));
+  }
+}
+
 // Check our STUN message validation code against the RFC5769 test messages.
 TEST_F(StunTest, ValidateMessageIntegrity32) {
   // Try the messages from RFC 5769.
@@ -1317,6 +1367,111 @@ TEST_F(StunTest, ValidateMessageIntegrity32) {
   }
 }
 
+TEST_F(StunTest, StunMessageView) {
+  const char* data = reinterpret_cast<const char*>(kRfc5769SampleRequest);
+  StunMessageView view;
+  ASSERT_TRUE(view.Parse(data, sizeof(kRfc5769SampleRequest)));
+  EXPECT_EQ(STUN_BINDING_REQUEST, view.type());
+  EXPECT_EQ(absl::string_view(data + kStunTransactionIdOffset,
+                              kStunTransactionIdLength),
+            view.transaction_id());
+  EXPECT_TRUE(view.HasAttribute(STUN_ATTR_USERNAME));
+  EXPECT_EQ("evtj:h6vY", view.GetAttributeValue(STUN_ATTR_USERNAME));
+  EXPECT_FALSE(view.HasAttribute(STUN_ATTR_ERROR_CODE));
+  EXPECT_TRUE(view.GetAttributeValue(STUN_ATTR_ERROR_CODE).empty());
+  EXPECT_EQ(StunMessage::IntegrityStatus::kIntegrityOk,
+            view.ValidateMessageIntegrity(kRfc5769SampleMsgPassword));
+  EXPECT_EQ(StunMessage::IntegrityStatus::kIntegrityBad,
+            view.ValidateMessageIntegrity("InvalidPassword"));
+  EXPECT_TRUE(view.ValidateFingerprint());
+
+  // Munging a single bit anywhere in the message breaks the fingerprint, and
+  // the message integrity unless it is after the M-I attribute.
+  char buf[sizeof(kRfc5769SampleRequest)];
+  memcpy(buf, kRfc5769SampleRequest, sizeof(kRfc5769SampleRequest));
+  for (size_t i = 0; i < sizeof(buf); ++i) {
+    buf[i] ^= 0x01;
+    if (i > 0)
+      buf[i - 1] ^= 0x01;
+    if (!view.Parse(buf, sizeof(buf))) {
+      continue;
+    }
+    EXPECT_FALSE(view.ValidateFingerprint());
+    if (view.HasAttribute(STUN_ATTR_MESSAGE_INTEGRITY)) {
+      EXPECT_EQ(i >= sizeof(buf) - 8,
+                view.ValidateMessageIntegrity(kRfc5769SampleMsgPassword) ==
+                    StunMessage::IntegrityStatus::kIntegrityOk);
+    }
+  }
+}
+
+TEST_F(StunTest, StunMessageViewNumericAttributes) {
+  const char* data = reinterpret_cast<const char*>(kRfc5769SampleRequest);
+  StunMessageView view;
+  ASSERT_TRUE(view.Parse(data, sizeof(kRfc5769SampleRequest)));
+  IceMessage msg;
+  rtc::ByteBufferReader buf(data, sizeof(kRfc5769SampleRequest));
+  ASSERT_TRUE(msg.Read(&buf));
+  EXPECT_EQ(msg.reduced_transaction_id(), view.reduced_transaction_id());
+
+  uint32_t priority = 0;
+  EXPECT_TRUE(view.GetUInt32(STUN_ATTR_PRIORITY, &priority));
+  EXPECT_EQ(0x6e0001ffu, priority);
+  uint64_t tiebreaker = 0;
+  EXPECT_TRUE(view.GetUInt64(STUN_ATTR_ICE_CONTROLLED, &tiebreaker));
+  EXPECT_EQ(0x932ff9b151263b36ull, tiebreaker);
+  // Missing, or of the wrong size.
+  EXPECT_FALSE(view.GetUInt32(STUN_ATTR_NOMINATION, &priority));
+  EXPECT_FALSE(view.GetUInt32(STUN_ATTR_ICE_CONTROLLED, &priority));
+  EXPECT_FALSE(view.GetUInt64(STUN_ATTR_PRIORITY, &tiebreaker));
+
+  const int kAttributes[] = {STUN_ATTR_SOFTWARE, STUN_ATTR_PRIORITY,
+                             STUN_ATTR_ICE_CONTROLLED, STUN_ATTR_USERNAME,
+                             STUN_ATTR_MESSAGE_INTEGRITY,
+                             STUN_ATTR_FINGERPRINT};
+  EXPECT_TRUE(view.HasOnlyAttributes(kAttributes));
+  EXPECT_FALSE(view.HasOnlyAttributes(
+      rtc::ArrayView<const int>(kAttributes).subview(1)));
+}
+
+TEST_F(StunTest, StunMessageViewMessageIntegrity32) {
+  StunMessageView view;
+  ASSERT_TRUE(view.Parse(reinterpret_cast<const char*>(kSampleRequestMI32),
+                         sizeof(kSampleRequestMI32)));
+  EXPECT_EQ(StunMessage::IntegrityStatus::kIntegrityOk,
+            view.ValidateMessageIntegrity(kRfc5769SampleMsgPassword));
+  EXPECT_EQ(StunMessage::IntegrityStatus::kIntegrityBad,
+            view.ValidateMessageIntegrity("InvalidPassword"));
+
+  ASSERT_TRUE(
+      view.Parse(reinterpret_cast<const char*>(kRfc5769SampleRequestWithoutMI),
+                 sizeof(kRfc5769SampleRequestWithoutMI)));
+  EXPECT_EQ(StunMessage::IntegrityStatus::kNoIntegrity,
+            view.ValidateMessageIntegrity(kRfc5769SampleMsgPassword));
+}
+
+TEST_F(StunTest, StunMessageViewRejectsMalformedMessages) {
+  StunMessageView view;
+  const char* data = reinterpret_cast<const char*>(kRfc5769SampleRequest);
+  for (size_t size = 0; size < sizeof(kRfc5769SampleRequest); ++size) {
+    EXPECT_FALSE(view.Parse(data, size));
+  }
+
+  char buf[sizeof(kRfc5769SampleRequest)];
+  memcpy(buf, kRfc5769SampleRequest, sizeof(kRfc5769SampleRequest));
+  // Legacy message without the magic cookie.
+  buf[4] ^= 0x01;
+  EXPECT_FALSE(view.Parse(buf, sizeof(buf)));
+  buf[4] ^= 0x01;
+  // RTP and RTCP packets have the first bit set.
+  buf[0] |= 0x80;
+  EXPECT_FALSE(view.Parse(buf, sizeof(buf)));
+  buf[0] &= 0x7F;
+  // The FINGERPRINT attribute runs past the end of the message.
+  buf[sizeof(buf) - 5] = 0x08;
+  EXPECT_FALSE(view.Parse(buf, sizeof(buf)));
+}
+
 // Validate that we generate correct MESSAGE-INTEGRITY-32 attributes.
 TEST_F(StunTest, AddMessageIntegrity32) {
   IceMessage msg;
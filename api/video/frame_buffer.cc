@@ -111,7 +111,27 @@ bool FrameBuffer::InsertFrame(std::unique_ptr<EncodedFrame> frame) {
                          << " inserted, buffer is now full.";
   }
 
+  for (int64_t reference : GetReferences(insert_res.first)) {
+    if (!decoded_frame_history_.WasDecoded(reference)) {
+      dependent_frames_[reference].push_back(frame_id);
+    }
+  }
+
   PropagateContinuity(insert_res.first);
+
+  // A frame with a different timestamp inserted between two frames of the
+  // same timestamp splits them into separate temporal units.
+  if (insert_res.first != frames_.begin() &&
+      std::next(insert_res.first) != frames_.end()) {
+    FrameIterator prev_it = std::prev(insert_res.first);
+    FrameIterator next_it = std::next(insert_res.first);
+    if (GetTimestamp(prev_it) == GetTimestamp(next_it) &&
+        GetTimestamp(prev_it) != GetTimestamp(insert_res.first)) {
+      UpdateDecodableTemporalUnits(prev_it);
+      UpdateDecodableTemporalUnits(next_it);
+    }
+  }
+  UpdateDecodableTemporalUnits(insert_res.first);
   FindNextAndLastDecodableTemporalUnit();
   return true;
 }
@@ -144,7 +164,17 @@ void FrameBuffer::DropNextDecodableTemporalUnit() {
       frames_.begin(), end_it,
       [](const auto& f) { return f.second.encoded_frame != nullptr; });
 
+  decodable_temporal_units_.erase(
+      decodable_temporal_units_.begin(),
+      decodable_temporal_units_.upper_bound(
+          GetFrameId(next_decodable_temporal_unit_->last_frame)));
   frames_.erase(frames_.begin(), end_it);
+  if (!frames_.empty()) {
+    // Remaining frames sharing the timestamp of the erased temporal unit now
+    // start a temporal unit of their own.
+    UpdateDecodableTemporalUnits(frames_.begin());
+  }
+  UpdateDependentsOfDecodedFrames();
   FindNextAndLastDecodableTemporalUnit();
 }
 
@@ -191,85 +221,133 @@ bool FrameBuffer::IsContinuous(const FrameIterator& it) const {
 }
 
 void FrameBuffer::PropagateContinuity(const FrameIterator& frame_it) {
-  for (auto it = frame_it; it != frames_.end(); ++it) {
-    if (!it->second.continuous) {
-      if (IsContinuous(it)) {
-        it->second.continuous = true;
-        if (last_continuous_frame_id_ < GetFrameId(it)) {
-          last_continuous_frame_id_ = GetFrameId(it);
-        }
-        if (IsLastFrameInTemporalUnit(it)) {
-          num_continuous_temporal_units_++;
-          if (last_continuous_temporal_unit_frame_id_ < GetFrameId(it)) {
-            last_continuous_temporal_unit_frame_id_ = GetFrameId(it);
-          }
-        }
+  if (!IsContinuous(frame_it)) {
+    return;
+  }
+
+  absl::InlinedVector<FrameIterator, 4> continuous_frames = {frame_it};
+  while (!continuous_frames.empty()) {
+    FrameIterator it = continuous_frames.back();
+    continuous_frames.pop_back();
+    if (it->second.continuous) {
+      continue;
+    }
+
+    it->second.continuous = true;
+    if (last_continuous_frame_id_ < GetFrameId(it)) {
+      last_continuous_frame_id_ = GetFrameId(it);
+    }
+    if (IsLastFrameInTemporalUnit(it)) {
+      num_continuous_temporal_units_++;
+      if (last_continuous_temporal_unit_frame_id_ < GetFrameId(it)) {
+        last_continuous_temporal_unit_frame_id_ = GetFrameId(it);
+      }
+    }
+
+    // Only frames referencing this frame can have become continuous.
+    auto dependents_it = dependent_frames_.find(GetFrameId(it));
+    if (dependents_it == dependent_frames_.end()) {
+      continue;
+    }
+    for (int64_t dependent_id : dependents_it->second) {
+      auto dependent_it = frames_.find(dependent_id);
+      if (dependent_it != frames_.end() && !dependent_it->second.continuous &&
+          IsContinuous(dependent_it)) {
+        continuous_frames.push_back(dependent_it);
       }
     }
   }
 }
 
-void FrameBuffer::FindNextAndLastDecodableTemporalUnit() {
-  next_decodable_temporal_unit_.reset();
-  decodable_temporal_units_info_.reset();
-
-  if (!last_continuous_temporal_unit_frame_id_) {
-    return;
+void FrameBuffer::UpdateDecodableTemporalUnits(const FrameIterator& frame_it) {
+  const uint32_t timestamp = GetTimestamp(frame_it);
+  FrameIterator first_frame_it = frame_it;
+  while (first_frame_it != frames_.begin() &&
+         GetTimestamp(std::prev(first_frame_it)) == timestamp) {
+    --first_frame_it;
+  }
+  FrameIterator end_it = std::next(frame_it);
+  while (end_it != frames_.end() && GetTimestamp(end_it) == timestamp) {
+    ++end_it;
   }
 
-  FrameIterator first_frame_it = frames_.begin();
-  FrameIterator last_frame_it = frames_.begin();
+  decodable_temporal_units_.erase(
+      decodable_temporal_units_.lower_bound(GetFrameId(first_frame_it)),
+      end_it == frames_.end()
+          ? decodable_temporal_units_.end()
+          : decodable_temporal_units_.lower_bound(GetFrameId(end_it)));
+
+  // Every frame flagged as the last frame of its temporal unit ends a
+  // temporal unit that starts at `first_frame_it`. Since references only
+  // point backwards, a reference that is neither decoded nor part of the
+  // preceding frames makes this and all following units undecodable.
   absl::InlinedVector<int64_t, 4> frames_in_temporal_unit;
-  uint32_t last_decodable_temporal_unit_timestamp;
-  for (auto frame_it = frames_.begin(); frame_it != frames_.end();) {
-    if (GetFrameId(frame_it) > *last_continuous_temporal_unit_frame_id_) {
-      break;
+  for (auto it = first_frame_it; it != end_it; ++it) {
+    for (int64_t reference : GetReferences(it)) {
+      if (!decoded_frame_history_.WasDecoded(reference) &&
+          !absl::c_linear_search(frames_in_temporal_unit, reference)) {
+        return;
+      }
     }
 
-    if (GetTimestamp(frame_it) != GetTimestamp(first_frame_it)) {
-      frames_in_temporal_unit.clear();
-      first_frame_it = frame_it;
+    frames_in_temporal_unit.push_back(GetFrameId(it));
+    if (IsLastFrameInTemporalUnit(it)) {
+      decodable_temporal_units_.emplace(GetFrameId(it),
+                                        TemporalUnit{first_frame_it, it});
     }
+  }
+}
 
-    frames_in_temporal_unit.push_back(GetFrameId(frame_it));
-
-    last_frame_it = frame_it++;
-
-    if (IsLastFrameInTemporalUnit(last_frame_it)) {
-      bool temporal_unit_decodable = true;
-      for (auto it = first_frame_it; it != frame_it && temporal_unit_decodable;
-           ++it) {
-        for (int64_t reference : GetReferences(it)) {
-          if (!decoded_frame_history_.WasDecoded(reference) &&
-              !absl::c_linear_search(frames_in_temporal_unit, reference)) {
-            // A frame in the temporal unit has a non-decoded reference outside
-            // the temporal unit, so it's not yet ready to be decoded.
-            temporal_unit_decodable = false;
-            break;
-          }
-        }
-      }
-
-      if (temporal_unit_decodable) {
-        if (!next_decodable_temporal_unit_) {
-          next_decodable_temporal_unit_ = {first_frame_it, last_frame_it};
-        }
+void FrameBuffer::UpdateDependentsOfDecodedFrames() {
+  absl::optional<int64_t> last_decoded_frame_id =
+      decoded_frame_history_.GetLastDecodedFrameId();
+  if (!last_decoded_frame_id) {
+    return;
+  }
 
-        last_decodable_temporal_unit_timestamp = GetTimestamp(first_frame_it);
+  // Frames at or before the last decoded frame are either decoded or will be
+  // rejected if they ever arrive, so their entries can be consumed.
+  for (auto it = dependent_frames_.begin();
+       it != dependent_frames_.end() && it->first <= *last_decoded_frame_id;
+       it = dependent_frames_.erase(it)) {
+    if (!decoded_frame_history_.WasDecoded(it->first)) {
+      continue;
+    }
+    for (int64_t dependent_id : it->second) {
+      auto dependent_it = frames_.find(dependent_id);
+      if (dependent_it != frames_.end()) {
+        UpdateDecodableTemporalUnits(dependent_it);
       }
     }
   }
+}
+
+void FrameBuffer::FindNextAndLastDecodableTemporalUnit() {
+  next_decodable_temporal_unit_.reset();
+  decodable_temporal_units_info_.reset();
 
-  if (next_decodable_temporal_unit_) {
-    decodable_temporal_units_info_ = {
-        .next_rtp_timestamp =
-            GetTimestamp(next_decodable_temporal_unit_->first_frame),
-        .last_rtp_timestamp = last_decodable_temporal_unit_timestamp};
+  if (!last_continuous_temporal_unit_frame_id_) {
+    return;
   }
+
+  auto end_it = decodable_temporal_units_.upper_bound(
+      *last_continuous_temporal_unit_frame_id_);
+  if (end_it == decodable_temporal_units_.begin()) {
+    return;
+  }
+
+  next_decodable_temporal_unit_ = decodable_temporal_units_.begin()->second;
+  decodable_temporal_units_info_ = {
+      .next_rtp_timestamp =
+          GetTimestamp(next_decodable_temporal_unit_->first_frame),
+      .last_rtp_timestamp =
+          GetTimestamp(std::prev(end_it)->second.first_frame)};
 }
 
 void FrameBuffer::Clear() {
   frames_.clear();
+  decodable_temporal_units_.clear();
+  dependent_frames_.clear();
   next_decodable_temporal_unit_.reset();
   decodable_temporal_units_info_.reset();
   last_continuous_frame_id_.reset();
@@ -27,6 +27,11 @@ namespace webrtc {
 // into temporal units by timestamp. A temporal unit is decodable after all
 // referenced frames outside the unit has been decoded, and a temporal unit is
 // continuous if all referenced frames are directly or indirectly decodable.
+// Continuity and decodability are tracked incrementally: inserting a frame
+// only re-evaluates the frames that reference it and its own temporal unit,
+// and decoding a temporal unit only re-evaluates the temporal units that
+// reference it, so deep SVC structures don't cause the whole buffer to be
+// walked on every insertion.
 // The FrameBuffer is thread-unsafe.
 class FrameBuffer {
  public:
@@ -85,12 +90,24 @@ class FrameBuffer {
 
   bool IsContinuous(const FrameIterator& it) const;
   void PropagateContinuity(const FrameIterator& frame_it);
+  // Re-evaluates the decodable temporal units among the frames sharing the
+  // timestamp of `frame_it`.
+  void UpdateDecodableTemporalUnits(const FrameIterator& frame_it);
+  // Re-evaluates the temporal units of frames that reference newly decoded
+  // frames.
+  void UpdateDependentsOfDecodedFrames();
   void FindNextAndLastDecodableTemporalUnit();
   void Clear();
 
   const bool legacy_frame_id_jump_behavior_;
   const size_t max_size_;
   FrameMap frames_;
+  // Temporal units whose frames only reference decoded frames or frames within
+  // the same temporal unit, keyed by the frame ID of their last frame.
+  std::map<int64_t, TemporalUnit> decodable_temporal_units_;
+  // IDs of inserted frames that reference a not yet decoded frame, keyed by
+  // the ID of the referenced frame.
+  std::map<int64_t, absl::InlinedVector<int64_t, 4>> dependent_frames_;
   absl::optional<TemporalUnit> next_decodable_temporal_unit_;
   absl::optional<DecodabilityInfo> decodable_temporal_units_info_;
   absl::optional<int64_t> last_continuous_frame_id_;
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/video/encoded_frame.h"
+#include "api/video/frame_buffer.h"
+#include "benchmark/benchmark.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/system/unused.h"
+#include "test/fake_encoded_frame.h"
+#include "test/scoped_key_value_config.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kRtpTicksPerFrame = 3000;
+
+// Synthetic full SVC (LxT3) dependency graph. Temporal units follow the
+// T0 T2 T1 T2 pattern, each spatial layer references the same spatial layer
+// of its temporal reference and the spatial layer below it.
+std::vector<std::unique_ptr<EncodedFrame>> CreateSvcFrames(
+    int num_temporal_units,
+    int num_spatial_layers) {
+  std::vector<std::unique_ptr<EncodedFrame>> frames;
+  for (int tu = 0; tu < num_temporal_units; ++tu) {
+    int reference_tu;
+    switch (tu % 4) {
+      case 0:
+        reference_tu = tu - 4;
+        break;
+      case 2:
+        reference_tu = tu - 2;
+        break;
+      default:
+        reference_tu = tu - 1;
+        break;
+    }
+    for (int sid = 0; sid < num_spatial_layers; ++sid) {
+      const int64_t frame_id = int64_t{tu} * num_spatial_layers + sid;
+      std::vector<int64_t> references;
+      if (reference_tu >= 0) {
+        references.push_back(int64_t{reference_tu} * num_spatial_layers + sid);
+      }
+      if (sid > 0) {
+        references.push_back(frame_id - 1);
+      }
+      test::FakeFrameBuilder builder;
+      builder.Time(tu * kRtpTicksPerFrame)
+          .Id(frame_id)
+          .SpatialLayer(sid)
+          .Refs(references);
+      if (sid == num_spatial_layers - 1) {
+        builder.AsLast();
+      }
+      frames.push_back(builder.Build());
+    }
+  }
+  return frames;
+}
+
+// Fills the buffer while the first temporal unit is missing, so nothing is
+// continuous or decodable, then inserts the missing unit and decodes
+// everything. Models recovering from a loss of the key frame with a deep
+// buffer.
+void BM_FrameBufferRecoverSvc(benchmark::State& state) {
+  const int num_temporal_units = state.range(0);
+  const int num_spatial_layers = state.range(1);
+  test::ScopedKeyValueConfig field_trials;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    state.PauseTiming();
+    std::vector<std::unique_ptr<EncodedFrame>> frames =
+        CreateSvcFrames(num_temporal_units, num_spatial_layers);
+    FrameBuffer buffer(/*max_size=*/frames.size(),
+                       /*max_decode_history=*/frames.size(), field_trials);
+    state.ResumeTiming();
+
+    for (size_t i = num_spatial_layers; i < frames.size(); ++i) {
+      buffer.InsertFrame(std::move(frames[i]));
+    }
+    for (int i = 0; i < num_spatial_layers; ++i) {
+      buffer.InsertFrame(std::move(frames[i]));
+    }
+    int decoded_temporal_units = 0;
+    while (!buffer.ExtractNextDecodableTemporalUnit().empty()) {
+      ++decoded_temporal_units;
+    }
+    RTC_CHECK_EQ(decoded_temporal_units, num_temporal_units);
+  }
+}
+
+// Inserts and decodes frames in order, one temporal unit at a time, with a
+// number of temporal units kept buffered ahead of the decoder.
+void BM_FrameBufferSteadyStateSvc(benchmark::State& state) {
+  const int num_buffered_temporal_units = state.range(0);
+  const int num_spatial_layers = state.range(1);
+  constexpr int kNumTemporalUnits = 1000;
+  test::ScopedKeyValueConfig field_trials;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    state.PauseTiming();
+    std::vector<std::unique_ptr<EncodedFrame>> frames =
+        CreateSvcFrames(kNumTemporalUnits, num_spatial_layers);
+    FrameBuffer buffer(
+        /*max_size=*/(num_buffered_temporal_units + 1) * num_spatial_layers,
+        /*max_decode_history=*/frames.size(), field_trials);
+    state.ResumeTiming();
+
+    for (size_t i = 0; i < frames.size(); ++i) {
+      buffer.InsertFrame(std::move(frames[i]));
+      if (i >= static_cast<size_t>(num_buffered_temporal_units *
+                                   num_spatial_layers)) {
+        benchmark::DoNotOptimize(buffer.ExtractNextDecodableTemporalUnit());
+      }
+    }
+  }
+}
+
+BENCHMARK(BM_FrameBufferRecoverSvc)
+    ->ArgsProduct({{30, 100, 300}, {1, 3}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_FrameBufferSteadyStateSvc)
+    ->ArgsProduct({{5, 50, 200}, {1, 3}})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace webrtc
@@ -261,6 +261,31 @@ TEST(FrameBuffer3Test, ReturnFullTemporalUnitKSVC) {
               ElementsAre(FrameWithId(4)));
 }
 
+TEST(FrameBuffer3Test, ReorderedSpatialLayersBecomeDecodable) {
+  test::ScopedKeyValueConfig field_trials;
+  FrameBuffer buffer(/*max_frame_slots=*/10, /*max_decode_history=*/100,
+                     field_trials);
+  EXPECT_TRUE(buffer.InsertFrame(
+      test::FakeFrameBuilder().Time(20).Id(4).Refs({1, 3}).AsLast().Build()));
+  EXPECT_TRUE(buffer.InsertFrame(
+      test::FakeFrameBuilder().Time(20).Id(3).Refs({1}).Build()));
+  EXPECT_TRUE(buffer.InsertFrame(
+      test::FakeFrameBuilder().Time(10).Id(2).Refs({1}).AsLast().Build()));
+  EXPECT_THAT(buffer.DecodableTemporalUnitsInfo(), Eq(absl::nullopt));
+
+  EXPECT_TRUE(
+      buffer.InsertFrame(test::FakeFrameBuilder().Time(10).Id(1).Build()));
+  EXPECT_THAT(buffer.LastContinuousTemporalUnitFrameId(), Eq(4));
+  EXPECT_THAT(buffer.DecodableTemporalUnitsInfo()->last_rtp_timestamp,
+              Eq(10U));
+  EXPECT_THAT(buffer.ExtractNextDecodableTemporalUnit(),
+              ElementsAre(FrameWithId(1), FrameWithId(2)));
+  EXPECT_THAT(buffer.DecodableTemporalUnitsInfo()->last_rtp_timestamp,
+              Eq(20U));
+  EXPECT_THAT(buffer.ExtractNextDecodableTemporalUnit(),
+              ElementsAre(FrameWithId(3), FrameWithId(4)));
+}
+
 TEST(FrameBuffer3Test, InterleavedStream) {
   test::ScopedKeyValueConfig field_trials;
   FrameBuffer buffer(/*max_frame_slots=*/10, /*max_decode_history=*/100,
@@ -13,12 +13,14 @@
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "api/make_ref_counted.h"
 #include "rtc_base/checks.h"
 #include "third_party/libyuv/include/libyuv/convert.h"
 #include "third_party/libyuv/include/libyuv/planar_functions.h"
 #include "third_party/libyuv/include/libyuv/scale.h"
+#include "third_party/libyuv/include/libyuv/scale_uv.h"
 
 // Aligning pointer to 64 bytes for improved performance, e.g. use SIMD.
 static const int kBufferAlignment = 64;
@@ -31,6 +33,63 @@ int I420DataSize(int height, int stride_y, int stride_u, int stride_v) {
   return stride_y * height + (stride_u + stride_v) * ((height + 1) / 2);
 }
 
+// Scale factor passed to libyuv::Convert16To8Plane to map 10-bit samples to
+// 8 bits.
+constexpr int k10BitTo8BitScale = 16384;
+
+// Cropped region of one source plane, in that plane's own sample units.
+struct PlaneRegion {
+  int offset_x;
+  int offset_y;
+  int width;
+  int height;
+};
+
+// Maps a luma crop region with even offsets to the region covered in a
+// chroma plane subsampled by 2^`shift_x` horizontally and 2^`shift_y`
+// vertically.
+PlaneRegion ChromaRegion(int offset_x,
+                         int offset_y,
+                         int crop_width,
+                         int crop_height,
+                         int shift_x,
+                         int shift_y) {
+  return PlaneRegion{offset_x >> shift_x, offset_y >> shift_y,
+                     (crop_width + (1 << shift_x) - 1) >> shift_x,
+                     (crop_height + (1 << shift_y) - 1) >> shift_y};
+}
+
+void CropAndScalePlane(const uint8_t* src,
+                       int src_stride,
+                       const PlaneRegion& region,
+                       uint8_t* dst,
+                       int dst_stride,
+                       int dst_width,
+                       int dst_height) {
+  libyuv::ScalePlane(src + src_stride * region.offset_y + region.offset_x,
+                     src_stride, region.width, region.height, dst, dst_stride,
+                     dst_width, dst_height, libyuv::kFilterBox);
+}
+
+// Scales at 16 bits into `scratch` and narrows the result, so the narrowing
+// only runs over output-sized planes.
+void CropScaleAndConvertPlane16(const uint16_t* src,
+                                int src_stride,
+                                const PlaneRegion& region,
+                                uint8_t* dst,
+                                int dst_stride,
+                                int dst_width,
+                                int dst_height,
+                                std::vector<uint16_t>& scratch) {
+  scratch.resize(dst_width * dst_height);
+  libyuv::ScalePlane_16(src + src_stride * region.offset_y + region.offset_x,
+                        src_stride, region.width, region.height,
+                        scratch.data(), dst_width, dst_width, dst_height,
+                        libyuv::kFilterBox);
+  libyuv::Convert16To8Plane(scratch.data(), dst_width, dst, dst_stride,
+                            k10BitTo8BitScale, dst_width, dst_height);
+}
+
 }  // namespace
 
 I420Buffer::I420Buffer(int width, int height)
@@ -229,4 +288,105 @@ void I420Buffer::ScaleFrom(const I420BufferInterface& src) {
   CropAndScaleFrom(src, 0, 0, src.width(), src.height());
 }
 
+void I420Buffer::CropScaleAndConvertFrom(const VideoFrameBuffer& src,
+                                         int offset_x,
+                                         int offset_y,
+                                         int crop_width,
+                                         int crop_height) {
+  RTC_CHECK_LE(crop_width, src.width());
+  RTC_CHECK_LE(crop_height, src.height());
+  RTC_CHECK_LE(crop_width + offset_x, src.width());
+  RTC_CHECK_LE(crop_height + offset_y, src.height());
+  RTC_CHECK_GE(offset_x, 0);
+  RTC_CHECK_GE(offset_y, 0);
+
+  // Make sure offset is even so that chroma planes become aligned, matching
+  // CropAndScaleFrom.
+  offset_x = offset_x / 2 * 2;
+  offset_y = offset_y / 2 * 2;
+
+  const PlaneRegion luma_region{offset_x, offset_y, crop_width, crop_height};
+  const int chroma_width = (width() + 1) / 2;
+  const int chroma_height = (height() + 1) / 2;
+
+  switch (src.type()) {
+    case Type::kI420:
+    case Type::kI420A:
+      CropAndScaleFrom(*src.GetI420(), offset_x, offset_y, crop_width,
+                       crop_height);
+      return;
+    case Type::kI422:
+    case Type::kI444: {
+      // Chroma is scaled straight from the source subsampling to 4:2:0.
+      const PlanarYuv8Buffer& planar =
+          src.type() == Type::kI422
+              ? static_cast<const PlanarYuv8Buffer&>(*src.GetI422())
+              : static_cast<const PlanarYuv8Buffer&>(*src.GetI444());
+      const PlaneRegion chroma_region =
+          ChromaRegion(offset_x, offset_y, crop_width, crop_height,
+                       src.type() == Type::kI422 ? 1 : 0, 0);
+      CropAndScalePlane(planar.DataY(), planar.StrideY(), luma_region,
+                        MutableDataY(), StrideY(), width(), height());
+      CropAndScalePlane(planar.DataU(), planar.StrideU(), chroma_region,
+                        MutableDataU(), StrideU(), chroma_width,
+                        chroma_height);
+      CropAndScalePlane(planar.DataV(), planar.StrideV(), chroma_region,
+                        MutableDataV(), StrideV(), chroma_width,
+                        chroma_height);
+      return;
+    }
+    case Type::kNV12: {
+      const NV12BufferInterface& nv12 = *src.GetNV12();
+      const PlaneRegion chroma_region =
+          ChromaRegion(offset_x, offset_y, crop_width, crop_height, 1, 1);
+      CropAndScalePlane(nv12.DataY(), nv12.StrideY(), luma_region,
+                        MutableDataY(), StrideY(), width(), height());
+      const uint8_t* uv_plane = nv12.DataUV() +
+                                nv12.StrideUV() * chroma_region.offset_y +
+                                chroma_region.offset_x * 2;
+      if (chroma_region.width == chroma_width &&
+          chroma_region.height == chroma_height) {
+        libyuv::SplitUVPlane(uv_plane, nv12.StrideUV(), MutableDataU(),
+                             StrideU(), MutableDataV(), StrideV(),
+                             chroma_width, chroma_height);
+        return;
+      }
+      // Scale the interleaved plane at output size, then deinterleave.
+      std::vector<uint8_t> scaled_uv(chroma_width * chroma_height * 2);
+      libyuv::UVScale(uv_plane, nv12.StrideUV(), chroma_region.width,
+                      chroma_region.height, scaled_uv.data(), chroma_width * 2,
+                      chroma_width, chroma_height, libyuv::kFilterBox);
+      libyuv::SplitUVPlane(scaled_uv.data(), chroma_width * 2, MutableDataU(),
+                           StrideU(), MutableDataV(), StrideV(), chroma_width,
+                           chroma_height);
+      return;
+    }
+    case Type::kI010:
+    case Type::kI210: {
+      const PlanarYuv16BBuffer& planar =
+          src.type() == Type::kI010
+              ? static_cast<const PlanarYuv16BBuffer&>(*src.GetI010())
+              : static_cast<const PlanarYuv16BBuffer&>(*src.GetI210());
+      const PlaneRegion chroma_region =
+          ChromaRegion(offset_x, offset_y, crop_width, crop_height, 1,
+                       src.type() == Type::kI010 ? 1 : 0);
+      std::vector<uint16_t> scratch;
+      CropScaleAndConvertPlane16(planar.DataY(), planar.StrideY(), luma_region,
+                                 MutableDataY(), StrideY(), width(), height(),
+                                 scratch);
+      CropScaleAndConvertPlane16(planar.DataU(), planar.StrideU(),
+                                 chroma_region, MutableDataU(), StrideU(),
+                                 chroma_width, chroma_height, scratch);
+      CropScaleAndConvertPlane16(planar.DataV(), planar.StrideV(),
+                                 chroma_region, MutableDataV(), StrideV(),
+                                 chroma_width, chroma_height, scratch);
+      return;
+    }
+    case Type::kNative:
+      break;
+  }
+  // Native buffers must be mapped with ToI420() first.
+  RTC_CHECK_NOTREACHED();
+}
+
 }  // namespace webrtc
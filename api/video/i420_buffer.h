@@ -98,6 +98,15 @@ class RTC_EXPORT I420Buffer : public I420BufferInterface {
   // Scale all of `src` to the size of `this` buffer, with no cropping.
   void ScaleFrom(const I420BufferInterface& src);
 
+  // Like CropAndScaleFrom, but accepts any mapped (non-native) buffer type.
+  // Crop, scale and conversion to I420 are done plane by plane in a single
+  // pass, without first converting the full source frame to I420.
+  void CropScaleAndConvertFrom(const VideoFrameBuffer& src,
+                               int offset_x,
+                               int offset_y,
+                               int crop_width,
+                               int crop_height);
+
  protected:
   I420Buffer(int width, int height);
   I420Buffer(int width, int height, int stride_y, int stride_u, int stride_v);
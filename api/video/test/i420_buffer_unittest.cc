@@ -0,0 +1,202 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/video/i420_buffer.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+
+#include "api/video/i010_buffer.h"
+#include "api/video/i422_buffer.h"
+#include "api/video/i444_buffer.h"
+#include "api/video/nv12_buffer.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kWidth = 64;
+constexpr int kHeight = 48;
+constexpr int kOffsetX = 8;
+constexpr int kOffsetY = 4;
+constexpr int kCropWidth = 48;
+constexpr int kCropHeight = 40;
+constexpr int kScaledWidth = 24;
+constexpr int kScaledHeight = 20;
+
+// Smooth gradients, so that differences in filtering and in the order of
+// conversion and scaling only show up as small rounding errors.
+uint8_t LumaAt(int col, int row) {
+  return row * 2 + col;
+}
+uint8_t ChromaAt(int col, int row, int scale_x, int scale_y) {
+  return 64 + row * scale_y + col * scale_x;
+}
+
+void FillPlane(uint8_t* data,
+               int stride,
+               int width,
+               int height,
+               int scale_x,
+               int scale_y) {
+  for (int row = 0; row < height; ++row) {
+    for (int col = 0; col < width; ++col) {
+      data[row * stride + col] = ChromaAt(col, row, scale_x, scale_y);
+    }
+  }
+}
+
+void FillLuma(uint8_t* data, int stride) {
+  for (int row = 0; row < kHeight; ++row) {
+    for (int col = 0; col < kWidth; ++col) {
+      data[row * stride + col] = LumaAt(col, row);
+    }
+  }
+}
+
+rtc::scoped_refptr<I010Buffer> CreateI010Buffer() {
+  rtc::scoped_refptr<I010Buffer> buffer = I010Buffer::Create(kWidth, kHeight);
+  for (int row = 0; row < kHeight; ++row) {
+    for (int col = 0; col < kWidth; ++col) {
+      buffer->MutableDataY()[row * buffer->StrideY() + col] = LumaAt(col, row)
+                                                              << 2;
+    }
+  }
+  for (int row = 0; row < buffer->ChromaHeight(); ++row) {
+    for (int col = 0; col < buffer->ChromaWidth(); ++col) {
+      buffer->MutableDataU()[row * buffer->StrideU() + col] =
+          ChromaAt(col, row, 2, 1) << 2;
+      buffer->MutableDataV()[row * buffer->StrideV() + col] =
+          ChromaAt(col, row, 1, 2) << 2;
+    }
+  }
+  return buffer;
+}
+
+rtc::scoped_refptr<NV12Buffer> CreateNV12Buffer() {
+  rtc::scoped_refptr<NV12Buffer> buffer = NV12Buffer::Create(kWidth, kHeight);
+  FillLuma(buffer->MutableDataY(), buffer->StrideY());
+  for (int row = 0; row < buffer->ChromaHeight(); ++row) {
+    for (int col = 0; col < buffer->ChromaWidth(); ++col) {
+      uint8_t* uv =
+          buffer->MutableDataUV() + row * buffer->StrideUV() + col * 2;
+      uv[0] = ChromaAt(col, row, 2, 1);
+      uv[1] = ChromaAt(col, row, 1, 2);
+    }
+  }
+  return buffer;
+}
+
+int MaxPlaneDiff(const uint8_t* data1,
+                 int stride1,
+                 const uint8_t* data2,
+                 int stride2,
+                 int width,
+                 int height) {
+  int max_diff = 0;
+  for (int row = 0; row < height; ++row) {
+    for (int col = 0; col < width; ++col) {
+      max_diff = std::max(max_diff, abs(data1[row * stride1 + col] -
+                                        data2[row * stride2 + col]));
+    }
+  }
+  return max_diff;
+}
+
+int MaxDiff(const I420BufferInterface& a, const I420BufferInterface& b) {
+  EXPECT_EQ(a.width(), b.width());
+  EXPECT_EQ(a.height(), b.height());
+  return std::max(
+      {MaxPlaneDiff(a.DataY(), a.StrideY(), b.DataY(), b.StrideY(), a.width(),
+                    a.height()),
+       MaxPlaneDiff(a.DataU(), a.StrideU(), b.DataU(), b.StrideU(),
+                    a.ChromaWidth(), a.ChromaHeight()),
+       MaxPlaneDiff(a.DataV(), a.StrideV(), b.DataV(), b.StrideV(),
+                    a.ChromaWidth(), a.ChromaHeight())});
+}
+
+// Crops and scales `src` both through the fused path and by converting the
+// full frame to I420 first, and returns the largest sample difference.
+int CompareWithConvertThenScale(rtc::scoped_refptr<VideoFrameBuffer> src) {
+  rtc::scoped_refptr<I420Buffer> reference =
+      I420Buffer::Create(kScaledWidth, kScaledHeight);
+  reference->CropAndScaleFrom(*src->ToI420(), kOffsetX, kOffsetY, kCropWidth,
+                              kCropHeight);
+  rtc::scoped_refptr<I420Buffer> fused =
+      I420Buffer::Create(kScaledWidth, kScaledHeight);
+  fused->CropScaleAndConvertFrom(*src, kOffsetX, kOffsetY, kCropWidth,
+                                 kCropHeight);
+  return MaxDiff(*reference, *fused);
+}
+
+}  // namespace
+
+TEST(I420BufferTest, CropScaleAndConvertFromI420MatchesCropAndScaleFrom) {
+  rtc::scoped_refptr<I420Buffer> src = I420Buffer::Create(kWidth, kHeight);
+  FillLuma(src->MutableDataY(), src->StrideY());
+  FillPlane(src->MutableDataU(), src->StrideU(), src->ChromaWidth(),
+            src->ChromaHeight(), 2, 1);
+  FillPlane(src->MutableDataV(), src->StrideV(), src->ChromaWidth(),
+            src->ChromaHeight(), 1, 2);
+  EXPECT_EQ(CompareWithConvertThenScale(src), 0);
+}
+
+TEST(I420BufferTest, CropScaleAndConvertFromNV12) {
+  EXPECT_LE(CompareWithConvertThenScale(CreateNV12Buffer()), 1);
+}
+
+TEST(I420BufferTest, CropScaleAndConvertFromI444) {
+  rtc::scoped_refptr<I444Buffer> src = I444Buffer::Create(kWidth, kHeight);
+  FillLuma(src->MutableDataY(), src->StrideY());
+  FillPlane(src->MutableDataU(), src->StrideU(), kWidth, kHeight, 2, 1);
+  FillPlane(src->MutableDataV(), src->StrideV(), kWidth, kHeight, 1, 2);
+  EXPECT_LE(CompareWithConvertThenScale(src), 2);
+}
+
+TEST(I420BufferTest, CropScaleAndConvertFromI422) {
+  rtc::scoped_refptr<I422Buffer> src = I422Buffer::Create(kWidth, kHeight);
+  FillLuma(src->MutableDataY(), src->StrideY());
+  FillPlane(src->MutableDataU(), src->StrideU(), src->ChromaWidth(), kHeight,
+            2, 1);
+  FillPlane(src->MutableDataV(), src->StrideV(), src->ChromaWidth(), kHeight,
+            1, 2);
+  EXPECT_LE(CompareWithConvertThenScale(src), 2);
+}
+
+TEST(I420BufferTest, CropScaleAndConvertFromI010) {
+  EXPECT_LE(CompareWithConvertThenScale(CreateI010Buffer()), 1);
+}
+
+TEST(I420BufferTest, CropAndScaleOfI010BufferReturnsI420) {
+  rtc::scoped_refptr<I010Buffer> src = CreateI010Buffer();
+  rtc::scoped_refptr<VideoFrameBuffer> scaled = src->CropAndScale(
+      kOffsetX, kOffsetY, kCropWidth, kCropHeight, kScaledWidth, kScaledHeight);
+  EXPECT_EQ(scaled->type(), VideoFrameBuffer::Type::kI420);
+  EXPECT_EQ(scaled->width(), kScaledWidth);
+  EXPECT_EQ(scaled->height(), kScaledHeight);
+}
+
+TEST(I420BufferTest, CropAndScaleOfNV12I444AndI422BuffersKeepsFormat) {
+  rtc::scoped_refptr<VideoFrameBuffer> sources[] = {
+      CreateNV12Buffer(), I444Buffer::Create(kWidth, kHeight),
+      I422Buffer::Create(kWidth, kHeight)};
+  for (const auto& src : sources) {
+    rtc::scoped_refptr<VideoFrameBuffer> scaled =
+        src->CropAndScale(kOffsetX, kOffsetY, kCropWidth, kCropHeight,
+                          kScaledWidth, kScaledHeight);
+    EXPECT_EQ(scaled->type(), src->type());
+    EXPECT_EQ(scaled->width(), kScaledWidth);
+    EXPECT_EQ(scaled->height(), kScaledHeight);
+  }
+}
+
+}  // namespace webrtc
@@ -27,8 +27,14 @@ rtc::scoped_refptr<VideoFrameBuffer> VideoFrameBuffer::CropAndScale(
     int scaled_height) {
   rtc::scoped_refptr<I420Buffer> result =
       I420Buffer::Create(scaled_width, scaled_height);
-  result->CropAndScaleFrom(*this->ToI420(), offset_x, offset_y, crop_width,
-                           crop_height);
+  if (type() == Type::kNative) {
+    result->CropAndScaleFrom(*this->ToI420(), offset_x, offset_y, crop_width,
+                             crop_height);
+  } else {
+    // Avoids converting the full-resolution source to I420 before scaling.
+    result->CropScaleAndConvertFrom(*this, offset_x, offset_y, crop_width,
+                                    crop_height);
+  }
   return result;
 }
 
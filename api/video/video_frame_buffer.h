@@ -87,9 +87,10 @@ class RTC_EXPORT VideoFrameBuffer : public rtc::RefCountInterface {
   // behave as the other GetXXX methods below.
   virtual const I420BufferInterface* GetI420() const;
 
-  // A format specific scale function. Default implementation works by
-  // converting to I420. But more efficient implementations may override it,
-  // especially for kNative.
+  // A format specific scale function. Default implementation returns I420,
+  // cropping, scaling and converting mapped buffers in one pass. Formats that
+  // keep their own format, and more efficient implementations, may override
+  // it, especially for kNative.
   // First, the image is cropped to `crop_width` and `crop_height` and then
   // scaled to `scaled_width` and `scaled_height`.
   virtual rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(int offset_x,
@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "absl/types/optional.h"
+#include "api/units/data_size.h"
 #include "api/video/video_adaptation_counters.h"
 #include "api/video/video_adaptation_reason.h"
 #include "api/video/video_bitrate_allocation.h"
@@ -75,6 +76,14 @@ class VideoStreamEncoderObserver : public CpuOveruseMetricsObserver {
 
   virtual void OnFrameDropped(DropReason reason) = 0;
 
+  // Reports the pre-encode complexity estimate of a frame that is about to be
+  // encoded or dropped. `temporal_complexity` is the mean squared luma
+  // difference to the previous frame on a downscaled thumbnail, and
+  // `predicted_size` the encoded size expected from it, once calibrated.
+  virtual void OnFrameComplexityEstimated(
+      double temporal_complexity,
+      absl::optional<DataSize> predicted_size) {}
+
   // Used to indicate change in content type, which may require a change in
   // how stats are collected and set the configured preferred media bitrate.
   virtual void OnEncoderReconfigured(
@@ -80,6 +80,7 @@ std::unique_ptr<voe::ChannelReceiveInterface> CreateChannelReceive(
       config.rtcp_send_transport, event_log, config.rtp.local_ssrc,
       config.rtp.remote_ssrc, config.jitter_buffer_max_packets,
       config.jitter_buffer_fast_accelerate, config.jitter_buffer_min_delay_ms,
+      config.jitter_buffer_release_idle_decoders_after_ms,
       config.enable_non_sender_rtt, config.decoder_factory,
       config.codec_pair_id, std::move(config.frame_decryptor),
       config.crypto_options, std::move(config.frame_transformer));
@@ -426,6 +427,14 @@ int AudioReceiveStreamImpl::PreferredSampleRate() const {
   return channel_receive_->PreferredSampleRate();
 }
 
+absl::optional<int> AudioReceiveStreamImpl::AudioLevelHint() const {
+  return channel_receive_->GetLastReceivedAudioLevel();
+}
+
+void AudioReceiveStreamImpl::DiscardBufferedAudio() {
+  channel_receive_->DiscardBufferedAudio();
+}
+
 uint32_t AudioReceiveStreamImpl::id() const {
   RTC_DCHECK_RUN_ON(&worker_thread_checker_);
   return remote_ssrc();
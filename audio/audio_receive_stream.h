@@ -113,6 +113,8 @@ class AudioReceiveStreamImpl final : public webrtc::AudioReceiveStreamInterface,
                                        AudioFrame* audio_frame) override;
   int Ssrc() const override;
   int PreferredSampleRate() const override;
+  absl::optional<int> AudioLevelHint() const override;
+  void DiscardBufferedAudio() override;
 
   // Syncable
   uint32_t id() const override;
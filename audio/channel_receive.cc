@@ -56,6 +56,13 @@ namespace {
 
 constexpr double kAudioSampleDurationSeconds = 0.01;
 
+// A received audio level is reported for this long, a few packet intervals at
+// the common 20-60 ms packet durations. After that the sender is assumed to
+// have stopped (e.g. DTX) and silence is reported instead.
+constexpr int64_t kAudioLevelMaxAgeMs = 200;
+// Lowest audio level in -dBov, RFC 6464.
+constexpr int kAudioLevelSilence = 127;
+
 // Video Sync.
 constexpr int kVoiceEngineMinMinPlayoutDelayMs = 0;
 constexpr int kVoiceEngineMaxMinPlayoutDelayMs = 10000;
@@ -65,7 +72,8 @@ AudioCodingModule::Config AcmConfig(
     rtc::scoped_refptr<AudioDecoderFactory> decoder_factory,
     absl::optional<AudioCodecPairId> codec_pair_id,
     size_t jitter_buffer_max_packets,
-    bool jitter_buffer_fast_playout) {
+    bool jitter_buffer_fast_playout,
+    absl::optional<int> jitter_buffer_release_idle_decoders_after_ms) {
   AudioCodingModule::Config acm_config;
   acm_config.neteq_factory = neteq_factory;
   acm_config.decoder_factory = decoder_factory;
@@ -73,6 +81,8 @@ AudioCodingModule::Config AcmConfig(
   acm_config.neteq_config.max_packets_in_buffer = jitter_buffer_max_packets;
   acm_config.neteq_config.enable_fast_accelerate = jitter_buffer_fast_playout;
   acm_config.neteq_config.enable_muted_state = true;
+  acm_config.neteq_config.release_idle_decoders_after_ms =
+      jitter_buffer_release_idle_decoders_after_ms;
 
   return acm_config;
 }
@@ -92,6 +102,7 @@ class ChannelReceive : public ChannelReceiveInterface,
       size_t jitter_buffer_max_packets,
       bool jitter_buffer_fast_playout,
       int jitter_buffer_min_delay_ms,
+      absl::optional<int> jitter_buffer_release_idle_decoders_after_ms,
       bool enable_non_sender_rtt,
       rtc::scoped_refptr<AudioDecoderFactory> decoder_factory,
       absl::optional<AudioCodecPairId> codec_pair_id,
@@ -162,6 +173,10 @@ class ChannelReceive : public ChannelReceiveInterface,
 
   int PreferredSampleRate() const override;
 
+  absl::optional<int> GetLastReceivedAudioLevel() const override;
+
+  void DiscardBufferedAudio() override;
+
   void SetSourceTracker(SourceTracker* source_tracker) override;
 
   // Associate to a send channel.
@@ -240,6 +255,12 @@ class ChannelReceive : public ChannelReceiveInterface,
       RTC_GUARDED_BY(&worker_thread_checker_);
   absl::optional<int64_t> last_received_rtp_system_time_ms_
       RTC_GUARDED_BY(&worker_thread_checker_);
+  // Written on the worker thread, read on the audio thread.
+  mutable Mutex audio_level_lock_;
+  absl::optional<int> last_received_audio_level_
+      RTC_GUARDED_BY(audio_level_lock_);
+  int64_t last_received_audio_level_time_ms_
+      RTC_GUARDED_BY(audio_level_lock_) = 0;
 
   // The AcmReceiver is thread safe, using its own lock.
   acm2::AcmReceiver acm_receiver_;
@@ -505,6 +526,21 @@ int ChannelReceive::PreferredSampleRate() const {
                   acm_receiver_.last_output_sample_rate_hz());
 }
 
+absl::optional<int> ChannelReceive::GetLastReceivedAudioLevel() const {
+  const int64_t now_ms = clock_->TimeInMilliseconds();
+  MutexLock lock(&audio_level_lock_);
+  if (last_received_audio_level_ &&
+      now_ms - last_received_audio_level_time_ms_ > kAudioLevelMaxAgeMs) {
+    return kAudioLevelSilence;
+  }
+  return last_received_audio_level_;
+}
+
+void ChannelReceive::DiscardBufferedAudio() {
+  RTC_DCHECK_RUNS_SERIALIZED(&audio_thread_race_checker_);
+  acm_receiver_.FlushBuffers();
+}
+
 void ChannelReceive::SetSourceTracker(SourceTracker* source_tracker) {
   source_tracker_ = source_tracker;
 }
@@ -520,6 +556,7 @@ ChannelReceive::ChannelReceive(
     size_t jitter_buffer_max_packets,
     bool jitter_buffer_fast_playout,
     int jitter_buffer_min_delay_ms,
+    absl::optional<int> jitter_buffer_release_idle_decoders_after_ms,
     bool enable_non_sender_rtt,
     rtc::scoped_refptr<AudioDecoderFactory> decoder_factory,
     absl::optional<AudioCodecPairId> codec_pair_id,
@@ -534,7 +571,8 @@ ChannelReceive::ChannelReceive(
                               decoder_factory,
                               codec_pair_id,
                               jitter_buffer_max_packets,
-                              jitter_buffer_fast_playout)),
+                              jitter_buffer_fast_playout,
+                              jitter_buffer_release_idle_decoders_after_ms)),
       _outputAudioLevel(),
       clock_(clock),
       ntp_estimator_(clock),
@@ -650,6 +688,11 @@ void ChannelReceive::OnRtpPacket(const RtpPacketReceived& packet) {
 
   RTPHeader header;
   packet_copy.GetHeader(&header);
+  if (header.extension.hasAudioLevel) {
+    MutexLock lock(&audio_level_lock_);
+    last_received_audio_level_ = header.extension.audioLevel;
+    last_received_audio_level_time_ms_ = clock_->TimeInMilliseconds();
+  }
 
   // Interpolates absolute capture timestamp RTP header extension.
   header.extension.absolute_capture_time =
@@ -1117,6 +1160,7 @@ std::unique_ptr<ChannelReceiveInterface> CreateChannelReceive(
     size_t jitter_buffer_max_packets,
     bool jitter_buffer_fast_playout,
     int jitter_buffer_min_delay_ms,
+    absl::optional<int> jitter_buffer_release_idle_decoders_after_ms,
     bool enable_non_sender_rtt,
     rtc::scoped_refptr<AudioDecoderFactory> decoder_factory,
     absl::optional<AudioCodecPairId> codec_pair_id,
@@ -1127,7 +1171,8 @@ std::unique_ptr<ChannelReceiveInterface> CreateChannelReceive(
       clock, neteq_factory, audio_device_module, rtcp_send_transport,
       rtc_event_log, local_ssrc, remote_ssrc, jitter_buffer_max_packets,
       jitter_buffer_fast_playout, jitter_buffer_min_delay_ms,
-      enable_non_sender_rtt, decoder_factory, codec_pair_id,
+      jitter_buffer_release_idle_decoders_after_ms, enable_non_sender_rtt,
+      decoder_factory, codec_pair_id,
       std::move(frame_decryptor), crypto_options, std::move(frame_transformer));
 }
 
@@ -149,6 +149,15 @@ class ChannelReceiveInterface : public RtpPacketSinkInterface {
 
   virtual int PreferredSampleRate() const = 0;
 
+  // Audio level in -dBov signaled in the most recently received RTP packet
+  // carrying the audio level header extension. Silence is reported once no
+  // such packet has arrived for a few packet intervals.
+  virtual absl::optional<int> GetLastReceivedAudioLevel() const = 0;
+
+  // Flushes the jitter buffer, e.g. when the mixer resumes pulling audio
+  // after skipping the channel.
+  virtual void DiscardBufferedAudio() = 0;
+
   // Sets the source tracker to notify about "delivered" packets when output is
   // muted.
   virtual void SetSourceTracker(SourceTracker* source_tracker) = 0;
@@ -182,6 +191,7 @@ std::unique_ptr<ChannelReceiveInterface> CreateChannelReceive(
     size_t jitter_buffer_max_packets,
     bool jitter_buffer_fast_playout,
     int jitter_buffer_min_delay_ms,
+    absl::optional<int> jitter_buffer_release_idle_decoders_after_ms,
     bool enable_non_sender_rtt,
     rtc::scoped_refptr<AudioDecoderFactory> decoder_factory,
     absl::optional<AudioCodecPairId> codec_pair_id,
@@ -0,0 +1,115 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio/channel_receive.h"
+
+#include <map>
+#include <memory>
+
+#include "absl/types/optional.h"
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "api/crypto/crypto_options.h"
+#include "api/crypto/frame_decryptor_interface.h"
+#include "api/rtc_event_log/rtc_event_log.h"
+#include "modules/audio_device/include/mock_audio_device.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+#include "test/mock_transport.h"
+
+namespace webrtc {
+namespace voe {
+namespace {
+
+constexpr uint32_t kLocalSsrc = 1111;
+constexpr uint32_t kRemoteSsrc = 2222;
+constexpr int kPayloadType = 0;
+constexpr int kAudioLevelExtensionId = 1;
+
+class ChannelReceiveTest : public ::testing::Test {
+ protected:
+  ChannelReceiveTest()
+      : clock_(123456789),
+        audio_device_module_(test::MockAudioDeviceModule::CreateNice()),
+        channel_(CreateChannelReceive(
+            &clock_,
+            /*neteq_factory=*/nullptr,
+            audio_device_module_.get(),
+            &transport_,
+            &event_log_,
+            kLocalSsrc,
+            kRemoteSsrc,
+            /*jitter_buffer_max_packets=*/50,
+            /*jitter_buffer_fast_playout=*/false,
+            /*jitter_buffer_min_delay_ms=*/0,
+            /*jitter_buffer_release_idle_decoders_after_ms=*/absl::nullopt,
+            /*enable_non_sender_rtt=*/false,
+            CreateBuiltinAudioDecoderFactory(),
+            /*codec_pair_id=*/absl::nullopt,
+            /*frame_decryptor=*/nullptr,
+            CryptoOptions(),
+            /*frame_transformer=*/nullptr)) {
+    channel_->SetReceiveCodecs({{kPayloadType, {"PCMU", 8000, 1}}});
+    extensions_.Register<AudioLevel>(kAudioLevelExtensionId);
+  }
+
+  void ReceivePacket(uint8_t audio_level) {
+    RtpPacketReceived packet(&extensions_);
+    packet.SetPayloadType(kPayloadType);
+    packet.SetSequenceNumber(sequence_number_++);
+    packet.SetTimestamp(rtp_timestamp_);
+    packet.SetSsrc(kRemoteSsrc);
+    packet.SetExtension<AudioLevel>(/*voice_activity=*/true, audio_level);
+    packet.AllocatePayload(160);
+    packet.set_arrival_time(clock_.CurrentTime());
+    rtp_timestamp_ += 160;
+    channel_->OnRtpPacket(packet);
+  }
+
+  SimulatedClock clock_;
+  MockTransport transport_;
+  RtcEventLogNull event_log_;
+  rtc::scoped_refptr<test::MockAudioDeviceModule> audio_device_module_;
+  std::unique_ptr<ChannelReceiveInterface> channel_;
+  RtpHeaderExtensionMap extensions_;
+  uint16_t sequence_number_ = 0;
+  uint32_t rtp_timestamp_ = 0;
+};
+
+TEST_F(ChannelReceiveTest, NoAudioLevelBeforeFirstPacket) {
+  EXPECT_FALSE(channel_->GetLastReceivedAudioLevel());
+}
+
+TEST_F(ChannelReceiveTest, ReportsAudioLevelOfLastPacket) {
+  ReceivePacket(/*audio_level=*/40);
+  clock_.AdvanceTimeMilliseconds(20);
+  ReceivePacket(/*audio_level=*/30);
+  EXPECT_EQ(channel_->GetLastReceivedAudioLevel(), 30);
+}
+
+TEST_F(ChannelReceiveTest, ReportsSilenceWhenSourceStopsSending) {
+  for (int i = 0; i < 10; ++i) {
+    ReceivePacket(/*audio_level=*/30);
+    clock_.AdvanceTimeMilliseconds(20);
+  }
+  EXPECT_EQ(channel_->GetLastReceivedAudioLevel(), 30);
+
+  // No packets for a while, e.g. the sender went into DTX.
+  clock_.AdvanceTimeMilliseconds(500);
+  EXPECT_EQ(channel_->GetLastReceivedAudioLevel(), 127);
+
+  ReceivePacket(/*audio_level=*/30);
+  EXPECT_EQ(channel_->GetLastReceivedAudioLevel(), 30);
+}
+
+}  // namespace
+}  // namespace voe
+}  // namespace webrtc
@@ -128,6 +128,8 @@ class AudioReceiveStreamInterface : public MediaReceiveStreamInterface {
     size_t jitter_buffer_max_packets = 200;
     bool jitter_buffer_fast_accelerate = false;
     int jitter_buffer_min_delay_ms = 0;
+    // See NetEq::Config::release_idle_decoders_after_ms.
+    absl::optional<int> jitter_buffer_release_idle_decoders_after_ms;
 
     // Identifier for an A/V synchronization group. Empty string to disable.
     // TODO(pbos): Synchronize streams in a sync group, not just one video
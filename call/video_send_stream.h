@@ -13,6 +13,7 @@
 
 #include <stdint.h>
 
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
@@ -24,6 +25,7 @@
 #include "api/frame_transformer_interface.h"
 #include "api/rtp_parameters.h"
 #include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
 #include "api/video/video_content_type.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_sink_interface.h"
@@ -40,6 +42,7 @@
 namespace webrtc {
 
 class FrameEncryptorInterface;
+struct CodecSpecificInfo;
 
 class VideoSendStream {
  public:
@@ -244,6 +247,26 @@ class VideoSendStream {
       rtc::VideoSourceInterface<webrtc::VideoFrame>* source,
       const DegradationPreference& degradation_preference) = 0;
 
+  // Sends an already encoded frame, bypassing the encoder. Intended for
+  // forwarding frames received on another stream without a decode/re-encode
+  // cycle; the frame is packetized, paced and protected like encoder output.
+  // `codec_specific_info.generic_frame_info` should be set, and key frames
+  // should carry the `template_structure` if the dependency descriptor is
+  // negotiated. `encoded_image.SpatialIndex()` selects the outgoing SSRC. The
+  // resolution of the key frames and the temporal layers of their template
+  // structure configure the stream in place of the encoder, within the
+  // bitrate limits of the VideoEncoderConfig. Must not be combined with a
+  // source set through SetSource(). May be called on any thread.
+  virtual void SendEncodedFrame(
+      const EncodedImage& encoded_image,
+      const CodecSpecificInfo& codec_specific_info) = 0;
+
+  // Sets the callback run when a key frame is needed while frames are sent
+  // through SendEncodedFrame(), i.e. on PLI/FIR from the receiver and when the
+  // stream starts. The producer of the frames is expected to respond with a
+  // key frame. Passing nullptr routes the requests back to the encoder.
+  virtual void SetKeyFrameRequestCallback(std::function<void()> callback) = 0;
+
   // Set which streams to send. Must have at least as many SSRCs as configured
   // in the config. Encoder settings are passed on to the encoder instance along
   // with the VideoStream settings.
@@ -211,6 +211,10 @@ class FakeVideoSendStream final
   void SetSource(
       rtc::VideoSourceInterface<webrtc::VideoFrame>* source,
       const webrtc::DegradationPreference& degradation_preference) override;
+  void SendEncodedFrame(
+      const webrtc::EncodedImage& encoded_image,
+      const webrtc::CodecSpecificInfo& codec_specific_info) override {}
+  void SetKeyFrameRequestCallback(std::function<void()> callback) override {}
   webrtc::VideoSendStream::Stats GetStats() override;
   void ReconfigureVideoEncoder(webrtc::VideoEncoderConfig config) override;
 
@@ -254,6 +254,13 @@ AudioDecoder* DecoderDatabase::GetDecoder(uint8_t rtp_payload_type) const {
   return info ? info->GetDecoder() : nullptr;
 }
 
+void DecoderDatabase::DropDecoders() {
+  for (const auto& kv : decoders_) {
+    kv.second.DropDecoder();
+  }
+  active_cng_decoder_.reset();
+}
+
 bool DecoderDatabase::IsComfortNoise(uint8_t rtp_payload_type) const {
   const DecoderInfo* info = GetDecoderInfo(rtp_payload_type);
   return info && info->IsComfortNoise();
@@ -176,6 +176,12 @@ class DecoderDatabase {
   // object does not exist for that decoder, the object is created.
   AudioDecoder* GetDecoder(uint8_t rtp_payload_type) const;
 
+  // Deletes all AudioDecoder objects and the active comfort noise decoder,
+  // keeping the registered payload types and the active decoder selections.
+  // The decoders are created again on first use. Must not be called while
+  // packets parsed by the decoders are still buffered.
+  void DropDecoders();
+
   // Returns true if `rtp_payload_type` is registered as comfort noise.
   bool IsComfortNoise(uint8_t rtp_payload_type) const;
 
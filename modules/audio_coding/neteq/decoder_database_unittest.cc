@@ -12,6 +12,7 @@
 
 #include <stdlib.h>
 
+#include <memory>
 #include <string>
 
 #include "api/audio_codecs/builtin_audio_decoder_factory.h"
@@ -167,6 +168,35 @@ TEST(DecoderDatabase, CheckPayloadTypes) {
   }
 }
 
+TEST(DecoderDatabase, DropDecoders) {
+  auto factory = rtc::make_ref_counted<MockAudioDecoderFactory>();
+  EXPECT_CALL(*factory, MakeAudioDecoderMock(_, _, _))
+      .Times(2)
+      .WillRepeatedly(
+          Invoke([](const SdpAudioFormat& format,
+                    absl::optional<AudioCodecPairId> codec_pair_id,
+                    std::unique_ptr<AudioDecoder>* dec) {
+            *dec = std::make_unique<MockAudioDecoder>();
+          }));
+  DecoderDatabase db(factory, absl::nullopt);
+  ASSERT_EQ(DecoderDatabase::kOK,
+            db.RegisterPayload(0, SdpAudioFormat("pcmu", 8000, 1)));
+  ASSERT_EQ(DecoderDatabase::kOK,
+            db.RegisterPayload(13, SdpAudioFormat("cn", 8000, 1)));
+  bool changed;
+  ASSERT_EQ(DecoderDatabase::kOK, db.SetActiveDecoder(0, &changed));
+  ASSERT_EQ(DecoderDatabase::kOK, db.SetActiveCngDecoder(13));
+  EXPECT_TRUE(db.GetActiveDecoder());
+  EXPECT_TRUE(db.GetActiveCngDecoder());
+
+  // The payload types and active selections survive, and the decoder is
+  // created again on next use.
+  db.DropDecoders();
+  EXPECT_EQ(2, db.Size());
+  EXPECT_TRUE(db.GetActiveDecoder());
+  EXPECT_TRUE(db.GetActiveCngDecoder());
+}
+
 #if defined(WEBRTC_CODEC_ISAC) || defined(WEBRTC_CODEC_ISACFX)
 #define IF_ISAC(x) x
 #else
@@ -0,0 +1,160 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/neteq_batch_processor.h"
+
+#include <algorithm>
+#include <tuple>
+
+#include "absl/strings/ascii.h"
+#include "absl/types/optional.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+NetEqBatchProcessor::NetEqBatchProcessor(TaskQueueFactory* task_queue_factory,
+                                         int num_workers,
+                                         Clock* clock)
+    : clock_(clock),
+      workers_(task_queue_factory, "NetEqBatchWorker", num_workers) {}
+
+NetEqBatchProcessor::~NetEqBatchProcessor() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+}
+
+void NetEqBatchProcessor::AddStream(NetEq* neteq, int payload_type) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  RTC_DCHECK(neteq);
+  auto stream = std::make_unique<Stream>();
+  stream->neteq = neteq;
+  stream->codec_id = GetCodecId(*neteq, payload_type);
+  stream->sample_rate_hz = neteq->last_output_sample_rate_hz();
+  streams_[neteq] = std::move(stream);
+  order_changed_ = true;
+}
+
+void NetEqBatchProcessor::RemoveStream(NetEq* neteq) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  if (streams_.erase(neteq) > 0) {
+    order_changed_ = true;
+  }
+}
+
+void NetEqBatchProcessor::SetPayloadType(NetEq* neteq, int payload_type) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  auto it = streams_.find(neteq);
+  RTC_DCHECK(it != streams_.end());
+  if (it == streams_.end()) {
+    return;
+  }
+  const int codec_id = GetCodecId(*neteq, payload_type);
+  if (it->second->codec_id != codec_id) {
+    it->second->codec_id = codec_id;
+    order_changed_ = true;
+  }
+}
+
+void NetEqBatchProcessor::Process() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  const Timestamp start = clock_->CurrentTime();
+
+  // NetEq switches output rate on its own, e.g. when a stream starts or
+  // changes decoder, so the rates are checked every tick.
+  for (auto& [neteq, stream] : streams_) {
+    const int sample_rate_hz = neteq->last_output_sample_rate_hz();
+    if (stream->sample_rate_hz != sample_rate_hz) {
+      stream->sample_rate_hz = sample_rate_hz;
+      order_changed_ = true;
+    }
+  }
+
+  TickStats stats;
+  stats.reordered = order_changed_;
+  if (order_changed_) {
+    UpdateOrder();
+    order_changed_ = false;
+  }
+  stats.num_streams = static_cast<int>(ordered_streams_.size());
+  stats.num_groups = num_groups_;
+
+  // Workers that get no range keep a zero duration.
+  std::vector<TimeDelta> worker_durations(
+      std::max<size_t>(workers_.num_workers(), 1), TimeDelta::Zero());
+  workers_.ProcessRanges(
+      ordered_streams_.size(), [&](size_t worker, size_t begin, size_t end) {
+        const Timestamp worker_start = clock_->CurrentTime();
+        ProcessStreams(begin, end);
+        worker_durations[worker] = clock_->CurrentTime() - worker_start;
+      });
+  stats.max_worker_duration =
+      *std::max_element(worker_durations.begin(), worker_durations.end());
+  stats.duration = clock_->CurrentTime() - start;
+  last_tick_stats_ = stats;
+}
+
+const NetEqBatchProcessor::Output* NetEqBatchProcessor::GetOutput(
+    const NetEq* neteq) const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  auto it = streams_.find(neteq);
+  return it == streams_.end() ? nullptr : &it->second->output;
+}
+
+NetEqBatchProcessor::TickStats NetEqBatchProcessor::last_tick_stats() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return last_tick_stats_;
+}
+
+int NetEqBatchProcessor::GetCodecId(const NetEq& neteq, int payload_type) {
+  absl::optional<NetEq::DecoderFormat> format =
+      neteq.GetDecoderFormat(payload_type);
+  if (!format) {
+    return kUnknownCodecId;
+  }
+  // Codec names are case insensitive.
+  auto it = codec_ids_
+                .emplace(absl::AsciiStrToLower(format->sdp_format.name),
+                         static_cast<int>(codec_ids_.size()))
+                .first;
+  return it->second;
+}
+
+void NetEqBatchProcessor::UpdateOrder() {
+  ordered_streams_.clear();
+  ordered_streams_.reserve(streams_.size());
+  for (auto& [neteq, stream] : streams_) {
+    ordered_streams_.push_back(stream.get());
+  }
+  std::sort(ordered_streams_.begin(), ordered_streams_.end(),
+            [](const Stream* a, const Stream* b) {
+              return std::tie(a->codec_id, a->sample_rate_hz) <
+                     std::tie(b->codec_id, b->sample_rate_hz);
+            });
+
+  num_groups_ = 0;
+  for (size_t i = 0; i < ordered_streams_.size(); ++i) {
+    if (i == 0 ||
+        ordered_streams_[i]->codec_id != ordered_streams_[i - 1]->codec_id ||
+        ordered_streams_[i]->sample_rate_hz !=
+            ordered_streams_[i - 1]->sample_rate_hz) {
+      ++num_groups_;
+    }
+  }
+}
+
+void NetEqBatchProcessor::ProcessStreams(size_t begin, size_t end) {
+  for (size_t i = begin; i < end; ++i) {
+    Stream* stream = ordered_streams_[i];
+    stream->output.result =
+        stream->neteq->GetAudio(&stream->output.audio_frame,
+                                &stream->output.muted);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,130 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_NETEQ_NETEQ_BATCH_PROCESSOR_H_
+#define MODULES_AUDIO_CODING_NETEQ_NETEQ_BATCH_PROCESSOR_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/audio/audio_frame.h"
+#include "api/neteq/neteq.h"
+#include "api/sequence_checker.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/task_utils/batch_worker_pool.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// Pulls 10 ms of audio from many NetEq instances per tick, spread over a pool
+// of worker task queues, for servers receiving more streams than one audio
+// thread can decode. Streams are ordered by decoder and output sample rate and
+// split into contiguous ranges, so each worker mostly runs the same decoder
+// back to back. The order is only rebuilt when a stream is added or removed or
+// changes decoder or sample rate. The outputs are kept until the next tick and
+// are read with GetOutput(), e.g. by the audio sources polled by the mixer.
+//
+// ChannelReceive does not use the processor yet: its AcmReceiver owns the
+// NetEq and resamples each pulled frame to the mixer rate with state carried
+// from the previous pull, so it first needs a way to post-process a frame
+// pulled elsewhere. The receive path also has no owner of the tick that could
+// call Process() before the mixer polls its sources.
+//
+// All methods must be called on the same sequence. The NetEq instances must
+// not be pulled from elsewhere while added to the processor.
+class NetEqBatchProcessor {
+ public:
+  struct Output {
+    AudioFrame audio_frame;
+    bool muted = false;
+    // Return value of NetEq::GetAudio().
+    int result = NetEq::kFail;
+  };
+
+  struct TickStats {
+    int num_streams = 0;
+    // Number of distinct decoder and sample rate combinations.
+    int num_groups = 0;
+    // Wall time of the whole tick, and of the slowest worker.
+    TimeDelta duration = TimeDelta::Zero();
+    TimeDelta max_worker_duration = TimeDelta::Zero();
+    // Whether the processing order was rebuilt in this tick.
+    bool reordered = false;
+  };
+
+  // With `num_workers` set to zero, all streams are processed on the calling
+  // sequence.
+  NetEqBatchProcessor(TaskQueueFactory* task_queue_factory,
+                      int num_workers,
+                      Clock* clock);
+  ~NetEqBatchProcessor();
+
+  NetEqBatchProcessor(const NetEqBatchProcessor&) = delete;
+  NetEqBatchProcessor& operator=(const NetEqBatchProcessor&) = delete;
+
+  // `payload_type` is the payload type currently received on the stream, and
+  // is used to look up its decoder with NetEq::GetDecoderFormat().
+  void AddStream(NetEq* neteq, int payload_type);
+  void RemoveStream(NetEq* neteq);
+  // Must be called when the stream switches to another payload type, or when
+  // its payload type is registered to another decoder.
+  void SetPayloadType(NetEq* neteq, int payload_type);
+
+  // Runs NetEq::GetAudio() once on every stream and returns when all of them
+  // are done.
+  void Process();
+
+  // Returns the output of `neteq` from the last Process() call, or null if the
+  // stream isn't added.
+  const Output* GetOutput(const NetEq* neteq) const;
+
+  TickStats last_tick_stats() const;
+
+ private:
+  struct Stream {
+    NetEq* neteq;
+    int codec_id = kUnknownCodecId;
+    int sample_rate_hz = 0;
+    Output output;
+  };
+
+  static constexpr int kUnknownCodecId = -1;
+
+  // Returns a small integer identifying the decoder of `payload_type`, or
+  // kUnknownCodecId if it isn't registered.
+  int GetCodecId(const NetEq& neteq, int payload_type)
+      RTC_RUN_ON(sequence_checker_);
+  void UpdateOrder() RTC_RUN_ON(sequence_checker_);
+  void ProcessStreams(size_t begin, size_t end);
+
+  RTC_NO_UNIQUE_ADDRESS SequenceChecker sequence_checker_;
+  Clock* const clock_;
+  std::map<const NetEq*, std::unique_ptr<Stream>> streams_
+      RTC_GUARDED_BY(sequence_checker_);
+  // Codec ids by lowercase decoder name.
+  std::map<std::string, int> codec_ids_ RTC_GUARDED_BY(sequence_checker_);
+  // Streams in processing order. Only read by the workers while Process()
+  // waits for them.
+  std::vector<Stream*> ordered_streams_;
+  bool order_changed_ RTC_GUARDED_BY(sequence_checker_) = false;
+  int num_groups_ RTC_GUARDED_BY(sequence_checker_) = 0;
+  TickStats last_tick_stats_ RTC_GUARDED_BY(sequence_checker_);
+  BatchWorkerPool workers_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_NETEQ_NETEQ_BATCH_PROCESSOR_H_
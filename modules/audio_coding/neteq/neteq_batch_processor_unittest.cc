@@ -0,0 +1,141 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/neteq_batch_processor.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/audio_codecs/audio_format.h"
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "api/neteq/neteq.h"
+#include "api/task_queue/default_task_queue_factory.h"
+#include "modules/audio_coding/neteq/default_neteq_factory.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kPayloadTypeG722 = 9;
+constexpr int kPayloadTypeOpus = 111;
+constexpr int kPayloadTypeOpusUpperCase = 112;
+
+class NetEqBatchProcessorTest : public ::testing::TestWithParam<int> {
+ protected:
+  NetEqBatchProcessorTest()
+      : task_queue_factory_(CreateDefaultTaskQueueFactory()),
+        decoder_factory_(CreateBuiltinAudioDecoderFactory()) {}
+
+  std::unique_ptr<NetEq> CreateNetEq(int sample_rate_hz) {
+    NetEq::Config config;
+    config.sample_rate_hz = sample_rate_hz;
+    std::unique_ptr<NetEq> neteq = DefaultNetEqFactory().CreateNetEq(
+        config, decoder_factory_, Clock::GetRealTimeClock());
+    neteq->RegisterPayloadType(kPayloadTypeG722,
+                               SdpAudioFormat("G722", 8000, 1));
+    neteq->RegisterPayloadType(kPayloadTypeOpus,
+                               SdpAudioFormat("opus", 48000, 2));
+    neteq->RegisterPayloadType(kPayloadTypeOpusUpperCase,
+                               SdpAudioFormat("OPUS", 48000, 2));
+    return neteq;
+  }
+
+  std::unique_ptr<TaskQueueFactory> task_queue_factory_;
+  rtc::scoped_refptr<AudioDecoderFactory> decoder_factory_;
+};
+
+TEST_P(NetEqBatchProcessorTest, PullsAudioFromAllStreams) {
+  NetEqBatchProcessor processor(task_queue_factory_.get(),
+                                /*num_workers=*/GetParam(),
+                                Clock::GetRealTimeClock());
+  std::vector<std::unique_ptr<NetEq>> neteqs;
+  neteqs.push_back(CreateNetEq(16000));
+  neteqs.push_back(CreateNetEq(48000));
+  neteqs.push_back(CreateNetEq(48000));
+  neteqs.push_back(CreateNetEq(16000));
+  processor.AddStream(neteqs[0].get(), kPayloadTypeG722);
+  processor.AddStream(neteqs[1].get(), kPayloadTypeOpus);
+  processor.AddStream(neteqs[2].get(), kPayloadTypeOpusUpperCase);
+  processor.AddStream(neteqs[3].get(), kPayloadTypeOpus);
+
+  for (int tick = 0; tick < 3; ++tick) {
+    processor.Process();
+    for (const auto& neteq : neteqs) {
+      const NetEqBatchProcessor::Output* output =
+          processor.GetOutput(neteq.get());
+      ASSERT_TRUE(output);
+      EXPECT_EQ(output->result, NetEq::kOK);
+      EXPECT_EQ(output->audio_frame.sample_rate_hz_,
+                neteq->last_output_sample_rate_hz());
+      EXPECT_EQ(output->audio_frame.samples_per_channel_,
+                static_cast<size_t>(neteq->last_output_sample_rate_hz() / 100));
+    }
+  }
+
+  const NetEqBatchProcessor::TickStats stats = processor.last_tick_stats();
+  EXPECT_EQ(stats.num_streams, 4);
+  // g722 at 16 kHz, opus at 16 kHz and opus at 48 kHz.
+  EXPECT_EQ(stats.num_groups, 3);
+  EXPECT_GE(stats.duration, stats.max_worker_duration);
+}
+
+TEST_P(NetEqBatchProcessorTest, RemovedStreamHasNoOutput) {
+  NetEqBatchProcessor processor(task_queue_factory_.get(),
+                                /*num_workers=*/GetParam(),
+                                Clock::GetRealTimeClock());
+  std::unique_ptr<NetEq> neteq = CreateNetEq(16000);
+  processor.AddStream(neteq.get(), kPayloadTypeOpus);
+  processor.Process();
+  EXPECT_TRUE(processor.GetOutput(neteq.get()));
+
+  processor.RemoveStream(neteq.get());
+  EXPECT_FALSE(processor.GetOutput(neteq.get()));
+  processor.Process();
+  EXPECT_EQ(processor.last_tick_stats().num_streams, 0);
+}
+
+TEST_P(NetEqBatchProcessorTest, ReordersOnlyWhenStreamsChange) {
+  NetEqBatchProcessor processor(task_queue_factory_.get(),
+                                /*num_workers=*/GetParam(),
+                                Clock::GetRealTimeClock());
+  std::unique_ptr<NetEq> g722 = CreateNetEq(16000);
+  std::unique_ptr<NetEq> opus = CreateNetEq(16000);
+  processor.AddStream(g722.get(), kPayloadTypeG722);
+  processor.AddStream(opus.get(), kPayloadTypeOpus);
+  processor.Process();
+  EXPECT_TRUE(processor.last_tick_stats().reordered);
+  EXPECT_EQ(processor.last_tick_stats().num_groups, 2);
+
+  processor.Process();
+  EXPECT_FALSE(processor.last_tick_stats().reordered);
+
+  // Same decoder under another payload type.
+  processor.SetPayloadType(opus.get(), kPayloadTypeOpusUpperCase);
+  processor.Process();
+  EXPECT_FALSE(processor.last_tick_stats().reordered);
+
+  processor.SetPayloadType(opus.get(), kPayloadTypeG722);
+  processor.Process();
+  EXPECT_TRUE(processor.last_tick_stats().reordered);
+  EXPECT_EQ(processor.last_tick_stats().num_groups, 1);
+
+  processor.RemoveStream(g722.get());
+  processor.Process();
+  EXPECT_TRUE(processor.last_tick_stats().reordered);
+  EXPECT_EQ(processor.last_tick_stats().num_streams, 1);
+}
+
+INSTANTIATE_TEST_SUITE_P(NumWorkers,
+                         NetEqBatchProcessorTest,
+                         ::testing::Values(0, 1, 3));
+
+}  // namespace
+}  // namespace webrtc
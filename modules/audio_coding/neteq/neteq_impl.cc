@@ -129,6 +129,7 @@ NetEqImpl::NetEqImpl(const NetEq::Config& config,
       enable_fast_accelerate_(config.enable_fast_accelerate),
       nack_enabled_(false),
       enable_muted_state_(config.enable_muted_state),
+      release_idle_decoders_after_ms_(config.release_idle_decoders_after_ms),
       expand_uma_logger_("WebRTC.Audio.ExpandRatePercent",
                          10,  // Report once every 10 s.
                          tick_timer_.get()),
@@ -807,8 +808,11 @@ int NetEqImpl::GetAudioInternal(AudioFrame* audio_frame,
     stats_->ExpandedNoiseSamples(output_size_samples_, false);
     controller_->NotifyMutedState();
     *muted = true;
+    MaybeReleaseIdleDecoders();
     return 0;
   }
+  muted_stopwatch_.reset();
+  idle_decoders_released_ = false;
   int return_value = GetDecision(&operation, &packet_list, &dtmf_event,
                                  &play_dtmf, action_override);
   if (return_value != 0) {
@@ -1020,6 +1024,24 @@ int NetEqImpl::GetAudioInternal(AudioFrame* audio_frame,
   return return_value;
 }
 
+void NetEqImpl::MaybeReleaseIdleDecoders() {
+  if (!release_idle_decoders_after_ms_ || idle_decoders_released_) {
+    return;
+  }
+  if (!muted_stopwatch_) {
+    muted_stopwatch_ = tick_timer_->GetNewStopwatch();
+  }
+  if (muted_stopwatch_->ElapsedMs() <
+      static_cast<uint64_t>(*release_idle_decoders_after_ms_)) {
+    return;
+  }
+  // The packet buffer is empty in muted state, so no parsed frame refers to a
+  // decoder. The decoders are created again when the next packet arrives.
+  RTC_DCHECK(packet_buffer_->Empty());
+  decoder_database_->DropDecoders();
+  idle_decoders_released_ = true;
+}
+
 int NetEqImpl::GetDecision(Operation* operation,
                            PacketList* packet_list,
                            DtmfEvent* dtmf_event,
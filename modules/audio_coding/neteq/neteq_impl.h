@@ -222,6 +222,10 @@ class NetEqImpl : public webrtc::NetEq {
                        absl::optional<Operation> action_override)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  // Releases the decoders once the stream has been in muted state for longer
+  // than `release_idle_decoders_after_ms_`. Called for each muted frame.
+  void MaybeReleaseIdleDecoders() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   // Provides a decision to the GetAudioInternal method. The decision what to
   // do is written to `operation`. Packets to decode are written to
   // `packet_list`, and a DTMF event to play is written to `dtmf_event`. When
@@ -389,6 +393,12 @@ class NetEqImpl : public webrtc::NetEq {
   std::unique_ptr<NackTracker> nack_ RTC_GUARDED_BY(mutex_);
   bool nack_enabled_ RTC_GUARDED_BY(mutex_);
   const bool enable_muted_state_ RTC_GUARDED_BY(mutex_);
+  const absl::optional<int> release_idle_decoders_after_ms_
+      RTC_GUARDED_BY(mutex_);
+  // Measures the time spent in muted state, while decoders are still held.
+  std::unique_ptr<TickTimer::Stopwatch> muted_stopwatch_
+      RTC_GUARDED_BY(mutex_);
+  bool idle_decoders_released_ RTC_GUARDED_BY(mutex_) = false;
   AudioFrame::VADActivity last_vad_activity_ RTC_GUARDED_BY(mutex_) =
       AudioFrame::kVadPassive;
   std::unique_ptr<TickTimer::Stopwatch> generated_noise_stopwatch_
@@ -661,6 +661,30 @@ TEST_F(NetEqDecodingTestWithMutedState, MutedState) {
   EXPECT_GT(stats.expand_rate, stats.speech_expand_rate);
 }
 
+class NetEqDecodingTestWithIdleDecoderRelease
+    : public NetEqDecodingTestWithMutedState {
+ public:
+  NetEqDecodingTestWithIdleDecoderRelease() {
+    config_.release_idle_decoders_after_ms = 100;
+  }
+};
+
+// Verifies that decoding resumes when packets arrive after the decoders were
+// released during a long muted period.
+TEST_F(NetEqDecodingTestWithIdleDecoderRelease, ResumeAfterRelease) {
+  InsertPacket(0);
+  EXPECT_FALSE(GetAudioReturnMuted());
+  GetAudioUntilMuted();
+  // Stay muted for longer than the release delay.
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_TRUE(GetAudioReturnMuted());
+    ++counter_;
+  }
+  InsertPacket(kSamples * counter_);
+  GetAudioUntilNormal();
+  EXPECT_FALSE(out_frame_.muted());
+}
+
 // Verifies that NetEq goes out of muted state when given a delayed packet.
 TEST_F(NetEqDecodingTestWithMutedState, MutedStateDelayedPacket) {
   // Insert one speech packet.
@@ -8,14 +8,13 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
-// This is the implementation of the PacketBuffer class. It is mostly based on
-// an STL list. The list is kept sorted at all times so that the next packet to
-// decode is at the beginning of the list.
+// This is the implementation of the PacketBuffer class. It is based on a ring
+// of packets that is kept sorted at all times, so that the next packet to
+// decode is at the front of the ring.
 
 #include "modules/audio_coding/neteq/packet_buffer.h"
 
 #include <algorithm>
-#include <list>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -32,17 +31,10 @@
 
 namespace webrtc {
 namespace {
-// Predicate used when inserting packets in the buffer list.
-// Operator() returns true when `packet` goes before `new_packet`.
-class NewTimestampIsLarger {
- public:
-  explicit NewTimestampIsLarger(const Packet& new_packet)
-      : new_packet_(new_packet) {}
-  bool operator()(const Packet& packet) { return (new_packet_ >= packet); }
-
- private:
-  const Packet& new_packet_;
-};
+
+// Number of slots allocated on the first insertion. Enough for the packets
+// of a typical jitter buffer level.
+constexpr size_t kPacketRingInitialCapacity = 8;
 
 // Returns true if both payload types are known to the decoder database, and
 // have the same sample rate.
@@ -86,10 +78,68 @@ absl::optional<SmartFlushingConfig> GetSmartflushingConfig() {
 
 }  // namespace
 
+PacketBuffer::PacketRing::PacketRing(size_t max_capacity)
+    : max_capacity_(std::max<size_t>(max_capacity, 1)) {}
+
+void PacketBuffer::PacketRing::pop_front() {
+  RTC_DCHECK(!empty());
+  // Release the payload and frame right away rather than when the slot is
+  // reused.
+  slots_[head_] = Packet();
+  head_ = (head_ + 1) % slots_.size();
+  --size_;
+}
+
+void PacketBuffer::PacketRing::insert(size_t index, Packet&& packet) {
+  RTC_DCHECK_LE(index, size_);
+  if (size_ == slots_.size()) {
+    Grow();
+  }
+  ++size_;
+  // Packets mostly arrive in order, in which case nothing is moved.
+  for (size_t i = size_ - 1; i > index; --i) {
+    (*this)[i] = std::move((*this)[i - 1]);
+  }
+  (*this)[index] = std::move(packet);
+}
+
+void PacketBuffer::PacketRing::erase(size_t index) {
+  RTC_DCHECK_LT(index, size_);
+  for (size_t i = index; i + 1 < size_; ++i) {
+    (*this)[i] = std::move((*this)[i + 1]);
+  }
+  (*this)[size_ - 1] = Packet();
+  --size_;
+}
+
+void PacketBuffer::PacketRing::clear() {
+  while (!empty()) {
+    pop_front();
+  }
+  head_ = 0;
+}
+
+void PacketBuffer::PacketRing::Grow() {
+  // Double the capacity, without exceeding `max_capacity_` unless it is
+  // already reached. InsertPacket() flushes the buffer before that happens.
+  size_t capacity = std::min(
+      std::max(kPacketRingInitialCapacity, slots_.size() * 2), max_capacity_);
+  if (capacity <= slots_.size()) {
+    capacity = slots_.size() * 2;
+  }
+  std::vector<Packet> slots(capacity);
+  for (size_t i = 0; i < size_; ++i) {
+    slots[i] = std::move((*this)[i]);
+  }
+  slots_ = std::move(slots);
+  head_ = 0;
+}
+
 PacketBuffer::PacketBuffer(size_t max_number_of_packets,
                            const TickTimer* tick_timer)
     : smart_flushing_config_(GetSmartflushingConfig()),
       max_number_of_packets_(max_number_of_packets),
+      buffer_(max_number_of_packets),
       tick_timer_(tick_timer) {}
 
 // Destructor. All packets in the buffer will be destroyed.
@@ -99,8 +149,8 @@ PacketBuffer::~PacketBuffer() {
 
 // Flush the buffer. All packets in the buffer will be destroyed.
 void PacketBuffer::Flush(StatisticsCalculator* stats) {
-  for (auto& p : buffer_) {
-    LogPacketDiscarded(p.priority.codec_level, stats);
+  for (size_t i = 0; i < buffer_.size(); ++i) {
+    LogPacketDiscarded(buffer_[i].priority.codec_level, stats);
   }
   buffer_.clear();
   stats->FlushedPacketBuffer();
@@ -177,29 +227,31 @@ int PacketBuffer::InsertPacket(Packet&& packet,
                         << " packets discarded.";
   }
 
-  // Get an iterator pointing to the place in the buffer where the new packet
-  // should be inserted. The list is searched from the back, since the most
-  // likely case is that the new packet should be near the end of the list.
-  PacketList::reverse_iterator rit = std::find_if(
-      buffer_.rbegin(), buffer_.rend(), NewTimestampIsLarger(packet));
+  // Find the position in the buffer where the new packet should be inserted.
+  // The buffer is searched from the back, since the most likely case is that
+  // the new packet should be at the end of the buffer.
+  size_t index = buffer_.size();
+  while (index > 0 && !(packet >= buffer_[index - 1])) {
+    --index;
+  }
 
-  // The new packet is to be inserted to the right of `rit`. If it has the same
-  // timestamp as `rit`, which has a higher priority, do not insert the new
-  // packet to list.
-  if (rit != buffer_.rend() && packet.timestamp == rit->timestamp) {
+  // The new packet is to be inserted to the right of `index - 1`. If it has
+  // the same timestamp as that packet, which has a higher priority, do not
+  // insert the new packet.
+  if (index > 0 && packet.timestamp == buffer_[index - 1].timestamp) {
     LogPacketDiscarded(packet.priority.codec_level, stats);
     return return_val;
   }
 
-  // The new packet is to be inserted to the left of `it`. If it has the same
-  // timestamp as `it`, which has a lower priority, replace `it` with the new
-  // packet.
-  PacketList::iterator it = rit.base();
-  if (it != buffer_.end() && packet.timestamp == it->timestamp) {
-    LogPacketDiscarded(it->priority.codec_level, stats);
-    it = buffer_.erase(it);
+  // The new packet is to be inserted to the left of `index`. If it has the same
+  // timestamp as that packet, which has a lower priority, replace it with the
+  // new packet.
+  if (index < buffer_.size() &&
+      packet.timestamp == buffer_[index].timestamp) {
+    LogPacketDiscarded(buffer_[index].priority.codec_level, stats);
+    buffer_.erase(index);
   }
-  buffer_.insert(it, std::move(packet));  // Insert the packet at that position.
+  buffer_.insert(index, std::move(packet));
 
   return return_val;
 }
@@ -274,11 +326,10 @@ int PacketBuffer::NextHigherTimestamp(uint32_t timestamp,
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  PacketList::const_iterator it;
-  for (it = buffer_.begin(); it != buffer_.end(); ++it) {
-    if (it->timestamp >= timestamp) {
+  for (size_t i = 0; i < buffer_.size(); ++i) {
+    if (buffer_[i].timestamp >= timestamp) {
       // Found a packet matching the search.
-      *next_timestamp = it->timestamp;
+      *next_timestamp = buffer_[i].timestamp;
       return kOK;
     }
   }
@@ -351,7 +402,8 @@ size_t PacketBuffer::NumPacketsInBuffer() const {
 size_t PacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
   size_t num_samples = 0;
   size_t last_duration = last_decoded_length;
-  for (const Packet& packet : buffer_) {
+  for (size_t i = 0; i < buffer_.size(); ++i) {
+    const Packet& packet = buffer_[i];
     if (packet.frame) {
       // TODO(hlundin): Verify that it's fine to count all packets and remove
       // this check.
@@ -393,7 +445,8 @@ size_t PacketBuffer::GetSpanSamples(size_t last_decoded_length,
 bool PacketBuffer::ContainsDtxOrCngPacket(
     const DecoderDatabase* decoder_database) const {
   RTC_DCHECK(decoder_database);
-  for (const Packet& packet : buffer_) {
+  for (size_t i = 0; i < buffer_.size(); ++i) {
+    const Packet& packet = buffer_[i];
     if ((packet.frame && packet.frame->IsDtxPacket()) ||
         decoder_database->IsComfortNoise(packet.payload_type)) {
       return true;
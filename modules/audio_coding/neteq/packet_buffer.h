@@ -11,10 +11,14 @@
 #ifndef MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 #define MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 
+#include <utility>
+#include <vector>
+
 #include "absl/types/optional.h"
 #include "modules/audio_coding/neteq/decoder_database.h"
 #include "modules/audio_coding/neteq/packet.h"
 #include "modules/include/module_common_types_public.h"  // IsNewerTimestamp
+#include "rtc_base/checks.h"
 
 namespace webrtc {
 
@@ -171,9 +175,68 @@ class PacketBuffer {
   }
 
  private:
+  // Ring of packets sorted on timestamp, the next packet to decode first.
+  // The packets are stored in one array that grows on demand up to the buffer
+  // capacity, so that once the buffer has reached its steady-state size,
+  // packets arriving in order are appended, and the next packet is removed,
+  // without any allocation.
+  class PacketRing {
+   public:
+    explicit PacketRing(size_t max_capacity);
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    // Index 0 is the front of the ring.
+    Packet& operator[](size_t index) {
+      RTC_DCHECK_LT(index, size_);
+      return slots_[(head_ + index) % slots_.size()];
+    }
+    const Packet& operator[](size_t index) const {
+      RTC_DCHECK_LT(index, size_);
+      return slots_[(head_ + index) % slots_.size()];
+    }
+    Packet& front() { return (*this)[0]; }
+    const Packet& front() const { return (*this)[0]; }
+    const Packet& back() const { return (*this)[size_ - 1]; }
+
+    void pop_front();
+    // Inserts `packet` before the packet at `index`.
+    void insert(size_t index, Packet&& packet);
+    void erase(size_t index);
+    void clear();
+    // Removes all packets for which `predicate` returns true, in a single
+    // pass that keeps the order of the remaining packets.
+    template <typename Predicate>
+    void remove_if(Predicate predicate) {
+      size_t kept = 0;
+      for (size_t i = 0; i < size_; ++i) {
+        Packet& packet = (*this)[i];
+        if (predicate(packet)) {
+          continue;
+        }
+        if (kept != i) {
+          (*this)[kept] = std::move(packet);
+        }
+        ++kept;
+      }
+      while (size_ > kept) {
+        (*this)[size_ - 1] = Packet();
+        --size_;
+      }
+    }
+
+   private:
+    void Grow();
+
+    const size_t max_capacity_;
+    std::vector<Packet> slots_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+  };
+
   absl::optional<SmartFlushingConfig> smart_flushing_config_;
   size_t max_number_of_packets_;
-  PacketList buffer_;
+  PacketRing buffer_;
   const TickTimer* tick_timer_;
 };
 
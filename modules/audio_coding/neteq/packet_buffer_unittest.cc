@@ -13,6 +13,7 @@
 #include "modules/audio_coding/neteq/packet_buffer.h"
 
 #include <memory>
+#include <utility>
 
 #include "api/audio_codecs/builtin_audio_decoder_factory.h"
 #include "api/neteq/tick_timer.h"
@@ -595,6 +596,48 @@ TEST(PacketBuffer, Reordering) {
   EXPECT_CALL(decoder_database, Die());  // Called when object is deleted.
 }
 
+// Keeps a few packets in a small buffer while inserting and extracting many,
+// so that the storage wraps around several times, with every other pair of
+// packets arriving swapped.
+TEST(PacketBuffer, ReorderingWhileWrappingAround) {
+  TickTimer tick_timer;
+  PacketBuffer buffer(4, &tick_timer);  // 4 packets.
+  const uint32_t start_ts = 4711;
+  const uint32_t ts_increment = 10;
+  PacketGenerator gen(17u, start_ts, 0, ts_increment);
+  StrictMock<MockStatisticsCalculator> mock_stats;
+  MockDecoderDatabase decoder_database;
+
+  const int payload_len = 10;
+  uint32_t expected_ts = start_ts;
+  for (int i = 0; i < 20; ++i) {
+    Packet first = gen.NextPacket(payload_len, nullptr);
+    Packet second = gen.NextPacket(payload_len, nullptr);
+    if (i % 2) {
+      std::swap(first, second);
+    }
+    for (Packet* packet : {&first, &second}) {
+      EXPECT_EQ(PacketBuffer::kOK,
+                buffer.InsertPacket(/*packet=*/std::move(*packet),
+                                    /*stats=*/&mock_stats,
+                                    /*last_decoded_length=*/payload_len,
+                                    /*sample_rate=*/1000,
+                                    /*target_level_ms=*/30,
+                                    /*decoder_database=*/decoder_database));
+    }
+    // Keep one packet buffered across iterations.
+    while (buffer.NumPacketsInBuffer() > 1) {
+      const absl::optional<Packet> packet = buffer.GetNextPacket();
+      ASSERT_TRUE(packet);
+      EXPECT_EQ(expected_ts, packet->timestamp);
+      expected_ts += ts_increment;
+    }
+  }
+  EXPECT_EQ(1u, buffer.NumPacketsInBuffer());
+
+  EXPECT_CALL(decoder_database, Die());  // Called when object is deleted.
+}
+
 // The test first inserts a packet with narrow-band CNG, then a packet with
 // wide-band speech. The expected behavior of the packet buffer is to detect a
 // change in sample rate, even though no speech packet has been inserted before,
@@ -17,6 +17,7 @@
 #include <type_traits>
 #include <utility>
 
+#include "absl/types/optional.h"
 #include "modules/audio_mixer/audio_frame_manipulator.h"
 #include "modules/audio_mixer/default_output_rate_calculator.h"
 #include "rtc_base/checks.h"
@@ -30,6 +31,9 @@ struct AudioMixerImpl::SourceStatus {
   Source* audio_source = nullptr;
   bool is_mixed = false;
   float gain = 0.0f;
+  // Whether the source was not pulled last round, with lazy source
+  // evaluation.
+  bool skipped = false;
 
   // A frame that will be passed to audio_source->GetAudioFrameWithInfo.
   AudioFrame audio_frame;
@@ -115,19 +119,26 @@ struct AudioMixerImpl::HelperContainers {
     audio_source_mixing_data_list.resize(size);
     ramp_list.resize(size);
     preferred_rates.resize(size);
+    sources_to_pull.resize(size);
+    ranked_sources.resize(size);
   }
 
   std::vector<AudioFrame*> audio_to_mix;
   std::vector<SourceFrame> audio_source_mixing_data_list;
   std::vector<SourceFrame> ramp_list;
   std::vector<int> preferred_rates;
+  std::vector<AudioMixerImpl::SourceStatus*> sources_to_pull;
+  // Audio level hint in -dBov and source.
+  std::vector<std::pair<int, AudioMixerImpl::SourceStatus*>> ranked_sources;
 };
 
 AudioMixerImpl::AudioMixerImpl(
     std::unique_ptr<OutputRateCalculator> output_rate_calculator,
     bool use_limiter,
-    int max_sources_to_mix)
+    int max_sources_to_mix,
+    bool lazy_source_evaluation)
     : max_sources_to_mix_(max_sources_to_mix),
+      lazy_source_evaluation_(lazy_source_evaluation),
       output_rate_calculator_(std::move(output_rate_calculator)),
       audio_source_list_(),
       helper_containers_(std::make_unique<HelperContainers>()),
@@ -149,9 +160,11 @@ rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create(
 rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create(
     std::unique_ptr<OutputRateCalculator> output_rate_calculator,
     bool use_limiter,
-    int max_sources_to_mix) {
+    int max_sources_to_mix,
+    bool lazy_source_evaluation) {
   return rtc::make_ref_counted<AudioMixerImpl>(
-      std::move(output_rate_calculator), use_limiter, max_sources_to_mix);
+      std::move(output_rate_calculator), use_limiter, max_sources_to_mix,
+      lazy_source_evaluation);
 }
 
 void AudioMixerImpl::Mix(size_t number_of_channels,
@@ -199,10 +212,10 @@ rtc::ArrayView<AudioFrame* const> AudioMixerImpl::GetAudioFromSources(
     int output_frequency) {
   // Get audio from the audio sources and put it in the SourceFrame vector.
   int audio_source_mixing_data_count = 0;
-  for (auto& source_and_status : audio_source_list_) {
+  for (SourceStatus* source_status : GetSourcesToPull()) {
     const auto audio_frame_info =
-        source_and_status->audio_source->GetAudioFrameWithInfo(
-            output_frequency, &source_and_status->audio_frame);
+        source_status->audio_source->GetAudioFrameWithInfo(
+            output_frequency, &source_status->audio_frame);
 
     if (audio_frame_info == Source::AudioFrameInfo::kError) {
       RTC_LOG_F(LS_WARNING) << "failed to GetAudioFrameWithInfo() from source";
@@ -210,16 +223,21 @@ rtc::ArrayView<AudioFrame* const> AudioMixerImpl::GetAudioFromSources(
     }
     helper_containers_
         ->audio_source_mixing_data_list[audio_source_mixing_data_count++] =
-        SourceFrame(source_and_status.get(), &source_and_status->audio_frame,
+        SourceFrame(source_status, &source_status->audio_frame,
                     audio_frame_info == Source::AudioFrameInfo::kMuted);
   }
   rtc::ArrayView<SourceFrame> audio_source_mixing_data_view(
       helper_containers_->audio_source_mixing_data_list.data(),
       audio_source_mixing_data_count);
 
-  // Sort frames by sorting function.
-  std::sort(audio_source_mixing_data_view.begin(),
-            audio_source_mixing_data_view.end(), ShouldMixBefore);
+  // Move the preferred frames to the front. Their relative order doesn't
+  // matter, so a partial selection is enough.
+  const int num_preferred_frames =
+      std::min(audio_source_mixing_data_count, max_sources_to_mix_);
+  std::nth_element(
+      audio_source_mixing_data_view.begin(),
+      audio_source_mixing_data_view.begin() + num_preferred_frames,
+      audio_source_mixing_data_view.end(), ShouldMixBefore);
 
   int max_audio_frame_counter = max_sources_to_mix_;
   int ramp_list_lengh = 0;
@@ -249,6 +267,64 @@ rtc::ArrayView<AudioFrame* const> AudioMixerImpl::GetAudioFromSources(
       helper_containers_->audio_to_mix.data(), audio_to_mix_count);
 }
 
+rtc::ArrayView<AudioMixerImpl::SourceStatus* const>
+AudioMixerImpl::GetSourcesToPull() {
+  std::vector<SourceStatus*>& sources_to_pull =
+      helper_containers_->sources_to_pull;
+  int num_sources_to_pull = 0;
+  if (!lazy_source_evaluation_) {
+    for (auto& source_status : audio_source_list_) {
+      sources_to_pull[num_sources_to_pull++] = source_status.get();
+    }
+    return rtc::ArrayView<SourceStatus* const>(sources_to_pull.data(),
+                                               num_sources_to_pull);
+  }
+
+  std::vector<std::pair<int, SourceStatus*>>& ranked_sources =
+      helper_containers_->ranked_sources;
+  int num_ranked_sources = 0;
+  for (auto& source_status : audio_source_list_) {
+    const absl::optional<int> audio_level =
+        source_status->audio_source->AudioLevelHint();
+    // Sources without a hint can't be ranked and are always pulled.
+    if (audio_level) {
+      ranked_sources[num_ranked_sources++] = {*audio_level,
+                                              source_status.get()};
+    } else {
+      sources_to_pull[num_sources_to_pull++] = source_status.get();
+    }
+  }
+
+  // Lower -dBov values are louder.
+  const int num_loudest_sources =
+      std::min(num_ranked_sources, max_sources_to_mix_);
+  std::nth_element(ranked_sources.begin(),
+                   ranked_sources.begin() + num_loudest_sources,
+                   ranked_sources.begin() + num_ranked_sources,
+                   [](const std::pair<int, SourceStatus*>& a,
+                      const std::pair<int, SourceStatus*>& b) {
+                     return a.first < b.first;
+                   });
+  for (int i = 0; i < num_ranked_sources; ++i) {
+    // Sources mixed last round are pulled so that they can be ramped out.
+    if (i < num_loudest_sources || ranked_sources[i].second->is_mixed) {
+      sources_to_pull[num_sources_to_pull++] = ranked_sources[i].second;
+    } else {
+      ranked_sources[i].second->skipped = true;
+    }
+  }
+  // A skipped source's jitter buffer was not drained, so it would play audio
+  // from when it was last pulled.
+  for (int i = 0; i < num_sources_to_pull; ++i) {
+    if (sources_to_pull[i]->skipped) {
+      sources_to_pull[i]->audio_source->DiscardBufferedAudio();
+      sources_to_pull[i]->skipped = false;
+    }
+  }
+  return rtc::ArrayView<SourceStatus* const>(sources_to_pull.data(),
+                                             num_sources_to_pull);
+}
+
 bool AudioMixerImpl::GetAudioSourceMixabilityStatusForTest(
     AudioMixerImpl::Source* audio_source) const {
   MutexLock lock(&mutex_);
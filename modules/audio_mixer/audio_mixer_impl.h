@@ -40,10 +40,17 @@ class AudioMixerImpl : public AudioMixer {
   static rtc::scoped_refptr<AudioMixerImpl> Create(
       int max_sources_to_mix = kDefaultNumberOfMixedAudioSources);
 
+  // With `lazy_source_evaluation`, sources reporting an AudioLevelHint() are
+  // ranked by it and only the `max_sources_to_mix` loudest of them, plus the
+  // ones mixed in the previous round, are asked for audio. Sources that are
+  // not asked don't advance their jitter buffers, and are told to discard
+  // their buffered audio when they are asked again. Meant for mixing a large
+  // number of sources of which only a few are audible at any time.
   static rtc::scoped_refptr<AudioMixerImpl> Create(
       std::unique_ptr<OutputRateCalculator> output_rate_calculator,
       bool use_limiter,
-      int max_sources_to_mix = kDefaultNumberOfMixedAudioSources);
+      int max_sources_to_mix = kDefaultNumberOfMixedAudioSources,
+      bool lazy_source_evaluation = false);
 
   ~AudioMixerImpl() override;
 
@@ -66,7 +73,8 @@ class AudioMixerImpl : public AudioMixer {
  protected:
   AudioMixerImpl(std::unique_ptr<OutputRateCalculator> output_rate_calculator,
                  bool use_limiter,
-                 int max_sources_to_mix);
+                 int max_sources_to_mix,
+                 bool lazy_source_evaluation);
 
  private:
   struct HelperContainers;
@@ -77,12 +85,18 @@ class AudioMixerImpl : public AudioMixer {
   rtc::ArrayView<AudioFrame* const> GetAudioFromSources(int output_frequency)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  // Returns the sources to ask for audio this round: all of them, or with
+  // lazy source evaluation, the loudest ones by their audio level hint.
+  rtc::ArrayView<SourceStatus* const> GetSourcesToPull()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   // The critical section lock guards audio source insertion and
   // removal, which can be done from any thread. The race checker
   // checks that mixing is done sequentially.
   mutable Mutex mutex_;
 
   const int max_sources_to_mix_;
+  const bool lazy_source_evaluation_;
 
   std::unique_ptr<OutputRateCalculator> output_rate_calculator_;
 
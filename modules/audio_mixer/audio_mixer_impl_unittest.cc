@@ -87,6 +87,8 @@ class MockMixerAudioSource : public ::testing::NiceMock<AudioMixer::Source> {
 
   MOCK_METHOD(int, PreferredSampleRate, (), (const, override));
   MOCK_METHOD(int, Ssrc, (), (const, override));
+  MOCK_METHOD(absl::optional<int>, AudioLevelHint, (), (const, override));
+  MOCK_METHOD(void, DiscardBufferedAudio, (), (override));
 
   AudioFrame* fake_frame() { return &fake_frame_; }
   AudioFrameInfo fake_info() { return fake_audio_frame_info_; }
@@ -743,6 +745,106 @@ TEST(AudioMixer, MixerShouldIncludeRtpPacketInfoFromMixedSourcesOnly) {
               UnorderedElementsAre(kPacketInfo0, kPacketInfo1));
 }
 
+TEST(AudioMixer, LazySourceEvaluationOnlyPullsLoudestSources) {
+  constexpr int kSourcesToMix = 2;
+  constexpr int kAudioSources = 5;
+  const auto mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/true,
+      kSourcesToMix, /*lazy_source_evaluation=*/true);
+
+  // Audio levels in -dBov, source 3 is the loudest and source 4 has no hint.
+  const absl::optional<int> kAudioLevels[kAudioSources] = {30, 90, 50, 10,
+                                                           absl::nullopt};
+  const bool kExpectedPulled[kAudioSources] = {true, false, false, true, true};
+  MockMixerAudioSource participants[kAudioSources];
+  for (int i = 0; i < kAudioSources; ++i) {
+    ResetFrame(participants[i].fake_frame());
+    ON_CALL(participants[i], AudioLevelHint())
+        .WillByDefault(Return(kAudioLevels[i]));
+    EXPECT_CALL(participants[i], GetAudioFrameWithInfo(_, _))
+        .Times(kExpectedPulled[i] ? 1 : 0);
+    EXPECT_TRUE(mixer->AddSource(&participants[i]));
+  }
+
+  mixer->Mix(1, &frame_for_mixing);
+  int num_mixed_sources = 0;
+  for (int i = 0; i < kAudioSources; ++i) {
+    if (mixer->GetAudioSourceMixabilityStatusForTest(&participants[i])) {
+      EXPECT_TRUE(kExpectedPulled[i]) << "Source " << i;
+      ++num_mixed_sources;
+    }
+  }
+  EXPECT_EQ(num_mixed_sources, kSourcesToMix);
+}
+
+TEST(AudioMixer, LazySourceEvaluationKeepsPullingMixedSources) {
+  const auto mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/true,
+      /*max_sources_to_mix=*/1, /*lazy_source_evaluation=*/true);
+
+  MockMixerAudioSource mixed_source;
+  ResetFrame(mixed_source.fake_frame());
+  ON_CALL(mixed_source, AudioLevelHint()).WillByDefault(Return(20));
+  mixer->AddSource(&mixed_source);
+  mixer->Mix(1, &frame_for_mixing);
+  ASSERT_TRUE(mixer->GetAudioSourceMixabilityStatusForTest(&mixed_source));
+
+  // A louder source takes over, but the previously mixed source is still
+  // pulled so that it can be ramped out.
+  MockMixerAudioSource louder_source;
+  ResetFrame(louder_source.fake_frame());
+  louder_source.fake_frame()->mutable_data()[0] = 1000;
+  ON_CALL(louder_source, AudioLevelHint()).WillByDefault(Return(5));
+  mixer->AddSource(&louder_source);
+
+  EXPECT_CALL(mixed_source, GetAudioFrameWithInfo(_, _)).Times(1);
+  EXPECT_CALL(louder_source, GetAudioFrameWithInfo(_, _)).Times(1);
+  mixer->Mix(1, &frame_for_mixing);
+  EXPECT_TRUE(mixer->GetAudioSourceMixabilityStatusForTest(&louder_source));
+  EXPECT_FALSE(mixer->GetAudioSourceMixabilityStatusForTest(&mixed_source));
+
+  EXPECT_CALL(mixed_source, GetAudioFrameWithInfo(_, _)).Times(0);
+  EXPECT_CALL(louder_source, GetAudioFrameWithInfo(_, _)).Times(1);
+  mixer->Mix(1, &frame_for_mixing);
+}
+
+TEST(AudioMixer, LazySourceEvaluationDiscardsAudioOfSkippedSources) {
+  const auto mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/true,
+      /*max_sources_to_mix=*/1, /*lazy_source_evaluation=*/true);
+
+  MockMixerAudioSource mixed_source;
+  ResetFrame(mixed_source.fake_frame());
+  ON_CALL(mixed_source, AudioLevelHint()).WillByDefault(Return(20));
+  MockMixerAudioSource skipped_source;
+  ResetFrame(skipped_source.fake_frame());
+  ON_CALL(skipped_source, AudioLevelHint()).WillByDefault(Return(50));
+  mixer->AddSource(&mixed_source);
+  mixer->AddSource(&skipped_source);
+
+  EXPECT_CALL(mixed_source, DiscardBufferedAudio).Times(0);
+  EXPECT_CALL(skipped_source, DiscardBufferedAudio).Times(0);
+  EXPECT_CALL(skipped_source, GetAudioFrameWithInfo(_, _)).Times(0);
+  mixer->Mix(1, &frame_for_mixing);
+  mixer->Mix(1, &frame_for_mixing);
+  ::testing::Mock::VerifyAndClearExpectations(&skipped_source);
+
+  // The skipped source gets louder and is pulled again, after dropping the
+  // audio buffered while it was skipped.
+  ON_CALL(skipped_source, AudioLevelHint()).WillByDefault(Return(5));
+  {
+    ::testing::InSequence s;
+    EXPECT_CALL(skipped_source, DiscardBufferedAudio).Times(1);
+    EXPECT_CALL(skipped_source, GetAudioFrameWithInfo(_, _)).Times(1);
+  }
+  mixer->Mix(1, &frame_for_mixing);
+  ::testing::Mock::VerifyAndClearExpectations(&skipped_source);
+
+  EXPECT_CALL(skipped_source, DiscardBufferedAudio).Times(0);
+  EXPECT_CALL(skipped_source, GetAudioFrameWithInfo(_, _)).Times(1);
+  mixer->Mix(1, &frame_for_mixing);
+}
+
 class HighOutputRateCalculator : public OutputRateCalculator {
  public:
   static const int kDefaultFrequency = 76000;
@@ -14,6 +14,7 @@
 #include <array>
 #include <cstdint>
 #include <iterator>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -25,6 +26,7 @@
 #include "common_audio/include/audio_util.h"
 #include "modules/audio_mixer/audio_frame_manipulator.h"
 #include "modules/audio_mixer/audio_mixer_impl.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
 #include "modules/audio_processing/include/audio_frame_view.h"
 #include "modules/audio_processing/include/audio_processing.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
@@ -78,6 +80,19 @@ void SetAudioFrameFields(rtc::ArrayView<const AudioFrame* const> mix_list,
   }
 }
 
+// Sets the fields of `audio_frame_for_mixing` to those SetAudioFrameFields()
+// gave `source`, without going through the mixed frames again.
+void CopyAudioFrameFields(const AudioFrame& source,
+                          AudioFrame* audio_frame_for_mixing) {
+  audio_frame_for_mixing->UpdateFrame(
+      source.timestamp_, nullptr, source.samples_per_channel_,
+      source.sample_rate_hz_, AudioFrame::kUndefined, AudioFrame::kVadUnknown,
+      source.num_channels_);
+  audio_frame_for_mixing->elapsed_time_ms_ = source.elapsed_time_ms_;
+  audio_frame_for_mixing->ntp_time_ms_ = source.ntp_time_ms_;
+  audio_frame_for_mixing->packet_infos_ = source.packet_infos_;
+}
+
 void MixFewFramesWithNoLimiter(rtc::ArrayView<const AudioFrame* const> mix_list,
                                AudioFrame* audio_frame_for_mixing) {
   if (mix_list.empty()) {
@@ -91,29 +106,42 @@ void MixFewFramesWithNoLimiter(rtc::ArrayView<const AudioFrame* const> mix_list,
             audio_frame_for_mixing->mutable_data());
 }
 
-void MixToFloatFrame(rtc::ArrayView<const AudioFrame* const> mix_list,
-                     size_t samples_per_channel,
-                     size_t number_of_channels,
-                     MixingBuffer* mixing_buffer) {
+// Mixes the interleaved frames in `mix_list` into `mix`, keeping the samples
+// interleaved so that the accumulation runs over contiguous memory.
+void MixToInterleavedFloat(rtc::ArrayView<const AudioFrame* const> mix_list,
+                           const MixingKernels& kernels,
+                           rtc::ArrayView<float> mix) {
+  RTC_DCHECK_LE(mix.size(), AudioFrame::kMaxDataSizeSamples);
+  std::fill(mix.begin(), mix.end(), 0.f);
+  for (const AudioFrame* frame : mix_list) {
+    kernels.AccumulateS16(
+        rtc::ArrayView<const int16_t>(frame->data(), mix.size()), mix);
+  }
+}
+
+void Deinterleave(rtc::ArrayView<const float> mix,
+                  size_t samples_per_channel,
+                  size_t number_of_channels,
+                  MixingBuffer* mixing_buffer) {
   RTC_DCHECK_LE(samples_per_channel, FrameCombiner::kMaximumChannelSize);
   RTC_DCHECK_LE(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
-  // Clear the mixing buffer.
-  for (auto& one_channel_buffer : *mixing_buffer) {
-    std::fill(one_channel_buffer.begin(), one_channel_buffer.end(), 0.f);
+  for (size_t j = 0; j < std::min(number_of_channels,
+                                  FrameCombiner::kMaximumNumberOfChannels);
+       ++j) {
+    for (size_t k = 0;
+         k < std::min(samples_per_channel, FrameCombiner::kMaximumChannelSize);
+         ++k) {
+      (*mixing_buffer)[j][k] = mix[number_of_channels * k + j];
+    }
   }
+}
 
-  // Convert to FloatS16 and mix.
-  for (size_t i = 0; i < mix_list.size(); ++i) {
-    const AudioFrame* const frame = mix_list[i];
-    const int16_t* const frame_data = frame->data();
-    for (size_t j = 0; j < std::min(number_of_channels,
-                                    FrameCombiner::kMaximumNumberOfChannels);
-         ++j) {
-      for (size_t k = 0; k < std::min(samples_per_channel,
-                                      FrameCombiner::kMaximumChannelSize);
-           ++k) {
-        (*mixing_buffer)[j][k] += frame_data[number_of_channels * k + j];
-      }
+void Interleave(AudioFrameView<const float> mixing_buffer_view,
+                size_t number_of_channels,
+                rtc::ArrayView<float> mix) {
+  for (int j = 0; j < mixing_buffer_view.num_channels(); ++j) {
+    for (int k = 0; k < mixing_buffer_view.samples_per_channel(); ++k) {
+      mix[number_of_channels * k + j] = mixing_buffer_view.channel(j)[k];
     }
   }
 }
@@ -126,20 +154,6 @@ void RunLimiter(AudioFrameView<float> mixing_buffer_view, Limiter* limiter) {
   limiter->Process(mixing_buffer_view);
 }
 
-// Both interleaves and rounds.
-void InterleaveToAudioFrame(AudioFrameView<const float> mixing_buffer_view,
-                            AudioFrame* audio_frame_for_mixing) {
-  const size_t number_of_channels = mixing_buffer_view.num_channels();
-  const size_t samples_per_channel = mixing_buffer_view.samples_per_channel();
-  int16_t* const mixing_data = audio_frame_for_mixing->mutable_data();
-  // Put data in the result frame.
-  for (size_t i = 0; i < number_of_channels; ++i) {
-    for (size_t j = 0; j < samples_per_channel; ++j) {
-      mixing_data[number_of_channels * j + i] =
-          FloatS16ToS16(mixing_buffer_view.channel(i)[j]);
-    }
-  }
-}
 }  // namespace
 
 constexpr size_t FrameCombiner::kMaximumNumberOfChannels;
@@ -150,6 +164,9 @@ FrameCombiner::FrameCombiner(bool use_limiter)
       mixing_buffer_(
           std::make_unique<std::array<std::array<float, kMaximumChannelSize>,
                                       kMaximumNumberOfChannels>>()),
+      mix_minus_buffer_(std::make_unique<InterleavedBuffer>()),
+      interleaved_buffer_(std::make_unique<InterleavedBuffer>()),
+      kernels_(GetAvailableCpuFeatures()),
       limiter_(static_cast<size_t>(48000), data_dumper_.get(), "AudioMixer"),
       use_limiter_(use_limiter) {
   static_assert(kMaximumChannelSize * kMaximumNumberOfChannels <=
@@ -190,28 +207,127 @@ void FrameCombiner::Combine(rtc::ArrayView<AudioFrame* const> mix_list,
     return;
   }
 
-  MixToFloatFrame(mix_list, samples_per_channel, number_of_channels,
-                  mixing_buffer_.get());
+  const rtc::ArrayView<float> mix(interleaved_buffer_->data(),
+                                  number_of_channels * samples_per_channel);
+  MixToInterleavedFloat(mix_list, kernels_, mix);
+
+  if (use_limiter_) {
+    AudioFrameView<float> mixing_buffer_view =
+        DeinterleaveMix(mix, number_of_channels, samples_per_channel);
+    RunLimiter(mixing_buffer_view, &limiter_);
+    Interleave(mixing_buffer_view, number_of_channels, mix);
+  }
+
+  kernels_.FloatS16ToS16(
+      mix, rtc::ArrayView<int16_t>(audio_frame_for_mixing->mutable_data(),
+                                   mix.size()));
+}
+
+AudioFrameView<float> FrameCombiner::DeinterleaveMix(
+    rtc::ArrayView<const float> mix,
+    size_t number_of_channels,
+    size_t samples_per_channel) {
+  Deinterleave(mix, samples_per_channel, number_of_channels,
+               mixing_buffer_.get());
 
   const size_t output_number_of_channels =
       std::min(number_of_channels, kMaximumNumberOfChannels);
   const size_t output_samples_per_channel =
       std::min(samples_per_channel, kMaximumChannelSize);
-
-  // Put float data in an AudioFrameView.
-  std::array<float*, kMaximumNumberOfChannels> channel_pointers{};
   for (size_t i = 0; i < output_number_of_channels; ++i) {
-    channel_pointers[i] = &(*mixing_buffer_.get())[i][0];
+    channel_pointers_[i] = &(*mixing_buffer_.get())[i][0];
   }
-  AudioFrameView<float> mixing_buffer_view(&channel_pointers[0],
-                                           output_number_of_channels,
-                                           output_samples_per_channel);
+  return AudioFrameView<float>(&channel_pointers_[0],
+                               output_number_of_channels,
+                               output_samples_per_channel);
+}
 
-  if (use_limiter_) {
-    RunLimiter(mixing_buffer_view, &limiter_);
+void FrameCombiner::CombineMixMinus(
+    rtc::ArrayView<AudioFrame* const> mix_list,
+    size_t number_of_channels,
+    int sample_rate,
+    rtc::ArrayView<const MixMinusOutput> outputs) {
+  LogMixingStats(mix_list, sample_rate, mix_list.size());
+
+  const size_t samples_per_channel = static_cast<size_t>(
+      (sample_rate * webrtc::AudioMixerImpl::kFrameDurationInMs) / 1000);
+
+  for (auto* frame : mix_list) {
+    RTC_DCHECK_EQ(samples_per_channel, frame->samples_per_channel_);
+    RTC_DCHECK_EQ(sample_rate, frame->sample_rate_hz_);
+    RemixFrame(number_of_channels, frame);
   }
 
-  InterleaveToAudioFrame(mixing_buffer_view, audio_frame_for_mixing);
+  // The full mix, which the outputs are derived from by subtracting the own
+  // frame.
+  const size_t number_of_samples = number_of_channels * samples_per_channel;
+  const rtc::ArrayView<float> mix(interleaved_buffer_->data(),
+                                  number_of_samples);
+  MixToInterleavedFloat(mix_list, kernels_, mix);
+  const rtc::ArrayView<float> mix_minus(mix_minus_buffer_->data(),
+                                        number_of_samples);
+
+  ++mix_minus_call_count_;
+  // Outputs whose own frame isn't mixed all receive the full mix, so its
+  // metadata is computed once and shared; the packet infos are ref counted.
+  const AudioFrame* full_mix_output = nullptr;
+  for (const MixMinusOutput& output : outputs) {
+    RTC_DCHECK(output.audio_frame_for_mixing);
+    if (output.own_frame) {
+      mix_minus_list_.clear();
+      for (const AudioFrame* frame : mix_list) {
+        if (frame != output.own_frame) {
+          mix_minus_list_.push_back(frame);
+        }
+      }
+      RTC_DCHECK_EQ(mix_minus_list_.size() + 1, mix_list.size());
+      SetAudioFrameFields(mix_minus_list_, number_of_channels, sample_rate,
+                          mix_list.size(), output.audio_frame_for_mixing);
+    } else if (!full_mix_output) {
+      SetAudioFrameFields(mix_list, number_of_channels, sample_rate,
+                          mix_list.size(), output.audio_frame_for_mixing);
+      full_mix_output = output.audio_frame_for_mixing;
+    } else {
+      CopyAudioFrameFields(*full_mix_output, output.audio_frame_for_mixing);
+    }
+
+    std::copy(mix.begin(), mix.end(), mix_minus.begin());
+    if (output.own_frame) {
+      kernels_.SubtractS16(rtc::ArrayView<const int16_t>(
+                               output.own_frame->data(), number_of_samples),
+                           mix_minus);
+    }
+
+    if (use_limiter_) {
+      MixMinusLimiter& limiter = mix_minus_limiters_[output.participant_id];
+      RTC_DCHECK_NE(limiter.last_used, mix_minus_call_count_)
+          << "Duplicate participant " << output.participant_id;
+      limiter.last_used = mix_minus_call_count_;
+      if (!limiter.limiter) {
+        limiter.limiter = std::make_unique<Limiter>(48000, data_dumper_.get(),
+                                                    "AudioMixer");
+      }
+      AudioFrameView<float> mixing_buffer_view =
+          DeinterleaveMix(mix_minus, number_of_channels, samples_per_channel);
+      RunLimiter(mixing_buffer_view, limiter.limiter.get());
+      Interleave(mixing_buffer_view, number_of_channels, mix_minus);
+    }
+
+    kernels_.FloatS16ToS16(
+        mix_minus,
+        rtc::ArrayView<int16_t>(output.audio_frame_for_mixing->mutable_data(),
+                                number_of_samples));
+  }
+
+  // Drop the limiters of participants that are no longer listed.
+  for (auto it = mix_minus_limiters_.begin();
+       it != mix_minus_limiters_.end();) {
+    if (it->second.last_used != mix_minus_call_count_) {
+      it = mix_minus_limiters_.erase(it);
+    } else {
+      ++it;
+    }
+  }
 }
 
 void FrameCombiner::LogMixingStats(
@@ -11,12 +11,18 @@
 #ifndef MODULES_AUDIO_MIXER_FRAME_COMBINER_H_
 #define MODULES_AUDIO_MIXER_FRAME_COMBINER_H_
 
+#include <stdint.h>
+
+#include <array>
+#include <map>
 #include <memory>
 #include <vector>
 
 #include "api/array_view.h"
 #include "api/audio/audio_frame.h"
+#include "modules/audio_mixer/mixing_kernels.h"
 #include "modules/audio_processing/agc2/limiter.h"
+#include "modules/audio_processing/include/audio_frame_view.h"
 
 namespace webrtc {
 class ApmDataDumper;
@@ -39,21 +45,60 @@ class FrameCombiner {
                size_t number_of_streams,
                AudioFrame* audio_frame_for_mixing);
 
+  struct MixMinusOutput {
+    // Identifies the receiving participant across calls, e.g. by its SSRC.
+    int participant_id;
+    // The participant's own frame in the mix list, which is left out of its
+    // mix. Null if the participant's audio isn't mixed.
+    const AudioFrame* own_frame;
+    AudioFrame* audio_frame_for_mixing;
+  };
+
+  // Mix-minus (N-1) mixing for server side conferencing: produces one mix per
+  // entry in `outputs`, holding all frames in `mix_list` except the
+  // participant's own. The frames are summed once and each output is derived
+  // by subtracting the own frame, both with the vectorized mixing kernels, so
+  // the cost is linear in the number of outputs. When the limiter is used,
+  // each participant has its own, which is kept across calls and dropped once
+  // the participant is no longer listed.
+  void CombineMixMinus(rtc::ArrayView<AudioFrame* const> mix_list,
+                       size_t number_of_channels,
+                       int sample_rate,
+                       rtc::ArrayView<const MixMinusOutput> outputs);
+
   // Stereo, 48 kHz, 10 ms.
   static constexpr size_t kMaximumNumberOfChannels = 8;
   static constexpr size_t kMaximumChannelSize = 48 * 10;
 
   using MixingBuffer = std::array<std::array<float, kMaximumChannelSize>,
                                   kMaximumNumberOfChannels>;
+  using InterleavedBuffer = std::array<float, AudioFrame::kMaxDataSizeSamples>;
 
  private:
   void LogMixingStats(rtc::ArrayView<const AudioFrame* const> mix_list,
                       int sample_rate,
                       size_t number_of_streams) const;
+  // Deinterleaves `mix` into `mixing_buffer_` and returns a view of it.
+  AudioFrameView<float> DeinterleaveMix(rtc::ArrayView<const float> mix,
+                                        size_t number_of_channels,
+                                        size_t samples_per_channel);
 
   std::unique_ptr<ApmDataDumper> data_dumper_;
   std::unique_ptr<MixingBuffer> mixing_buffer_;
+  std::unique_ptr<InterleavedBuffer> mix_minus_buffer_;
+  std::unique_ptr<InterleavedBuffer> interleaved_buffer_;
+  std::array<float*, kMaximumNumberOfChannels> channel_pointers_{};
+  const MixingKernels kernels_;
   Limiter limiter_;
+  struct MixMinusLimiter {
+    std::unique_ptr<Limiter> limiter;
+    // Value of `mix_minus_call_count_` when the participant was last listed.
+    uint64_t last_used = 0;
+  };
+  std::map<int, MixMinusLimiter> mix_minus_limiters_;
+  uint64_t mix_minus_call_count_ = 0;
+  // Scratch list of the frames mixed for one output, kept across calls.
+  std::vector<const AudioFrame*> mix_minus_list_;
   const bool use_limiter_;
   mutable int uma_logging_counter_ = 0;
 };
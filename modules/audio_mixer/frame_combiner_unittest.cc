@@ -10,11 +10,13 @@
 
 #include "modules/audio_mixer/frame_combiner.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <initializer_list>
 #include <numeric>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "absl/types/optional.h"
@@ -280,6 +282,128 @@ TEST(FrameCombiner, CombiningOneFrameShouldNotChangeFrame) {
   }
 }
 
+TEST(FrameCombiner, MixMinusLeavesOutOwnFrame) {
+  FrameCombiner combiner(false);
+  for (const int rate : {8000, 16000, 48000}) {
+    for (const int number_of_channels : {1, 2}) {
+      SCOPED_TRACE(ProduceDebugText(rate, number_of_channels, 2));
+      const size_t number_of_samples = number_of_channels * rate / 100;
+
+      SetUpFrames(rate, number_of_channels);
+      std::fill_n(frame1.mutable_data(), number_of_samples, 1000);
+      std::fill_n(frame2.mutable_data(), number_of_samples, -300);
+      const std::vector<AudioFrame*> frames_to_combine = {&frame1, &frame2};
+
+      // Participant 3 isn't mixed and receives the full mix.
+      AudioFrame output1;
+      AudioFrame output2;
+      AudioFrame output3;
+      const std::vector<FrameCombiner::MixMinusOutput> outputs = {
+          {/*participant_id=*/1, &frame1, &output1},
+          {/*participant_id=*/2, &frame2, &output2},
+          {/*participant_id=*/3, nullptr, &output3}};
+      combiner.CombineMixMinus(frames_to_combine, number_of_channels, rate,
+                               outputs);
+
+      for (const auto& [output, expected_value] :
+           {std::make_pair(&output1, -300), std::make_pair(&output2, 1000),
+            std::make_pair(&output3, 700)}) {
+        const std::vector<int16_t> mixed_data(
+            output->data(), output->data() + number_of_samples);
+        EXPECT_EQ(mixed_data,
+                  std::vector<int16_t>(number_of_samples, expected_value));
+        EXPECT_EQ(output->sample_rate_hz_, rate);
+        EXPECT_EQ(output->num_channels_,
+                  static_cast<size_t>(number_of_channels));
+      }
+      EXPECT_THAT(output1.packet_infos_,
+                  ElementsAreArray(frame2.packet_infos_));
+      EXPECT_THAT(output2.packet_infos_,
+                  ElementsAreArray(frame1.packet_infos_));
+      std::vector<RtpPacketInfo> all_packet_infos(frame1.packet_infos_.begin(),
+                                                  frame1.packet_infos_.end());
+      all_packet_infos.insert(all_packet_infos.end(),
+                              frame2.packet_infos_.begin(),
+                              frame2.packet_infos_.end());
+      EXPECT_THAT(output3.packet_infos_,
+                  UnorderedElementsAreArray(all_packet_infos));
+    }
+  }
+}
+
+TEST(FrameCombiner, MixMinusListenersShareFullMix) {
+  FrameCombiner combiner(false);
+  constexpr int kRate = 16000;
+  constexpr int kNumberOfChannels = 1;
+  constexpr size_t kNumberOfSamples = kRate / 100;
+  SetUpFrames(kRate, kNumberOfChannels);
+  std::fill_n(frame1.mutable_data(), kNumberOfSamples, 1000);
+  std::fill_n(frame2.mutable_data(), kNumberOfSamples, -300);
+  const std::vector<AudioFrame*> frames_to_combine = {&frame1, &frame2};
+
+  AudioFrame speaker_output;
+  AudioFrame listener_output1;
+  AudioFrame listener_output2;
+  const std::vector<FrameCombiner::MixMinusOutput> outputs = {
+      {/*participant_id=*/3, nullptr, &listener_output1},
+      {/*participant_id=*/1, &frame1, &speaker_output},
+      {/*participant_id=*/4, nullptr, &listener_output2}};
+  combiner.CombineMixMinus(frames_to_combine, kNumberOfChannels, kRate,
+                           outputs);
+
+  EXPECT_THAT(speaker_output.packet_infos_,
+              ElementsAreArray(frame2.packet_infos_));
+  for (const AudioFrame* output : {&listener_output1, &listener_output2}) {
+    EXPECT_EQ(std::vector<int16_t>(output->data(),
+                                   output->data() + kNumberOfSamples),
+              std::vector<int16_t>(kNumberOfSamples, 700));
+    EXPECT_EQ(output->sample_rate_hz_, kRate);
+    EXPECT_EQ(output->samples_per_channel_, kNumberOfSamples);
+    EXPECT_EQ(output->timestamp_, listener_output1.timestamp_);
+    EXPECT_EQ(output->ntp_time_ms_, listener_output1.ntp_time_ms_);
+    EXPECT_EQ(output->elapsed_time_ms_, listener_output1.elapsed_time_ms_);
+    EXPECT_EQ(output->packet_infos_.size(),
+              frame1.packet_infos_.size() + frame2.packet_infos_.size());
+  }
+  EXPECT_THAT(listener_output2.packet_infos_,
+              ElementsAreArray(listener_output1.packet_infos_));
+}
+
+TEST(FrameCombiner, MixMinusWithLimiterKeepsOutputsInRange) {
+  FrameCombiner combiner(true);
+  constexpr int kRate = 48000;
+  constexpr int kNumberOfChannels = 1;
+  constexpr size_t kNumberOfSamples = kRate / 100;
+  SetUpFrames(kRate, kNumberOfChannels);
+  AudioFrame frame3;
+  frame3.UpdateFrame(0, nullptr, kNumberOfSamples, kRate,
+                     AudioFrame::kNormalSpeech, AudioFrame::kVadActive,
+                     kNumberOfChannels);
+  const std::vector<AudioFrame*> frames_to_combine = {&frame1, &frame2,
+                                                      &frame3};
+  AudioFrame output1;
+  AudioFrame output2;
+  AudioFrame output3;
+  const std::vector<FrameCombiner::MixMinusOutput> outputs = {
+      {/*participant_id=*/1, &frame1, &output1},
+      {/*participant_id=*/2, &frame2, &output2},
+      {/*participant_id=*/3, &frame3, &output3}};
+  for (int i = 0; i < 10; ++i) {
+    for (auto* frame : frames_to_combine) {
+      std::fill_n(frame->mutable_data(), kNumberOfSamples, 30000);
+    }
+    combiner.CombineMixMinus(frames_to_combine, kNumberOfChannels, kRate,
+                             outputs);
+  }
+  // Each output sums two full scale frames; the limiter must keep the result
+  // from wrapping around.
+  for (const AudioFrame* output : {&output1, &output2, &output3}) {
+    for (size_t i = 0; i < kNumberOfSamples; ++i) {
+      EXPECT_GT(output->data()[i], 0);
+    }
+  }
+}
+
 // Send a sine wave through the FrameCombiner, and check that the
 // difference between input and output varies smoothly. Also check
 // that it is inside reasonable bounds. This is to catch issues like
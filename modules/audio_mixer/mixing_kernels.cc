@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_mixer/mixing_kernels.h"
+
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+
+#include "common_audio/include/audio_util.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+void MixingKernels::AccumulateS16(rtc::ArrayView<const int16_t> x,
+                                  rtc::ArrayView<float> y) const {
+  RTC_DCHECK_EQ(x.size(), y.size());
+  size_t i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (cpu_features_.avx2) {
+    AccumulateS16Avx2(x, y);
+    return;
+  } else if (cpu_features_.sse2) {
+    constexpr size_t kBlockSize = 8;
+    for (; i + kBlockSize <= x.size(); i += kBlockSize) {
+      const __m128i x_i =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&x[i]));
+      // Sign extend to 32 bits by placing each sample in the upper half and
+      // shifting it back down.
+      const __m128i x_low = _mm_srai_epi32(_mm_unpacklo_epi16(x_i, x_i), 16);
+      const __m128i x_high = _mm_srai_epi32(_mm_unpackhi_epi16(x_i, x_i), 16);
+      _mm_storeu_ps(&y[i],
+                    _mm_add_ps(_mm_loadu_ps(&y[i]), _mm_cvtepi32_ps(x_low)));
+      _mm_storeu_ps(&y[i + 4], _mm_add_ps(_mm_loadu_ps(&y[i + 4]),
+                                          _mm_cvtepi32_ps(x_high)));
+    }
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  if (cpu_features_.neon) {
+    constexpr size_t kBlockSize = 8;
+    for (; i + kBlockSize <= x.size(); i += kBlockSize) {
+      const int16x8_t x_i = vld1q_s16(&x[i]);
+      const float32x4_t x_low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(x_i)));
+      const float32x4_t x_high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(x_i)));
+      vst1q_f32(&y[i], vaddq_f32(vld1q_f32(&y[i]), x_low));
+      vst1q_f32(&y[i + 4], vaddq_f32(vld1q_f32(&y[i + 4]), x_high));
+    }
+  }
+#endif
+  for (; i < x.size(); ++i) {
+    y[i] += x[i];
+  }
+}
+
+void MixingKernels::SubtractS16(rtc::ArrayView<const int16_t> x,
+                                rtc::ArrayView<float> y) const {
+  RTC_DCHECK_EQ(x.size(), y.size());
+  size_t i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (cpu_features_.avx2) {
+    SubtractS16Avx2(x, y);
+    return;
+  } else if (cpu_features_.sse2) {
+    constexpr size_t kBlockSize = 8;
+    for (; i + kBlockSize <= x.size(); i += kBlockSize) {
+      const __m128i x_i =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&x[i]));
+      const __m128i x_low = _mm_srai_epi32(_mm_unpacklo_epi16(x_i, x_i), 16);
+      const __m128i x_high = _mm_srai_epi32(_mm_unpackhi_epi16(x_i, x_i), 16);
+      _mm_storeu_ps(&y[i],
+                    _mm_sub_ps(_mm_loadu_ps(&y[i]), _mm_cvtepi32_ps(x_low)));
+      _mm_storeu_ps(&y[i + 4], _mm_sub_ps(_mm_loadu_ps(&y[i + 4]),
+                                          _mm_cvtepi32_ps(x_high)));
+    }
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  if (cpu_features_.neon) {
+    constexpr size_t kBlockSize = 8;
+    for (; i + kBlockSize <= x.size(); i += kBlockSize) {
+      const int16x8_t x_i = vld1q_s16(&x[i]);
+      const float32x4_t x_low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(x_i)));
+      const float32x4_t x_high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(x_i)));
+      vst1q_f32(&y[i], vsubq_f32(vld1q_f32(&y[i]), x_low));
+      vst1q_f32(&y[i + 4], vsubq_f32(vld1q_f32(&y[i + 4]), x_high));
+    }
+  }
+#endif
+  for (; i < x.size(); ++i) {
+    y[i] -= x[i];
+  }
+}
+
+void MixingKernels::FloatS16ToS16(rtc::ArrayView<const float> x,
+                                  rtc::ArrayView<int16_t> y) const {
+  RTC_DCHECK_EQ(x.size(), y.size());
+  size_t i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (cpu_features_.avx2) {
+    FloatS16ToS16Avx2(x, y);
+    return;
+  } else if (cpu_features_.sse2) {
+    constexpr size_t kBlockSize = 8;
+    const __m128 kMin = _mm_set1_ps(-32768.f);
+    const __m128 kMax = _mm_set1_ps(32767.f);
+    const __m128 kHalf = _mm_set1_ps(0.5f);
+    const __m128 kSignMask = _mm_set1_ps(-0.f);
+    // Clamps, then rounds half away from zero by adding +/-0.5 and truncating.
+    auto round = [&](__m128 v) {
+      v = _mm_max_ps(_mm_min_ps(v, kMax), kMin);
+      const __m128 half = _mm_or_ps(_mm_and_ps(v, kSignMask), kHalf);
+      return _mm_cvttps_epi32(_mm_add_ps(v, half));
+    };
+    for (; i + kBlockSize <= x.size(); i += kBlockSize) {
+      const __m128i low = round(_mm_loadu_ps(&x[i]));
+      const __m128i high = round(_mm_loadu_ps(&x[i + 4]));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(&y[i]),
+                       _mm_packs_epi32(low, high));
+    }
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  if (cpu_features_.neon) {
+    constexpr size_t kBlockSize = 8;
+    const float32x4_t kMin = vdupq_n_f32(-32768.f);
+    const float32x4_t kMax = vdupq_n_f32(32767.f);
+    const uint32x4_t kHalf = vreinterpretq_u32_f32(vdupq_n_f32(0.5f));
+    const uint32x4_t kSignMask = vdupq_n_u32(0x80000000);
+    // Clamps, then rounds half away from zero by adding +/-0.5 and truncating.
+    auto round = [&](float32x4_t v) {
+      v = vmaxq_f32(vminq_f32(v, kMax), kMin);
+      const float32x4_t half = vreinterpretq_f32_u32(
+          vorrq_u32(vandq_u32(vreinterpretq_u32_f32(v), kSignMask), kHalf));
+      return vqmovn_s32(vcvtq_s32_f32(vaddq_f32(v, half)));
+    };
+    for (; i + kBlockSize <= x.size(); i += kBlockSize) {
+      vst1q_s16(&y[i], vcombine_s16(round(vld1q_f32(&x[i])),
+                                    round(vld1q_f32(&x[i + 4]))));
+    }
+  }
+#endif
+  for (; i < x.size(); ++i) {
+    y[i] = ::webrtc::FloatS16ToS16(x[i]);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,55 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_MIXER_MIXING_KERNELS_H_
+#define MODULES_AUDIO_MIXER_MIXING_KERNELS_H_
+
+#include <stdint.h>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
+
+namespace webrtc {
+
+// Sample format conversions used when mixing, vectorized with SSE2, AVX2 or
+// NEON depending on the available CPU features. The results are bit exact
+// with the scalar implementations.
+class MixingKernels {
+ public:
+  explicit MixingKernels(AvailableCpuFeatures cpu_features)
+      : cpu_features_(cpu_features) {}
+
+  // Converts the S16 samples in `x` to FloatS16 and adds them to `y`.
+  void AccumulateS16(rtc::ArrayView<const int16_t> x,
+                     rtc::ArrayView<float> y) const;
+
+  // Converts the S16 samples in `x` to FloatS16 and subtracts them from `y`.
+  void SubtractS16(rtc::ArrayView<const int16_t> x,
+                   rtc::ArrayView<float> y) const;
+
+  // Rounds and saturates the FloatS16 samples in `x` into `y`, same as
+  // FloatS16ToS16() in common_audio.
+  void FloatS16ToS16(rtc::ArrayView<const float> x,
+                     rtc::ArrayView<int16_t> y) const;
+
+ private:
+  void AccumulateS16Avx2(rtc::ArrayView<const int16_t> x,
+                         rtc::ArrayView<float> y) const;
+  void SubtractS16Avx2(rtc::ArrayView<const int16_t> x,
+                       rtc::ArrayView<float> y) const;
+  void FloatS16ToS16Avx2(rtc::ArrayView<const float> x,
+                         rtc::ArrayView<int16_t> y) const;
+
+  const AvailableCpuFeatures cpu_features_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_MIXER_MIXING_KERNELS_H_
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "common_audio/include/audio_util.h"
+#include "modules/audio_mixer/mixing_kernels.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+void MixingKernels::AccumulateS16Avx2(rtc::ArrayView<const int16_t> x,
+                                      rtc::ArrayView<float> y) const {
+  RTC_DCHECK(cpu_features_.avx2);
+  RTC_DCHECK_EQ(x.size(), y.size());
+  constexpr size_t kBlockSize = 16;
+  size_t i = 0;
+  for (; i + kBlockSize <= x.size(); i += kBlockSize) {
+    const __m256 x_low = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&x[i]))));
+    const __m256 x_high = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&x[i + 8]))));
+    _mm256_storeu_ps(&y[i], _mm256_add_ps(_mm256_loadu_ps(&y[i]), x_low));
+    _mm256_storeu_ps(&y[i + 8],
+                     _mm256_add_ps(_mm256_loadu_ps(&y[i + 8]), x_high));
+  }
+  for (; i < x.size(); ++i) {
+    y[i] += x[i];
+  }
+}
+
+void MixingKernels::SubtractS16Avx2(rtc::ArrayView<const int16_t> x,
+                                    rtc::ArrayView<float> y) const {
+  RTC_DCHECK(cpu_features_.avx2);
+  RTC_DCHECK_EQ(x.size(), y.size());
+  constexpr size_t kBlockSize = 16;
+  size_t i = 0;
+  for (; i + kBlockSize <= x.size(); i += kBlockSize) {
+    const __m256 x_low = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&x[i]))));
+    const __m256 x_high = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&x[i + 8]))));
+    _mm256_storeu_ps(&y[i], _mm256_sub_ps(_mm256_loadu_ps(&y[i]), x_low));
+    _mm256_storeu_ps(&y[i + 8],
+                     _mm256_sub_ps(_mm256_loadu_ps(&y[i + 8]), x_high));
+  }
+  for (; i < x.size(); ++i) {
+    y[i] -= x[i];
+  }
+}
+
+void MixingKernels::FloatS16ToS16Avx2(rtc::ArrayView<const float> x,
+                                      rtc::ArrayView<int16_t> y) const {
+  RTC_DCHECK(cpu_features_.avx2);
+  RTC_DCHECK_EQ(x.size(), y.size());
+  constexpr size_t kBlockSize = 16;
+  const __m256 kMin = _mm256_set1_ps(-32768.f);
+  const __m256 kMax = _mm256_set1_ps(32767.f);
+  const __m256 kHalf = _mm256_set1_ps(0.5f);
+  const __m256 kSignMask = _mm256_set1_ps(-0.f);
+  // Clamps, then rounds half away from zero by adding +/-0.5 and truncating.
+  auto round = [&](__m256 v) {
+    v = _mm256_max_ps(_mm256_min_ps(v, kMax), kMin);
+    const __m256 half = _mm256_or_ps(_mm256_and_ps(v, kSignMask), kHalf);
+    return _mm256_cvttps_epi32(_mm256_add_ps(v, half));
+  };
+  size_t i = 0;
+  for (; i + kBlockSize <= x.size(); i += kBlockSize) {
+    const __m256i low = round(_mm256_loadu_ps(&x[i]));
+    const __m256i high = round(_mm256_loadu_ps(&x[i + 8]));
+    // The pack works within 128 bit lanes, restore the sample order.
+    const __m256i packed = _mm256_permute4x64_epi64(
+        _mm256_packs_epi32(low, high), 0xD8);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&y[i]), packed);
+  }
+  for (; i < x.size(); ++i) {
+    y[i] = ::webrtc::FloatS16ToS16(x[i]);
+  }
+}
+
+}  // namespace webrtc
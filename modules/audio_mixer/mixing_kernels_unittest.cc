@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_mixer/mixing_kernels.h"
+
+#include <vector>
+
+#include "common_audio/include/audio_util.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// Not a multiple of any of the block sizes, so that the scalar tails run too.
+constexpr size_t kSize = 2 * 480 + 7;
+
+class MixingKernelsParametrization
+    : public ::testing::TestWithParam<AvailableCpuFeatures> {};
+
+TEST_P(MixingKernelsParametrization, AccumulateS16IsBitExact) {
+  const MixingKernels kernels(/*cpu_features=*/GetParam());
+  Random random(42);
+  std::vector<int16_t> x(kSize);
+  std::vector<float> y(kSize);
+  for (size_t i = 0; i < kSize; ++i) {
+    x[i] = random.Rand<int16_t>();
+    y[i] = static_cast<float>(random.Gaussian(0.0, 30000.0));
+  }
+  std::vector<float> expected = y;
+  for (size_t i = 0; i < kSize; ++i) {
+    expected[i] += x[i];
+  }
+  kernels.AccumulateS16(x, y);
+  EXPECT_EQ(y, expected);
+}
+
+TEST_P(MixingKernelsParametrization, SubtractS16IsBitExact) {
+  const MixingKernels kernels(/*cpu_features=*/GetParam());
+  Random random(42);
+  std::vector<int16_t> x(kSize);
+  std::vector<float> y(kSize);
+  for (size_t i = 0; i < kSize; ++i) {
+    x[i] = random.Rand<int16_t>();
+    y[i] = static_cast<float>(random.Gaussian(0.0, 30000.0));
+  }
+  std::vector<float> expected = y;
+  for (size_t i = 0; i < kSize; ++i) {
+    expected[i] -= x[i];
+  }
+  kernels.SubtractS16(x, y);
+  EXPECT_EQ(y, expected);
+}
+
+TEST_P(MixingKernelsParametrization, FloatS16ToS16IsBitExact) {
+  const MixingKernels kernels(/*cpu_features=*/GetParam());
+  Random random(42);
+  std::vector<float> x(kSize);
+  for (size_t i = 0; i < kSize; ++i) {
+    x[i] = static_cast<float>(random.Gaussian(0.0, 30000.0));
+  }
+  // Rounding ties and the saturation limits.
+  x[0] = 2.5f;
+  x[1] = -2.5f;
+  x[2] = 32767.5f;
+  x[3] = -32768.5f;
+  x[4] = 1e9f;
+  x[5] = -1e9f;
+  std::vector<int16_t> expected(kSize);
+  for (size_t i = 0; i < kSize; ++i) {
+    expected[i] = FloatS16ToS16(x[i]);
+  }
+  std::vector<int16_t> y(kSize);
+  kernels.FloatS16ToS16(x, y);
+  EXPECT_EQ(y, expected);
+}
+
+// Finds the relevant CPU features combinations to test.
+std::vector<AvailableCpuFeatures> GetCpuFeaturesToTest() {
+  std::vector<AvailableCpuFeatures> v;
+  v.push_back({/*sse2=*/false, /*avx2=*/false, /*neon=*/false});
+  AvailableCpuFeatures available = GetAvailableCpuFeatures();
+  if (available.avx2) {
+    v.push_back({/*sse2=*/false, /*avx2=*/true, /*neon=*/false});
+  }
+  if (available.sse2) {
+    v.push_back({/*sse2=*/true, /*avx2=*/false, /*neon=*/false});
+  }
+  if (available.neon) {
+    v.push_back({/*sse2=*/false, /*avx2=*/false, /*neon=*/true});
+  }
+  return v;
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AudioMixer,
+    MixingKernelsParametrization,
+    ::testing::ValuesIn(GetCpuFeaturesToTest()),
+    [](const ::testing::TestParamInfo<AvailableCpuFeatures>& info) {
+      return info.param.ToString();
+    });
+
+}  // namespace
+}  // namespace webrtc
@@ -699,6 +699,12 @@ void MatchedFilter::Update(const DownsampledRenderBuffer& render_buffer,
             filters_[n], &filters_updated, &error_sum, compute_pre_echo,
             instantaneous_accumulated_error_, scratch_memory_);
         break;
+      case Aec3Optimization::kAvx512:
+        aec3::MatchedFilterCore_AVX512(
+            x_start_index, x2_sum_threshold, smoothing, render_buffer.buffer, y,
+            filters_[n], &filters_updated, &error_sum, compute_pre_echo,
+            instantaneous_accumulated_error_, scratch_memory_);
+        break;
 #endif
 #if defined(WEBRTC_HAS_NEON)
       case Aec3Optimization::kNeon:
@@ -123,6 +123,28 @@ TEST(VectorMath, Avx2Sqrt) {
   }
 }
 
+TEST(VectorMath, Avx512Sqrt) {
+  if (GetCPUInfo(kAVX512) != 0) {
+    std::array<float, kFftLengthBy2Plus1> x;
+    std::array<float, kFftLengthBy2Plus1> z;
+    std::array<float, kFftLengthBy2Plus1> z_avx512;
+
+    for (size_t k = 0; k < x.size(); ++k) {
+      x[k] = (2.f / 3.f) * k;
+    }
+
+    std::copy(x.begin(), x.end(), z.begin());
+    aec3::VectorMath(Aec3Optimization::kNone).Sqrt(z);
+    std::copy(x.begin(), x.end(), z_avx512.begin());
+    aec3::VectorMath(Aec3Optimization::kAvx512).Sqrt(z_avx512);
+    EXPECT_EQ(z, z_avx512);
+    for (size_t k = 0; k < z.size(); ++k) {
+      EXPECT_FLOAT_EQ(z[k], z_avx512[k]);
+      EXPECT_FLOAT_EQ(sqrtf(x[k]), z_avx512[k]);
+    }
+  }
+}
+
 TEST(VectorMath, Sse2Multiply) {
   if (GetCPUInfo(kSSE2) != 0) {
     std::array<float, kFftLengthBy2Plus1> x;
@@ -165,6 +187,27 @@ TEST(VectorMath, Avx2Multiply) {
   }
 }
 
+TEST(VectorMath, Avx512Multiply) {
+  if (GetCPUInfo(kAVX512) != 0) {
+    std::array<float, kFftLengthBy2Plus1> x;
+    std::array<float, kFftLengthBy2Plus1> y;
+    std::array<float, kFftLengthBy2Plus1> z;
+    std::array<float, kFftLengthBy2Plus1> z_avx512;
+
+    for (size_t k = 0; k < x.size(); ++k) {
+      x[k] = k;
+      y[k] = (2.f / 3.f) * k;
+    }
+
+    aec3::VectorMath(Aec3Optimization::kNone).Multiply(x, y, z);
+    aec3::VectorMath(Aec3Optimization::kAvx512).Multiply(x, y, z_avx512);
+    for (size_t k = 0; k < z.size(); ++k) {
+      EXPECT_FLOAT_EQ(z[k], z_avx512[k]);
+      EXPECT_FLOAT_EQ(x[k] * y[k], z_avx512[k]);
+    }
+  }
+}
+
 TEST(VectorMath, Sse2Accumulate) {
   if (GetCPUInfo(kSSE2) != 0) {
     std::array<float, kFftLengthBy2Plus1> x;
@@ -204,6 +247,26 @@ TEST(VectorMath, Avx2Accumulate) {
     }
   }
 }
+
+TEST(VectorMath, Avx512Accumulate) {
+  if (GetCPUInfo(kAVX512) != 0) {
+    std::array<float, kFftLengthBy2Plus1> x;
+    std::array<float, kFftLengthBy2Plus1> z;
+    std::array<float, kFftLengthBy2Plus1> z_avx512;
+
+    for (size_t k = 0; k < x.size(); ++k) {
+      x[k] = k;
+      z[k] = z_avx512[k] = 2.f * k;
+    }
+
+    aec3::VectorMath(Aec3Optimization::kNone).Accumulate(x, z);
+    aec3::VectorMath(Aec3Optimization::kAvx512).Accumulate(x, z_avx512);
+    for (size_t k = 0; k < z.size(); ++k) {
+      EXPECT_FLOAT_EQ(z[k], z_avx512[k]);
+      EXPECT_FLOAT_EQ(x[k] + 2.f * x[k], z_avx512[k]);
+    }
+  }
+}
 #endif
 
 }  // namespace webrtc
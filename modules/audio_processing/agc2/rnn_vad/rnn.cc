@@ -37,7 +37,8 @@ static_assert(kOutputLayerOutputSize <= kFullyConnectedLayerMaxUnits, "");
 
 }  // namespace
 
-RnnVad::RnnVad(const AvailableCpuFeatures& cpu_features)
+RnnVad::RnnVad(const AvailableCpuFeatures& cpu_features,
+               GruPrecision hidden_precision)
     : input_(kInputLayerInputSize,
              kInputLayerOutputSize,
              kInputDenseBias,
@@ -51,7 +52,8 @@ RnnVad::RnnVad(const AvailableCpuFeatures& cpu_features)
               kHiddenGruWeights,
               kHiddenGruRecurrentWeights,
               cpu_features,
-              /*layer_name=*/"GRU1"),
+              /*layer_name=*/"GRU1",
+              hidden_precision),
       output_(kHiddenLayerOutputSize,
               kOutputLayerOutputSize,
               kOutputDenseBias,
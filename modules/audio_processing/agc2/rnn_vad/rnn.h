@@ -30,7 +30,10 @@ namespace rnn_vad {
 // detection.
 class RnnVad {
  public:
-  explicit RnnVad(const AvailableCpuFeatures& cpu_features);
+  // `hidden_precision` is the precision of the GRU layer, which takes most of
+  // the inference time.
+  explicit RnnVad(const AvailableCpuFeatures& cpu_features,
+                  GruPrecision hidden_precision = GruPrecision::kFloat);
   RnnVad(const RnnVad&) = delete;
   RnnVad& operator=(const RnnVad&) = delete;
   ~RnnVad();
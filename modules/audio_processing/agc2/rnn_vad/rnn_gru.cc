@@ -10,6 +10,8 @@
 
 #include "modules/audio_processing/agc2/rnn_vad/rnn_gru.h"
 
+#include <algorithm>
+
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "third_party/rnnoise/src/rnn_activations.h"
@@ -20,29 +22,92 @@ namespace rnn_vad {
 namespace {
 
 constexpr int kNumGruGates = 3;  // Update, reset, output.
+static_assert(kGruLayerMaxUnits % 8 == 0,
+              "The padded GRU units must fit in the over-allocated arrays.");
 
-std::vector<float> PreprocessGruTensor(rtc::ArrayView<const int8_t> tensor_src,
+// Re-arranges `tensor_src` so that the coefficients of each gate and output
+// unit are contiguous.
+std::vector<int8_t> TransposeGruTensor(rtc::ArrayView<const int8_t> tensor_src,
                                        int output_size) {
-  // Transpose, cast and scale.
   // `n` is the size of the first dimension of the 3-dim tensor `weights`.
   const int n = rtc::CheckedDivExact(rtc::dchecked_cast<int>(tensor_src.size()),
                                      output_size * kNumGruGates);
   const int stride_src = kNumGruGates * output_size;
   const int stride_dst = n * output_size;
-  std::vector<float> tensor_dst(tensor_src.size());
+  std::vector<int8_t> tensor_dst(tensor_src.size());
   for (int g = 0; g < kNumGruGates; ++g) {
     for (int o = 0; o < output_size; ++o) {
       for (int i = 0; i < n; ++i) {
         tensor_dst[g * stride_dst + o * n + i] =
-            ::rnnoise::kWeightsScale *
-            static_cast<float>(
-                tensor_src[i * stride_src + g * output_size + o]);
+            tensor_src[i * stride_src + g * output_size + o];
+      }
+    }
+  }
+  return tensor_dst;
+}
+
+std::vector<float> PreprocessGruTensor(rtc::ArrayView<const int8_t> tensor_src,
+                                       int output_size) {
+  // Transpose, cast and scale.
+  const std::vector<int8_t> transposed =
+      TransposeGruTensor(tensor_src, output_size);
+  std::vector<float> tensor_dst(transposed.size());
+  std::transform(transposed.begin(), transposed.end(), tensor_dst.begin(),
+                 [](int8_t x) -> float {
+                   return ::rnnoise::kWeightsScale * static_cast<float>(x);
+                 });
+  return tensor_dst;
+}
+
+// Returns the smallest multiple of `m` that is not less than `x`.
+constexpr int RoundUp(int x, int m) {
+  return (x + m - 1) / m * m;
+}
+
+// Number of GRU units of a gate after padding, as required by
+// `VectorMath::MatrixVectorProduct()`.
+constexpr int PaddedGruSize(int output_size) {
+  return RoundUp(output_size, 8);
+}
+
+// Widens the tensor `tensor_src` to int16 and re-arranges the gates in
+// [`first_gate`, `first_gate + num_gates`) as required by
+// `VectorMath::MatrixVectorProduct()`. The rows are padded to an even number
+// and the units of each gate to `PaddedGruSize()` with zeros.
+std::vector<int16_t> PackGruTensor(rtc::ArrayView<const int8_t> tensor_src,
+                                   int output_size,
+                                   int first_gate,
+                                   int num_gates) {
+  // `n` is the size of the first dimension of the 3-dim tensor `weights`.
+  const int n = rtc::CheckedDivExact(rtc::dchecked_cast<int>(tensor_src.size()),
+                                     output_size * kNumGruGates);
+  const int stride_src = kNumGruGates * output_size;
+  const int padded_output_size = PaddedGruSize(output_size);
+  const int num_columns = num_gates * padded_output_size;
+  std::vector<int16_t> tensor_dst(RoundUp(n, 2) * num_columns, 0);
+  for (int i = 0; i < n; ++i) {
+    for (int g = 0; g < num_gates; ++g) {
+      for (int o = 0; o < output_size; ++o) {
+        const int j = g * padded_output_size + o;
+        tensor_dst[(i / 2) * 2 * num_columns + 2 * j + i % 2] =
+            tensor_src[i * stride_src + (first_gate + g) * output_size + o];
       }
     }
   }
   return tensor_dst;
 }
 
+// Largest magnitude of the GRU input values when the int8 path is used. It is
+// the range of the tansig activation of the layer that feeds the GRU.
+constexpr float kInt8InputMaxAbs = 1.f;
+
+// Rounds `x`, which must be in [-127, 127], to the nearest integer with
+// halfway cases away from zero. Unlike `std::lrint()`, it does not depend on
+// the rounding mode and is vectorized.
+int16_t RoundToInt8(float x) {
+  return static_cast<int16_t>(x + (x < 0.f ? -0.5f : 0.5f));
+}
+
 // Computes the output for the update or the reset gate.
 // Operation: `g = sigmoid(W^T∙i + R^T∙s + b)` where
 // - `g`: output gate vector
@@ -128,23 +193,53 @@ GatedRecurrentLayer::GatedRecurrentLayer(
     const rtc::ArrayView<const int8_t> weights,
     const rtc::ArrayView<const int8_t> recurrent_weights,
     const AvailableCpuFeatures& cpu_features,
-    absl::string_view layer_name)
+    absl::string_view layer_name,
+    GruPrecision precision)
     : input_size_(input_size),
       output_size_(output_size),
+      precision_(precision),
       bias_(PreprocessGruTensor(bias, output_size)),
-      weights_(PreprocessGruTensor(weights, output_size)),
-      recurrent_weights_(PreprocessGruTensor(recurrent_weights, output_size)),
+      weights_(precision == GruPrecision::kFloat
+                   ? PreprocessGruTensor(weights, output_size)
+                   : std::vector<float>()),
+      recurrent_weights_(
+          precision == GruPrecision::kFloat
+              ? PreprocessGruTensor(recurrent_weights, output_size)
+              : std::vector<float>()),
+      weights_quantized_(precision == GruPrecision::kInt8
+                             ? PackGruTensor(weights,
+                                             output_size,
+                                             /*first_gate=*/0,
+                                             /*num_gates=*/kNumGruGates)
+                             : std::vector<int16_t>()),
+      update_reset_recurrent_weights_quantized_(
+          precision == GruPrecision::kInt8
+              ? PackGruTensor(recurrent_weights,
+                              output_size,
+                              /*first_gate=*/0,
+                              /*num_gates=*/2)
+              : std::vector<int16_t>()),
+      state_recurrent_weights_quantized_(
+          precision == GruPrecision::kInt8
+              ? PackGruTensor(recurrent_weights,
+                              output_size,
+                              /*first_gate=*/2,
+                              /*num_gates=*/1)
+              : std::vector<int16_t>()),
+      quantized_input_(precision == GruPrecision::kInt8 ? RoundUp(input_size, 2)
+                                                        : 0,
+                       0),
       vector_math_(cpu_features) {
   RTC_DCHECK_LE(output_size_, kGruLayerMaxUnits)
       << "Insufficient GRU layer over-allocation (" << layer_name << ").";
   RTC_DCHECK_EQ(kNumGruGates * output_size_, bias_.size())
       << "Mismatching output size and bias terms array size (" << layer_name
       << ").";
-  RTC_DCHECK_EQ(kNumGruGates * input_size_ * output_size_, weights_.size())
+  RTC_DCHECK_EQ(kNumGruGates * input_size_ * output_size_, weights.size())
       << "Mismatching input-output size and weight coefficients array size ("
       << layer_name << ").";
   RTC_DCHECK_EQ(kNumGruGates * output_size_ * output_size_,
-                recurrent_weights_.size())
+                recurrent_weights.size())
       << "Mismatching input-output size and recurrent weight coefficients array"
          " size ("
       << layer_name << ").";
@@ -155,10 +250,16 @@ GatedRecurrentLayer::~GatedRecurrentLayer() = default;
 
 void GatedRecurrentLayer::Reset() {
   state_.fill(0.f);
+  quantized_state_.fill(0);
+  state_scale_ = 0.f;
 }
 
 void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input) {
   RTC_DCHECK_EQ(input.size(), input_size_);
+  if (precision_ == GruPrecision::kInt8) {
+    ComputeOutputInt8(input);
+    return;
+  }
 
   // The tensors below are organized as a sequence of flattened tensors for the
   // `update`, `reset` and `state` gates.
@@ -194,5 +295,80 @@ void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input) {
                    state);
 }
 
+void GatedRecurrentLayer::ComputeOutputInt8(
+    rtc::ArrayView<const float> input) {
+  // Same operations as in `ComputeUpdateResetGate()` and `ComputeStateGate()`
+  // with the products computed on quantized vectors for all the units at once.
+  // The weight scale is folded into the vector scales. The input scale is
+  // fixed and the state is quantized when it is computed, so that no vector is
+  // scanned for its range.
+  constexpr float kInputInverseScale = 127.f / kInt8InputMaxAbs;
+  constexpr float kInputScale =
+      ::rnnoise::kWeightsScale * kInt8InputMaxAbs / 127.f;
+  for (int i = 0; i < input_size_; ++i) {
+    const float x = kInputInverseScale * input[i];
+    quantized_input_[i] = RoundToInt8(std::min(127.f, std::max(-127.f, x)));
+  }
+  const int padded_output_size = PaddedGruSize(output_size_);
+  const size_t num_state_rows = RoundUp(output_size_, 2);
+
+  // `W^T∙i` for the three gates and `R^T∙s` for the update and reset gates.
+  std::array<int32_t, kNumGruGates * kGruLayerMaxUnits> input_products;
+  vector_math_.MatrixVectorProduct(
+      quantized_input_, weights_quantized_,
+      {input_products.data(),
+       static_cast<size_t>(kNumGruGates * padded_output_size)});
+  std::array<int32_t, 2 * kGruLayerMaxUnits> state_products;
+  vector_math_.MatrixVectorProduct(
+      {quantized_state_.data(), num_state_rows},
+      update_reset_recurrent_weights_quantized_,
+      {state_products.data(), static_cast<size_t>(2 * padded_output_size)});
+
+  // Update and reset gates. Since the reset gate is in [0, 1], `r .* s` is
+  // quantized with the scale of the state.
+  const float state_inverse_scale =
+      state_scale_ > 0.f ? ::rnnoise::kWeightsScale / state_scale_ : 0.f;
+  std::array<float, kGruLayerMaxUnits> update;
+  std::array<int16_t, kGruLayerMaxUnits> quantized_reset_x_state;
+  quantized_reset_x_state[num_state_rows - 1] = 0;
+  for (int o = 0; o < output_size_; ++o) {
+    update[o] = ::rnnoise::SigmoidApproximated(
+        bias_[o] + kInputScale * input_products[o] +
+        state_scale_ * state_products[o]);
+    const float reset = ::rnnoise::SigmoidApproximated(
+        bias_[output_size_ + o] +
+        kInputScale * input_products[padded_output_size + o] +
+        state_scale_ * state_products[padded_output_size + o]);
+    quantized_reset_x_state[o] =
+        RoundToInt8(state_inverse_scale * reset * state_[o]);
+  }
+
+  // State gate. The state is never negative, so its largest value sets the
+  // scale used to quantize it for the next call.
+  vector_math_.MatrixVectorProduct(
+      {quantized_reset_x_state.data(), num_state_rows},
+      state_recurrent_weights_quantized_,
+      {state_products.data(), static_cast<size_t>(padded_output_size)});
+  rtc::ArrayView<float> state(state_.data(), output_size_);
+  float max_state = 0.f;
+  for (int o = 0; o < output_size_; ++o) {
+    const float x = bias_[2 * output_size_ + o] +
+                    kInputScale * input_products[2 * padded_output_size + o] +
+                    state_scale_ * state_products[o];
+    state[o] = update[o] * state[o] + (1.f - update[o]) * std::max(0.f, x);
+    max_state = std::max(max_state, state[o]);
+  }
+  if (max_state == 0.f) {
+    quantized_state_.fill(0);
+    state_scale_ = 0.f;
+    return;
+  }
+  const float inverse_scale = 127.f / max_state;
+  for (int o = 0; o < output_size_; ++o) {
+    quantized_state_[o] = RoundToInt8(inverse_scale * state[o]);
+  }
+  state_scale_ = ::rnnoise::kWeightsScale * max_state / 127.f;
+}
+
 }  // namespace rnn_vad
 }  // namespace webrtc
@@ -25,6 +25,17 @@ namespace rnn_vad {
 // Maximum number of units for a GRU layer.
 constexpr int kGruLayerMaxUnits = 24;
 
+// Numeric precision used to compute the output of a GRU layer.
+enum class GruPrecision {
+  kFloat,
+  // The int8 weights are used as they are and the input and state vectors are
+  // quantized to int8. The input is expected in [-1, 1], the range of the
+  // tansig activation, and larger values saturate. The state is quantized
+  // with the scale of its largest value. The products are accumulated in
+  // int32.
+  kInt8,
+};
+
 // Recurrent layer with gated recurrent units (GRUs) with sigmoid and ReLU as
 // activation functions for the update/reset and output gates respectively.
 class GatedRecurrentLayer {
@@ -36,7 +47,8 @@ class GatedRecurrentLayer {
                       rtc::ArrayView<const int8_t> weights,
                       rtc::ArrayView<const int8_t> recurrent_weights,
                       const AvailableCpuFeatures& cpu_features,
-                      absl::string_view layer_name);
+                      absl::string_view layer_name,
+                      GruPrecision precision = GruPrecision::kFloat);
   GatedRecurrentLayer(const GatedRecurrentLayer&) = delete;
   GatedRecurrentLayer& operator=(const GatedRecurrentLayer&) = delete;
   ~GatedRecurrentLayer();
@@ -54,14 +66,28 @@ class GatedRecurrentLayer {
   void ComputeOutput(rtc::ArrayView<const float> input);
 
  private:
+  void ComputeOutputInt8(rtc::ArrayView<const float> input);
+
   const int input_size_;
   const int output_size_;
+  const GruPrecision precision_;
   const std::vector<float> bias_;
+  // Only set with `GruPrecision::kFloat`.
   const std::vector<float> weights_;
   const std::vector<float> recurrent_weights_;
+  // Only set with `GruPrecision::kInt8`. The int8 weights widened to int16
+  // and packed for `VectorMath::MatrixVectorProduct()`.
+  const std::vector<int16_t> weights_quantized_;
+  const std::vector<int16_t> update_reset_recurrent_weights_quantized_;
+  const std::vector<int16_t> state_recurrent_weights_quantized_;
+  std::vector<int16_t> quantized_input_;
   const VectorMath vector_math_;
   // Over-allocated array with size equal to `output_size_`.
   std::array<float, kGruLayerMaxUnits> state_;
+  // Only used with `GruPrecision::kInt8`. `state_` quantized when computed,
+  // and the scale that includes the weight scale.
+  std::array<int16_t, kGruLayerMaxUnits> quantized_state_;
+  float state_scale_;
 };
 
 }  // namespace rnn_vad
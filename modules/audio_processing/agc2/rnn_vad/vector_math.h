@@ -21,6 +21,9 @@
 #include <emmintrin.h>
 #endif
 
+#include <stdint.h>
+#include <string.h>
+
 #include <numeric>
 
 #include "api/array_view.h"
@@ -101,9 +104,74 @@ class VectorMath {
     return std::inner_product(x.begin(), x.end(), y.begin(), 0.f);
   }
 
+  // Computes `y = W^T∙x`, where the matrix `W` has `x.size()` rows and
+  // `y.size()` columns and is stored by pairs of rows, with the two elements
+  // of a pair next to each other: the element at row `i` and column `j` is
+  // `w[(i / 2) * 2 * y.size() + 2 * j + i % 2]`. The sizes of `x` and `y` must
+  // be multiples of 2 and 8 respectively. The values are expected to be in
+  // the int8 range, so that the products never overflow.
+  void MatrixVectorProduct(rtc::ArrayView<const int16_t> x,
+                           rtc::ArrayView<const int16_t> w,
+                           rtc::ArrayView<int32_t> y) const {
+    RTC_DCHECK_EQ(x.size() % 2, 0);
+    RTC_DCHECK_EQ(y.size() % 8, 0);
+    RTC_DCHECK_EQ(w.size(), x.size() * y.size());
+    const int num_pairs = rtc::dchecked_cast<int>(x.size()) / 2;
+    const int num_columns = rtc::dchecked_cast<int>(y.size());
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (cpu_features_.avx2) {
+      MatrixVectorProductAvx2(x, w, y);
+      return;
+    } else if (cpu_features_.sse2) {
+      constexpr int kBlockSize = 4;
+      for (int j = 0; j < num_columns; j += kBlockSize) {
+        __m128i accumulator = _mm_setzero_si128();
+        for (int k = 0; k < num_pairs; ++k) {
+          // Multiply the pairs of rows by the pair of elements of `x` and
+          // add the two products of each column.
+          int32_t x_k;
+          memcpy(&x_k, &x[2 * k], sizeof(x_k));
+          const __m128i w_k = _mm_loadu_si128(
+              reinterpret_cast<const __m128i*>(&w[2 * (k * num_columns + j)]));
+          accumulator = _mm_add_epi32(accumulator,
+                                      _mm_madd_epi16(w_k, _mm_set1_epi32(x_k)));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&y[j]), accumulator);
+      }
+      return;
+    }
+#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+    if (cpu_features_.neon) {
+      constexpr int kBlockSize = 4;
+      for (int j = 0; j < num_columns; j += kBlockSize) {
+        int32x4_t accumulator = vdupq_n_s32(0);
+        for (int k = 0; k < num_pairs; ++k) {
+          // De-interleave the pairs of rows.
+          const int16x4x2_t w_k = vld2_s16(&w[2 * (k * num_columns + j)]);
+          accumulator = vmlal_n_s16(accumulator, w_k.val[0], x[2 * k]);
+          accumulator = vmlal_n_s16(accumulator, w_k.val[1], x[2 * k + 1]);
+        }
+        vst1q_s32(&y[j], accumulator);
+      }
+      return;
+    }
+#endif
+    for (int j = 0; j < num_columns; ++j) {
+      int32_t sum = 0;
+      for (int k = 0; k < num_pairs; ++k) {
+        const int16_t* w_k = &w[2 * (k * num_columns + j)];
+        sum += x[2 * k] * w_k[0] + x[2 * k + 1] * w_k[1];
+      }
+      y[j] = sum;
+    }
+  }
+
  private:
   float DotProductAvx2(rtc::ArrayView<const float> x,
                        rtc::ArrayView<const float> y) const;
+  void MatrixVectorProductAvx2(rtc::ArrayView<const int16_t> x,
+                               rtc::ArrayView<const int16_t> w,
+                               rtc::ArrayView<int32_t> y) const;
 
   const AvailableCpuFeatures cpu_features_;
 };
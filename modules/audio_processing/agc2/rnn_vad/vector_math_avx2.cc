@@ -11,6 +11,7 @@
 #include "modules/audio_processing/agc2/rnn_vad/vector_math.h"
 
 #include <immintrin.h>
+#include <string.h>
 
 #include "api/array_view.h"
 #include "rtc_base/checks.h"
@@ -51,5 +52,30 @@ float VectorMath::DotProductAvx2(rtc::ArrayView<const float> x,
   return dot_product;
 }
 
+void VectorMath::MatrixVectorProductAvx2(rtc::ArrayView<const int16_t> x,
+                                         rtc::ArrayView<const int16_t> w,
+                                         rtc::ArrayView<int32_t> y) const {
+  RTC_DCHECK(cpu_features_.avx2);
+  RTC_DCHECK_EQ(w.size(), x.size() * y.size());
+  const int num_pairs = rtc::dchecked_cast<int>(x.size()) / 2;
+  const int num_columns = rtc::dchecked_cast<int>(y.size());
+  constexpr int kBlockSize = 8;
+  for (int j = 0; j < num_columns; j += kBlockSize) {
+    RTC_DCHECK_LE(j + kBlockSize, num_columns);
+    __m256i accumulator = _mm256_setzero_si256();
+    for (int k = 0; k < num_pairs; ++k) {
+      // Multiply the pairs of rows by the pair of elements of `x` and add the
+      // two products of each column.
+      int32_t x_k;
+      memcpy(&x_k, &x[2 * k], sizeof(x_k));
+      const __m256i w_k = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(&w[2 * (k * num_columns + j)]));
+      accumulator = _mm256_add_epi32(
+          accumulator, _mm256_madd_epi16(w_k, _mm256_set1_epi32(x_k)));
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&y[j]), accumulator);
+  }
+}
+
 }  // namespace rnn_vad
 }  // namespace webrtc
@@ -41,6 +41,35 @@ TEST_P(VectorMathParametrization, TestDotProduct) {
       kEnergyOfXSubspan);
 }
 
+TEST_P(VectorMathParametrization, TestMatrixVectorProduct) {
+  VectorMath vector_math(/*cpu_features=*/GetParam());
+  // Sizes covering one and several blocks of the optimized implementations
+  // and the extreme int8 values.
+  for (int num_rows : {2, 6, 24, 42}) {
+    for (int num_columns : {8, 16, 24, 72}) {
+      SCOPED_TRACE(num_rows);
+      SCOPED_TRACE(num_columns);
+      std::vector<int16_t> x(num_rows);
+      for (int i = 0; i < num_rows; ++i) {
+        x[i] = (i * 37) % 255 - 127;
+      }
+      x[0] = -128;
+      std::vector<int16_t> w(num_rows * num_columns);
+      std::vector<int32_t> expected(num_columns, 0);
+      for (int i = 0; i < num_rows; ++i) {
+        for (int j = 0; j < num_columns; ++j) {
+          const int16_t w_ij = (i * 59 + j * 31) % 256 - 128;
+          w[(i / 2) * 2 * num_columns + 2 * j + i % 2] = w_ij;
+          expected[j] += x[i] * w_ij;
+        }
+      }
+      std::vector<int32_t> y(num_columns);
+      vector_math.MatrixVectorProduct(x, w, y);
+      EXPECT_EQ(y, expected);
+    }
+  }
+}
+
 // Finds the relevant CPU features combinations to test.
 std::vector<AvailableCpuFeatures> GetCpuFeaturesToTest() {
   std::vector<AvailableCpuFeatures> v;
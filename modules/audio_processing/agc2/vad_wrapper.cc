@@ -20,6 +20,7 @@
 #include "modules/audio_processing/agc2/rnn_vad/features_extraction.h"
 #include "modules/audio_processing/agc2/rnn_vad/rnn.h"
 #include "rtc_base/checks.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 namespace {
@@ -29,7 +30,11 @@ constexpr int kNumFramesPerSecond = 100;
 class MonoVadImpl : public VoiceActivityDetectorWrapper::MonoVad {
  public:
   explicit MonoVadImpl(const AvailableCpuFeatures& cpu_features)
-      : features_extractor_(cpu_features), rnn_vad_(cpu_features) {}
+      : features_extractor_(cpu_features),
+        rnn_vad_(cpu_features,
+                 field_trial::IsEnabled("WebRTC-Agc2RnnVadInt8")
+                     ? rnn_vad::GruPrecision::kInt8
+                     : rnn_vad::GruPrecision::kFloat) {}
   MonoVadImpl(const MonoVadImpl&) = delete;
   MonoVadImpl& operator=(const MonoVadImpl&) = delete;
   ~MonoVadImpl() = default;
@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/batch_audio_processor.h"
+
+#include <algorithm>
+
+#include "modules/audio_processing/agc2/vad_wrapper.h"
+#include "modules/audio_processing/audio_buffer.h"
+#include "modules/audio_processing/gain_controller2.h"
+#include "modules/audio_processing/include/audio_frame_view.h"
+#include "modules/audio_processing/ns/noise_suppressor.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+class BatchAudioProcessor::Stream {
+ public:
+  explicit Stream(const Config& config)
+      : audio_(config.sample_rate_hz,
+               config.num_channels,
+               config.sample_rate_hz,
+               config.num_channels,
+               config.sample_rate_hz,
+               config.num_channels),
+        split_bands_(
+            config.sample_rate_hz == AudioProcessing::kSampleRate32kHz ||
+            config.sample_rate_hz == AudioProcessing::kSampleRate48kHz) {
+    if (config.noise_suppression.enabled) {
+      NsConfig ns_config;
+      ns_config.target_level = config.noise_suppression.level;
+      noise_suppressor_ = std::make_unique<NoiseSuppressor>(
+          ns_config, config.sample_rate_hz, config.num_channels);
+    }
+    if (config.gain_controller2.enabled) {
+      gain_controller_ = std::make_unique<GainController2>(
+          config.gain_controller2, config.sample_rate_hz,
+          static_cast<int>(config.num_channels),
+          /*use_internal_vad=*/false);
+      if (config.gain_controller2.adaptive_digital.enabled) {
+        vad_ = std::make_unique<VoiceActivityDetectorWrapper>(
+            config.gain_controller2.adaptive_digital.vad_reset_period_ms,
+            gain_controller_->GetCpuFeatures(), config.sample_rate_hz);
+      }
+    }
+  }
+
+  void Process(const StreamConfig& stream_config, Frame& frame) {
+    audio_.CopyFrom(frame.data, stream_config);
+    if (noise_suppressor_) {
+      if (split_bands_) {
+        audio_.SplitIntoFrequencyBands();
+      }
+      noise_suppressor_->Analyze(audio_);
+      noise_suppressor_->Process(&audio_);
+      if (split_bands_) {
+        audio_.MergeFrequencyBands();
+      }
+    }
+    frame.speech_probability.reset();
+    if (vad_) {
+      frame.speech_probability = vad_->Analyze(AudioFrameView<const float>(
+          audio_.channels(), audio_.num_channels(), audio_.num_frames()));
+    }
+    if (gain_controller_) {
+      gain_controller_->Process(frame.speech_probability, &audio_);
+    }
+    audio_.CopyTo(stream_config, frame.data);
+  }
+
+ private:
+  AudioBuffer audio_;
+  const bool split_bands_;
+  std::unique_ptr<NoiseSuppressor> noise_suppressor_;
+  std::unique_ptr<GainController2> gain_controller_;
+  std::unique_ptr<VoiceActivityDetectorWrapper> vad_;
+};
+
+BatchAudioProcessor::BatchAudioProcessor(const Config& config,
+                                         TaskQueueFactory* task_queue_factory,
+                                         int num_workers)
+    : config_(config),
+      stream_config_(config.sample_rate_hz, config.num_channels),
+      workers_(task_queue_factory, "BatchApmWorker", num_workers) {
+  RTC_DCHECK(config.sample_rate_hz == AudioProcessing::kSampleRate8kHz ||
+             config.sample_rate_hz == AudioProcessing::kSampleRate16kHz ||
+             config.sample_rate_hz == AudioProcessing::kSampleRate32kHz ||
+             config.sample_rate_hz == AudioProcessing::kSampleRate48kHz);
+  RTC_DCHECK_GT(config.num_channels, 0);
+  RTC_DCHECK(!config.gain_controller2.enabled ||
+             GainController2::Validate(config.gain_controller2));
+}
+
+BatchAudioProcessor::~BatchAudioProcessor() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+}
+
+BatchAudioProcessor::Stream* BatchAudioProcessor::AddStream() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  streams_.push_back(std::make_unique<Stream>(config_));
+  return streams_.back().get();
+}
+
+void BatchAudioProcessor::RemoveStream(Stream* stream) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  auto it = std::find_if(
+      streams_.begin(), streams_.end(),
+      [stream](const std::unique_ptr<Stream>& s) { return s.get() == stream; });
+  RTC_DCHECK(it != streams_.end());
+  if (it != streams_.end()) {
+    std::swap(*it, streams_.back());
+    streams_.pop_back();
+  }
+}
+
+size_t BatchAudioProcessor::num_streams() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return streams_.size();
+}
+
+void BatchAudioProcessor::Process(rtc::ArrayView<Frame> frames) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  workers_.ProcessRanges(frames.size(),
+                         [&](size_t /* worker */, size_t begin, size_t end) {
+                           ProcessFrames(frames.subview(begin, end - begin));
+                         });
+}
+
+void BatchAudioProcessor::ProcessFrames(rtc::ArrayView<Frame> frames) {
+  for (Frame& frame : frames) {
+    RTC_DCHECK(frame.stream);
+    RTC_DCHECK(frame.data);
+    frame.stream->Process(stream_config_, frame);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,146 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/batch_audio_processor.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kNumChannels = 2;
+constexpr size_t kFrameSize = kSampleRateHz / 100 * kNumChannels;
+constexpr int kNumStreams = 7;
+constexpr int kNumFrames = 50;
+
+BatchAudioProcessor::Config CreateConfig(bool adaptive_digital) {
+  BatchAudioProcessor::Config config;
+  config.sample_rate_hz = kSampleRateHz;
+  config.num_channels = kNumChannels;
+  config.gain_controller2.enabled = true;
+  config.gain_controller2.adaptive_digital.enabled = adaptive_digital;
+  return config;
+}
+
+// Runs `kNumFrames` frames of noise with a different level per stream through
+// `processor` and returns the concatenated output of each stream.
+std::vector<std::vector<int16_t>> ProcessNoise(BatchAudioProcessor& processor) {
+  std::vector<BatchAudioProcessor::Stream*> streams;
+  for (int i = 0; i < kNumStreams; ++i) {
+    streams.push_back(processor.AddStream());
+  }
+  Random random(42);
+  std::vector<std::vector<int16_t>> output(kNumStreams);
+  std::vector<std::vector<int16_t>> data(kNumStreams,
+                                         std::vector<int16_t>(kFrameSize));
+  std::vector<BatchAudioProcessor::Frame> frames(kNumStreams);
+  for (int n = 0; n < kNumFrames; ++n) {
+    for (int i = 0; i < kNumStreams; ++i) {
+      const int amplitude = 500 * (i + 1);
+      for (int16_t& sample : data[i]) {
+        sample = random.Rand(-amplitude, amplitude);
+      }
+      frames[i].stream = streams[i];
+      frames[i].data = data[i].data();
+    }
+    processor.Process(frames);
+    for (int i = 0; i < kNumStreams; ++i) {
+      output[i].insert(output[i].end(), data[i].begin(), data[i].end());
+    }
+  }
+  return output;
+}
+
+TEST(BatchAudioProcessorTest, WorkersProduceSameOutputAsCallingThread) {
+  std::unique_ptr<TaskQueueFactory> task_queue_factory =
+      CreateDefaultTaskQueueFactory();
+  BatchAudioProcessor inline_processor(CreateConfig(true),
+                                       task_queue_factory.get(),
+                                       /*num_workers=*/0);
+  BatchAudioProcessor parallel_processor(CreateConfig(true),
+                                         task_queue_factory.get(),
+                                         /*num_workers=*/3);
+  EXPECT_EQ(ProcessNoise(inline_processor), ProcessNoise(parallel_processor));
+}
+
+TEST(BatchAudioProcessorTest, StreamsAreIndependent) {
+  BatchAudioProcessor processor(CreateConfig(true), nullptr,
+                                /*num_workers=*/0);
+  std::vector<std::vector<int16_t>> output = ProcessNoise(processor);
+
+  // Processing a single stream on its own gives the same result as in a
+  // batch.
+  BatchAudioProcessor single_processor(CreateConfig(true), nullptr,
+                                       /*num_workers=*/0);
+  BatchAudioProcessor::Stream* stream = single_processor.AddStream();
+  Random random(42);
+  std::vector<int16_t> data(kFrameSize);
+  std::vector<int16_t> first_stream_output;
+  for (int n = 0; n < kNumFrames; ++n) {
+    // Draw the samples of all streams to keep the random sequence aligned.
+    for (int i = 0; i < kNumStreams; ++i) {
+      const int amplitude = 500 * (i + 1);
+      for (int16_t& sample : data) {
+        const int16_t value = random.Rand(-amplitude, amplitude);
+        if (i == 0) {
+          sample = value;
+        }
+      }
+    }
+    BatchAudioProcessor::Frame frame;
+    frame.stream = stream;
+    frame.data = data.data();
+    single_processor.Process(
+        rtc::ArrayView<BatchAudioProcessor::Frame>(&frame, 1));
+    first_stream_output.insert(first_stream_output.end(), data.begin(),
+                               data.end());
+  }
+  EXPECT_EQ(output[0], first_stream_output);
+}
+
+TEST(BatchAudioProcessorTest, SpeechProbabilityOnlyWithAdaptiveDigital) {
+  for (bool adaptive_digital : {false, true}) {
+    BatchAudioProcessor processor(CreateConfig(adaptive_digital), nullptr,
+                                  /*num_workers=*/0);
+    std::vector<int16_t> data(kFrameSize, 0);
+    BatchAudioProcessor::Frame frame;
+    frame.stream = processor.AddStream();
+    frame.data = data.data();
+    processor.Process(rtc::ArrayView<BatchAudioProcessor::Frame>(&frame, 1));
+    EXPECT_EQ(frame.speech_probability.has_value(), adaptive_digital);
+  }
+}
+
+TEST(BatchAudioProcessorTest, RemoveStream) {
+  BatchAudioProcessor processor(CreateConfig(false), nullptr,
+                                /*num_workers=*/0);
+  BatchAudioProcessor::Stream* first = processor.AddStream();
+  BatchAudioProcessor::Stream* second = processor.AddStream();
+  EXPECT_EQ(processor.num_streams(), 2u);
+  processor.RemoveStream(first);
+  EXPECT_EQ(processor.num_streams(), 1u);
+
+  std::vector<int16_t> data(kFrameSize, 100);
+  BatchAudioProcessor::Frame frame;
+  frame.stream = second;
+  frame.data = data.data();
+  processor.Process(rtc::ArrayView<BatchAudioProcessor::Frame>(&frame, 1));
+  processor.RemoveStream(second);
+  EXPECT_EQ(processor.num_streams(), 0u);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "benchmark/benchmark.h"
+#include "modules/audio_processing/batch_audio_processor.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/unused.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kSamplesPerFrame = kSampleRateHz / 100;
+
+// Processes one 10 ms mono frame for each of `state.range(0)` streams per
+// iteration, with noise suppression, VAD and the adaptive digital
+// GainController2 enabled, on `state.range(1)` workers.
+void BM_BatchAudioProcessor(benchmark::State& state) {
+  const int num_streams = state.range(0);
+  const int num_workers = state.range(1);
+  std::unique_ptr<TaskQueueFactory> task_queue_factory =
+      CreateDefaultTaskQueueFactory();
+  BatchAudioProcessor::Config config;
+  config.sample_rate_hz = kSampleRateHz;
+  config.gain_controller2.enabled = true;
+  config.gain_controller2.adaptive_digital.enabled = true;
+  BatchAudioProcessor processor(config, task_queue_factory.get(),
+                                num_workers);
+
+  Random random(42);
+  std::vector<std::vector<int16_t>> input(
+      num_streams, std::vector<int16_t>(kSamplesPerFrame));
+  for (std::vector<int16_t>& samples : input) {
+    for (int16_t& sample : samples) {
+      sample = random.Rand(-2000, 2000);
+    }
+  }
+  std::vector<std::vector<int16_t>> data = input;
+  std::vector<BatchAudioProcessor::Frame> frames(num_streams);
+  for (int i = 0; i < num_streams; ++i) {
+    frames[i].stream = processor.AddStream();
+    frames[i].data = data[i].data();
+  }
+
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    state.PauseTiming();
+    for (int i = 0; i < num_streams; ++i) {
+      data[i] = input[i];
+    }
+    state.ResumeTiming();
+    processor.Process(frames);
+  }
+  state.SetItemsProcessed(state.iterations() * num_streams);
+}
+
+BENCHMARK(BM_BatchAudioProcessor)
+    ->ArgsProduct({{1, 16, 128, 512}, {0, 4}})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace webrtc
@@ -122,6 +122,15 @@ void FrameDropper::Fill(size_t framesize_bytes, bool delta_frame) {
   CapAccumulator();
 }
 
+bool FrameDropper::WouldOverflow(size_t predicted_framesize_bytes) const {
+  if (!enabled_ || target_bitrate_ <= 0.0f) {
+    return false;
+  }
+  float framesize_kbits =
+      8.0f * static_cast<float>(predicted_framesize_bytes) / 1000.0f;
+  return accumulator_ + framesize_kbits > accumulator_max_;
+}
+
 void FrameDropper::Leak(uint32_t input_framerate) {
   if (!enabled_) {
     return;
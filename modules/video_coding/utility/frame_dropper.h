@@ -47,6 +47,11 @@ class FrameDropper {
   //          - delta_frame        : True if the encoder returned a delta frame.
   void Fill(size_t framesize_bytes, bool delta_frame);
 
+  // Returns true if adding a frame of the given predicted size would push the
+  // leaky bucket above its max level, i.e. if encoding it is likely to cause
+  // subsequent frames to be dropped. Does not change the state.
+  bool WouldOverflow(size_t predicted_framesize_bytes) const;
+
   void Leak(uint32_t input_framerate);
 
   // Sets the target bit rate and the frame rate produced by the camera.
@@ -148,6 +148,15 @@ TEST_F(FrameDropperTest, LargeDeltaFrames) {
   ValidateNoDropsAtTargetBitrate(kLargeFrameSizeBytes / 8, 8, true);
 }
 
+TEST_F(FrameDropperTest, PredictsOverflowFromFrameSize) {
+  EXPECT_FALSE(frame_dropper_.WouldOverflow(kFrameSizeBytes));
+  EXPECT_TRUE(frame_dropper_.WouldOverflow(kLargeFrameSizeBytes));
+  OverflowLeakyBucket();
+  EXPECT_TRUE(frame_dropper_.WouldOverflow(kFrameSizeBytes));
+  frame_dropper_.Enable(false);
+  EXPECT_FALSE(frame_dropper_.WouldOverflow(kLargeFrameSizeBytes));
+}
+
 TEST_F(FrameDropperTest, TrafficVolumeAboveAvailableBandwidth) {
   ValidateThroughputMatchesTargetBitrate(700, kIncludeKeyFrame);
   ValidateThroughputMatchesTargetBitrate(700, kDoNotIncludeKeyFrame);
@@ -67,6 +67,7 @@ BasicIceController::~BasicIceController() {}
 
 void BasicIceController::SetIceConfig(const IceConfig& config) {
   config_ = config;
+  rerank_all_ = true;
 }
 
 void BasicIceController::SetSelectedConnection(
@@ -76,13 +77,16 @@ void BasicIceController::SetSelectedConnection(
 
 void BasicIceController::AddConnection(const Connection* connection) {
   connections_.push_back(connection);
+  ranking_states_.push_back(absl::nullopt);
   unpinged_connections_.insert(connection);
 }
 
 void BasicIceController::OnConnectionDestroyed(const Connection* connection) {
   pinged_connections_.erase(connection);
   unpinged_connections_.erase(connection);
-  connections_.erase(absl::c_find(connections_, connection));
+  auto it = absl::c_find(connections_, connection);
+  ranking_states_.erase(ranking_states_.begin() + (it - connections_.begin()));
+  connections_.erase(it);
   if (selected_connection_ == connection)
     selected_connection_ = nullptr;
 }
@@ -528,16 +532,7 @@ BasicIceController::SortAndSwitchConnection(IceSwitchReason reason) {
   // that amongst equal preference, writable connections, this will choose the
   // one whose estimated latency is lowest.  So it is the only one that we
   // need to consider switching to.
-  // TODO(honghaiz): Don't sort;  Just use std::max_element in the right places.
-  absl::c_stable_sort(
-      connections_, [this](const Connection* a, const Connection* b) {
-        int cmp = CompareConnections(a, b, absl::nullopt, nullptr);
-        if (cmp != 0) {
-          return cmp > 0;
-        }
-        // Otherwise, sort based on latency estimate.
-        return a->rtt() < b->rtt();
-      });
+  RankConnections();
 
   RTC_LOG(LS_VERBOSE) << "Sorting " << connections_.size()
                       << " available connections";
@@ -551,6 +546,133 @@ BasicIceController::SortAndSwitchConnection(IceSwitchReason reason) {
   return ShouldSwitchConnection(reason, top_connection);
 }
 
+bool BasicIceController::RankingState::operator==(
+    const RankingState& other) const {
+  return writable == other.writable && write_state == other.write_state &&
+         receiving == other.receiving && connected == other.connected &&
+         remote_nomination == other.remote_nomination &&
+         last_data_received == other.last_data_received && rtt == other.rtt &&
+         priority == other.priority && generation == other.generation &&
+         pruned == other.pruned && network_cost == other.network_cost &&
+         network_type == other.network_type && vpn == other.vpn;
+}
+
+BasicIceController::RankingState BasicIceController::GetRankingState(
+    const Connection* conn) const {
+  return {conn->writable() || PresumedWritable(conn),
+          conn->write_state(),
+          conn->receiving(),
+          conn->connected(),
+          conn->remote_nomination(),
+          conn->last_data_received(),
+          conn->rtt(),
+          conn->priority(),
+          conn->remote_candidate().generation() + conn->generation(),
+          is_connection_pruned_func_(conn),
+          conn->ComputeNetworkCost(),
+          conn->network()->type(),
+          conn->network()->IsVpn()};
+}
+
+bool BasicIceController::RanksBefore(const Connection* a,
+                                     const Connection* b) const {
+  int cmp = CompareConnections(a, b, absl::nullopt, nullptr);
+  if (cmp != 0) {
+    return cmp > 0;
+  }
+  // Otherwise, sort based on latency estimate.
+  return a->rtt() < b->rtt();
+}
+
+void BasicIceController::RankConnections() {
+  const IceRole ice_role = ice_role_func_();
+  if (ice_role != ranked_ice_role_) {
+    ranked_ice_role_ = ice_role;
+    rerank_all_ = true;
+  }
+
+  // Comparing the cached states is much cheaper than comparing connections,
+  // so all of them are checked for changes.
+  std::vector<size_t> changed;
+  for (size_t i = 0; i < connections_.size(); ++i) {
+    RankingState state = GetRankingState(connections_[i]);
+    if (ranking_states_[i] != state) {
+      ranking_states_[i] = state;
+      changed.push_back(i);
+    }
+  }
+
+  const auto ranks_before = [this](const Connection* a, const Connection* b) {
+    return RanksBefore(a, b);
+  };
+  if (rerank_all_ || 4 * changed.size() > connections_.size()) {
+    rerank_all_ = false;
+    std::vector<size_t> order(connections_.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+      order[i] = i;
+    }
+    absl::c_stable_sort(order, [&](size_t a, size_t b) {
+      return ranks_before(connections_[a], connections_[b]);
+    });
+    std::vector<const Connection*> connections;
+    std::vector<absl::optional<RankingState>> ranking_states;
+    connections.reserve(order.size());
+    ranking_states.reserve(order.size());
+    for (size_t i : order) {
+      connections.push_back(connections_[i]);
+      ranking_states.push_back(ranking_states_[i]);
+    }
+    connections_ = std::move(connections);
+    ranking_states_ = std::move(ranking_states);
+    return;
+  }
+  if (changed.empty()) {
+    return;
+  }
+
+  // Take out the changed connections. The others are still sorted.
+  struct Moved {
+    const Connection* connection;
+    absl::optional<RankingState> ranking_state;
+    size_t old_index;
+  };
+  std::vector<Moved> moved;
+  moved.reserve(changed.size());
+  // The previous index of each connection left in `connections_`.
+  std::vector<size_t> old_indices;
+  old_indices.reserve(connections_.size());
+  size_t kept = 0;
+  for (size_t i = 0, next = 0; i < connections_.size(); ++i) {
+    if (next < changed.size() && changed[next] == i) {
+      moved.push_back({connections_[i], ranking_states_[i], i});
+      ++next;
+      continue;
+    }
+    connections_[kept] = connections_[i];
+    ranking_states_[kept] = ranking_states_[i];
+    old_indices.push_back(i);
+    ++kept;
+  }
+  connections_.resize(kept);
+  ranking_states_.resize(kept);
+
+  // Put them back in place. Among equally ranked connections, the previous
+  // order is kept, like a stable sort does.
+  for (const Moved& m : moved) {
+    auto range =
+        std::equal_range(connections_.begin(), connections_.end(),
+                         m.connection, ranks_before);
+    size_t index = range.first - connections_.begin();
+    const size_t end = range.second - connections_.begin();
+    while (index < end && old_indices[index] < m.old_index) {
+      ++index;
+    }
+    connections_.insert(connections_.begin() + index, m.connection);
+    ranking_states_.insert(ranking_states_.begin() + index, m.ranking_state);
+    old_indices.insert(old_indices.begin() + index, m.old_index);
+  }
+}
+
 bool BasicIceController::ReadyToSend(const Connection* connection) const {
   // Note that we allow sending on an unreliable connection, because it's
   // possible that it became unreliable simply due to bad chance.
@@ -17,6 +17,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "p2p/base/ice_controller_factory_interface.h"
 #include "p2p/base/ice_controller_interface.h"
 #include "p2p/base/p2p_transport_channel.h"
@@ -139,6 +140,37 @@ class BasicIceController : public IceControllerInterface {
   SwitchResult HandleInitialSelectDampening(IceSwitchReason reason,
                                             const Connection* new_connection);
 
+  // The state of a connection that its rank depends on, besides the config
+  // and the ICE role.
+  struct RankingState {
+    bool writable;
+    Connection::WriteState write_state;
+    bool receiving;
+    bool connected;
+    uint32_t remote_nomination;
+    int64_t last_data_received;
+    int rtt;
+    uint64_t priority;
+    uint32_t generation;
+    bool pruned;
+    uint32_t network_cost;
+    rtc::AdapterType network_type;
+    bool vpn;
+
+    bool operator==(const RankingState& other) const;
+    bool operator!=(const RankingState& other) const {
+      return !(*this == other);
+    }
+  };
+
+  RankingState GetRankingState(const Connection* conn) const;
+  // Returns true if `a` ranks before `b`.
+  bool RanksBefore(const Connection* a, const Connection* b) const;
+  // Sorts `connections_`, with the same result as a stable sort of their
+  // previous order. Only the connections whose ranking state changed since
+  // the last call are moved, unless too many of them changed.
+  void RankConnections();
+
   std::function<IceTransportState()> ice_transport_state_func_;
   std::function<IceRole()> ice_role_func_;
   std::function<bool(const Connection*)> is_connection_pruned_func_;
@@ -153,6 +185,12 @@ class BasicIceController : public IceControllerInterface {
   // connection should be pinged next or not.
   const Connection* selected_connection_ = nullptr;
   std::vector<const Connection*> connections_;
+  // The state each connection of `connections_` was ranked with, in the same
+  // order. Not set for connections that were not ranked yet.
+  std::vector<absl::optional<RankingState>> ranking_states_;
+  // Set when all connections must be ranked again, e.g. after a config change.
+  bool rerank_all_ = true;
+  IceRole ranked_ice_role_ = ICEROLE_UNKNOWN;
   std::set<const Connection*> pinged_connections_;
   std::set<const Connection*> unpinged_connections_;
 
@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "p2p/base/basic_ice_controller.h"
+#include "p2p/base/basic_packet_socket_factory.h"
+#include "p2p/base/connection.h"
+#include "p2p/base/p2p_transport_channel_ice_field_trials.h"
+#include "p2p/base/stun_port.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/fake_clock.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/network.h"
+#include "rtc_base/random.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/system/unused.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/virtual_socket_server.h"
+
+namespace cricket {
+namespace {
+
+// Sorts `state.range(0)` candidate pairs after each ping response, which is
+// what P2PTransportChannel does while checks are in progress. Half of the
+// pairs are writable.
+void BM_BasicIceControllerSortAfterPingResponse(benchmark::State& state) {
+  const int num_connections = state.range(0);
+  rtc::ScopedFakeClock clock;
+  rtc::VirtualSocketServer vss;
+  rtc::AutoSocketServerThread thread(&vss);
+  rtc::BasicPacketSocketFactory socket_factory(&vss);
+  rtc::Network network("test", "Test network", rtc::IPAddress(INADDR_ANY),
+                       16);
+  network.AddIP(rtc::IPAddress(0x01010101));
+  std::unique_ptr<Port> port = UDPPort::Create(
+      &thread, &socket_factory, &network, 0, 0, "ufrag",
+      "password-of-22-characters", false, absl::nullopt);
+  RTC_CHECK(port);
+  port->SetIceRole(ICEROLE_CONTROLLING);
+  port->PrepareAddress();
+
+  webrtc::Random random(1234);
+  std::vector<Connection*> connections;
+  for (int i = 0; i < num_connections; ++i) {
+    Candidate remote;
+    remote.set_address(rtc::SocketAddress(0x02020000 + i, 5000));
+    remote.set_component(ICE_CANDIDATE_COMPONENT_RTP);
+    remote.set_protocol(UDP_PROTOCOL_NAME);
+    remote.set_priority(random.Rand(1000, 2000));
+    connections.push_back(
+        port->CreateConnection(remote, PortInterface::ORIGIN_MESSAGE));
+    if (i % 2 == 0) {
+      connections.back()->ReceivedPingResponse(random.Rand(10, 100), "id");
+    }
+  }
+
+  IceFieldTrials field_trials;
+  IceControllerFactoryArgs args;
+  args.ice_transport_state_func = [] { return IceTransportState::STATE_INIT; };
+  args.ice_role_func = [] { return ICEROLE_CONTROLLING; };
+  args.is_connection_pruned_func = [](const Connection*) { return false; };
+  args.ice_field_trials = &field_trials;
+  BasicIceController controller(args);
+  for (Connection* connection : connections) {
+    controller.AddConnection(connection);
+  }
+  controller.SortAndSwitchConnection(IceSwitchReason::CONNECT_STATE_CHANGE);
+
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    Connection* connection = connections[random.Rand(num_connections - 1)];
+    connection->ReceivedPingResponse(random.Rand(10, 100), "id");
+    benchmark::DoNotOptimize(controller.SortAndSwitchConnection(
+        IceSwitchReason::CONNECT_STATE_CHANGE));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_BasicIceControllerSortAfterPingResponse)
+    ->Arg(10)
+    ->Arg(50)
+    ->Arg(100)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace cricket
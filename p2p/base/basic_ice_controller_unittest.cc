@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/basic_ice_controller.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "p2p/base/basic_packet_socket_factory.h"
+#include "p2p/base/connection.h"
+#include "p2p/base/p2p_transport_channel_ice_field_trials.h"
+#include "p2p/base/stun_port.h"
+#include "rtc_base/fake_clock.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/network.h"
+#include "rtc_base/random.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/virtual_socket_server.h"
+#include "test/gtest.h"
+
+namespace cricket {
+namespace {
+
+constexpr int kNumConnections = 30;
+
+// Owns the connections that the ICE controllers rank, and lets the tests
+// change their state.
+class BasicIceControllerRankingTest : public ::testing::Test {
+ protected:
+  BasicIceControllerRankingTest()
+      : thread_(&vss_),
+        socket_factory_(&vss_),
+        network_("test", "Test network", rtc::IPAddress(INADDR_ANY), 16),
+        random_(1234) {
+    network_.AddIP(rtc::IPAddress(0x01010101));
+    port_ = UDPPort::Create(&thread_, &socket_factory_, &network_, 0, 0,
+                            "ufrag", "password-of-22-characters", false,
+                            absl::nullopt);
+    port_->SetIceRole(ICEROLE_CONTROLLING);
+    port_->PrepareAddress();
+    for (int i = 0; i < kNumConnections; ++i) {
+      Candidate remote;
+      remote.set_address(rtc::SocketAddress(0x02020200 + i, 5000));
+      remote.set_component(ICE_CANDIDATE_COMPONENT_RTP);
+      remote.set_protocol(UDP_PROTOCOL_NAME);
+      // Some connections have the same priority, to exercise the tie breaks.
+      remote.set_priority(1000 + random_.Rand(5));
+      connections_.push_back(
+          port_->CreateConnection(remote, PortInterface::ORIGIN_MESSAGE));
+    }
+  }
+
+  std::unique_ptr<BasicIceController> CreateController() {
+    IceControllerFactoryArgs args;
+    args.ice_transport_state_func = [] {
+      return IceTransportState::STATE_INIT;
+    };
+    args.ice_role_func = [this] { return ice_role_; };
+    args.is_connection_pruned_func = [](const Connection*) { return false; };
+    args.ice_field_trials = &field_trials_;
+    return std::make_unique<BasicIceController>(args);
+  }
+
+  // Changes the state of a random connection like ICE checks do.
+  void ChangeRandomConnection() {
+    clock_.AdvanceTime(webrtc::TimeDelta::Millis(10));
+    Connection* conn = connections_[random_.Rand(kNumConnections - 1)];
+    switch (random_.Rand(3)) {
+      case 0:
+        conn->ReceivedPingResponse(random_.Rand(1, 200), "id");
+        break;
+      case 1:
+        conn->set_remote_nomination(random_.Rand(2));
+        break;
+      case 2:
+        conn->ReceivedPing();
+        break;
+      case 3:
+        conn->Prune();
+        break;
+    }
+  }
+
+  rtc::ScopedFakeClock clock_;
+  rtc::VirtualSocketServer vss_;
+  rtc::AutoSocketServerThread thread_;
+  rtc::BasicPacketSocketFactory socket_factory_;
+  rtc::Network network_;
+  std::unique_ptr<Port> port_;
+  std::vector<Connection*> connections_;
+  webrtc::Random random_;
+  IceFieldTrials field_trials_;
+  IceRole ice_role_ = ICEROLE_CONTROLLING;
+};
+
+// The incrementally maintained ranking must match a stable sort of the
+// previous ranking, which a new controller does.
+TEST_F(BasicIceControllerRankingTest, IncrementalRankingMatchesFullSort) {
+  std::unique_ptr<BasicIceController> controller = CreateController();
+  for (Connection* conn : connections_) {
+    controller->AddConnection(conn);
+  }
+  controller->SortAndSwitchConnection(IceSwitchReason::CONNECT_STATE_CHANGE);
+
+  for (int round = 0; round < 200; ++round) {
+    std::vector<const Connection*> previous(controller->connections().begin(),
+                                            controller->connections().end());
+    for (int i = random_.Rand(1, 3); i > 0; --i) {
+      ChangeRandomConnection();
+    }
+    if (round % 50 == 49) {
+      ice_role_ = ice_role_ == ICEROLE_CONTROLLING ? ICEROLE_CONTROLLED
+                                                   : ICEROLE_CONTROLLING;
+    }
+    controller->SortAndSwitchConnection(IceSwitchReason::CONNECT_STATE_CHANGE);
+
+    std::unique_ptr<BasicIceController> reference = CreateController();
+    for (const Connection* conn : previous) {
+      reference->AddConnection(conn);
+    }
+    reference->SortAndSwitchConnection(IceSwitchReason::CONNECT_STATE_CHANGE);
+    ASSERT_EQ(std::vector<const Connection*>(reference->connections().begin(),
+                                             reference->connections().end()),
+              std::vector<const Connection*>(controller->connections().begin(),
+                                             controller->connections().end()))
+        << "Round " << round;
+  }
+}
+
+TEST_F(BasicIceControllerRankingTest, DestroyedConnectionIsRemoved) {
+  std::unique_ptr<BasicIceController> controller = CreateController();
+  for (Connection* conn : connections_) {
+    controller->AddConnection(conn);
+  }
+  controller->SortAndSwitchConnection(IceSwitchReason::CONNECT_STATE_CHANGE);
+  const Connection* removed = controller->connections()[3];
+  controller->OnConnectionDestroyed(removed);
+  connections_[0]->ReceivedPingResponse(10, "id");
+  controller->SortAndSwitchConnection(IceSwitchReason::CONNECT_STATE_CHANGE);
+  EXPECT_EQ(static_cast<size_t>(kNumConnections - 1),
+            controller->connections().size());
+  EXPECT_EQ(connections_[0], controller->connections()[0]);
+  for (const Connection* conn : controller->connections()) {
+    EXPECT_NE(removed, conn);
+  }
+}
+
+}  // namespace
+}  // namespace cricket
@@ -444,10 +444,19 @@ void Connection::OnReadPacket(const char* data,
                               size_t size,
                               int64_t packet_time_us) {
   RTC_DCHECK_RUN_ON(network_thread_);
+  // Connectivity checks are answered from the view when possible; the full
+  // parse below is only needed for other STUN messages and for requests that
+  // take more than a response.
+  StunMessageView view;
+  const bool maybe_stun = view.Parse(data, size);
+  if (maybe_stun && MaybeHandleStunRequestView(view)) {
+    return;
+  }
   std::unique_ptr<IceMessage> msg;
   std::string remote_ufrag;
   const rtc::SocketAddress& addr(remote_candidate_.address());
-  if (!port_->GetStunMessage(data, size, addr, &msg, &remote_ufrag)) {
+  if (!maybe_stun ||
+      !port_->GetStunMessage(view, addr, &msg, &remote_ufrag)) {
     // The packet did not parse as a valid STUN message
     // This is a data packet, pass it along.
     last_data_received_ = rtc::TimeMillis();
@@ -472,7 +481,13 @@ void Connection::OnReadPacket(const char* data,
     // If this is a STUN response, then update the writable bit.
     // Log at LS_INFO if we receive a ping on an unwritable connection.
     rtc::LoggingSeverity sev = (!writable() ? rtc::LS_INFO : rtc::LS_VERBOSE);
-    msg->ValidateMessageIntegrity(remote_candidate().password());
+    // Requests were authenticated with the local password by the port. Only
+    // responses are signed with the remote password.
+    if (IsStunSuccessResponseType(msg->type()) ||
+        IsStunErrorResponseType(msg->type())) {
+      remote_integrity_key_.SetPassword(remote_candidate().password());
+      msg->ValidateMessageIntegrity(remote_integrity_key_);
+    }
     switch (msg->type()) {
       case STUN_BINDING_REQUEST:
         RTC_LOG_V(sev) << ToString() << ": Received "
@@ -526,32 +541,104 @@ void Connection::OnReadPacket(const char* data,
   }
 }
 
+bool Connection::MaybeHandleStunRequestView(const StunMessageView& view) {
+  // Attributes that can be read from the view. Requests with any other, e.g.
+  // GOOG-MISC-INFO, piggybacked acknowledgements or attributes that aren't
+  // comprehended, take the full path.
+  static constexpr int kViewAttributes[] = {
+      STUN_ATTR_USERNAME,          STUN_ATTR_MESSAGE_INTEGRITY,
+      STUN_ATTR_FINGERPRINT,       STUN_ATTR_GOOG_MESSAGE_INTEGRITY_32,
+      STUN_ATTR_PRIORITY,          STUN_ATTR_ICE_CONTROLLING,
+      STUN_ATTR_ICE_CONTROLLED,    STUN_ATTR_USE_CANDIDATE,
+      STUN_ATTR_NOMINATION,        STUN_ATTR_GOOG_NETWORK_INFO,
+      STUN_ATTR_RETRANSMIT_COUNT};
+  if ((view.type() != STUN_BINDING_REQUEST &&
+       view.type() != GOOG_PING_REQUEST) ||
+      !view.HasOnlyAttributes(kViewAttributes)) {
+    return false;
+  }
+  // The full parse rejects numeric attributes of the wrong size.
+  uint32_t priority;
+  uint32_t retransmit_count;
+  uint32_t nomination;
+  uint32_t network_info;
+  uint64_t tiebreaker;
+  if ((view.HasAttribute(STUN_ATTR_PRIORITY) &&
+       !view.GetUInt32(STUN_ATTR_PRIORITY, &priority)) ||
+      (view.HasAttribute(STUN_ATTR_RETRANSMIT_COUNT) &&
+       !view.GetUInt32(STUN_ATTR_RETRANSMIT_COUNT, &retransmit_count)) ||
+      (view.HasAttribute(STUN_ATTR_NOMINATION) &&
+       !view.GetUInt32(STUN_ATTR_NOMINATION, &nomination)) ||
+      (view.HasAttribute(STUN_ATTR_GOOG_NETWORK_INFO) &&
+       !view.GetUInt32(STUN_ATTR_GOOG_NETWORK_INFO, &network_info)) ||
+      (view.HasAttribute(STUN_ATTR_ICE_CONTROLLING) &&
+       !view.GetUInt64(STUN_ATTR_ICE_CONTROLLING, &tiebreaker)) ||
+      (view.HasAttribute(STUN_ATTR_ICE_CONTROLLED) &&
+       !view.GetUInt64(STUN_ATTR_ICE_CONTROLLED, &tiebreaker))) {
+    return false;
+  }
+  // A role conflict takes a tie break, and possibly an error response.
+  const IceRole role = port_->GetIceRole();
+  if (role == ICEROLE_UNKNOWN ||
+      view.HasAttribute(role == ICEROLE_CONTROLLING
+                            ? STUN_ATTR_ICE_CONTROLLING
+                            : STUN_ATTR_ICE_CONTROLLED)) {
+    return false;
+  }
+  absl::string_view remote_ufrag;
+  if (!port_->ValidateStunRequest(view, &remote_ufrag) ||
+      (view.type() == STUN_BINDING_REQUEST &&
+       remote_ufrag != remote_candidate_.username())) {
+    return false;
+  }
+
+  if (view.type() == STUN_BINDING_REQUEST) {
+    rtc::LoggingSeverity sev = (!writable() ? rtc::LS_INFO : rtc::LS_VERBOSE);
+    RTC_LOG_V(sev) << ToString() << ": Received "
+                   << StunMethodToString(view.type())
+                   << ", id=" << rtc::hex_encode(view.transaction_id());
+  }
+  // This connection should now be receiving.
+  ReceivedPing(std::string(view.transaction_id()));
+  MaybeSendExtraPing();
+
+  stats_.recv_ping_requests++;
+  LogCandidatePairEvent(webrtc::IceCandidatePairEventType::kCheckReceived,
+                        view.reduced_transaction_id());
+
+  if (view.type() == STUN_BINDING_REQUEST) {
+    SendStunBindingResponseToRequest(
+        view.transaction_id(),
+        view.GetUInt32(STUN_ATTR_RETRANSMIT_COUNT, &retransmit_count)
+            ? absl::optional<uint32_t>(retransmit_count)
+            : absl::nullopt,
+        /*announce_goog_ping=*/false);
+  } else {
+    SendGoogPingResponseToRequest(view.transaction_id());
+  }
+
+  // If it timed out on writing check, start up again
+  if (!pruned_ && write_state_ == STATE_WRITE_TIMEOUT) {
+    set_write_state(STATE_WRITE_INIT);
+  }
+
+  if (role == ICEROLE_CONTROLLED) {
+    OnRemoteNomination(view.GetUInt32(STUN_ATTR_NOMINATION, &nomination)
+                           ? absl::optional<uint32_t>(nomination)
+                           : absl::nullopt,
+                       view.HasAttribute(STUN_ATTR_USE_CANDIDATE));
+  }
+  if (view.GetUInt32(STUN_ATTR_GOOG_NETWORK_INFO, &network_info)) {
+    OnRemoteNetworkInfo(network_info);
+  }
+  return true;
+}
+
 void Connection::HandleStunBindingOrGoogPingRequest(IceMessage* msg) {
   RTC_DCHECK_RUN_ON(network_thread_);
   // This connection should now be receiving.
   ReceivedPing(msg->transaction_id());
-  if (field_trials_->extra_ice_ping && last_ping_response_received_ == 0) {
-    if (local_candidate().type() == RELAY_PORT_TYPE ||
-        local_candidate().type() == PRFLX_PORT_TYPE ||
-        remote_candidate().type() == RELAY_PORT_TYPE ||
-        remote_candidate().type() == PRFLX_PORT_TYPE) {
-      const int64_t now = rtc::TimeMillis();
-      if (last_ping_sent_ + kMinExtraPingDelayMs <= now) {
-        RTC_LOG(LS_INFO) << ToString()
-                         << "WebRTC-ExtraICEPing/Sending extra ping"
-                            " last_ping_sent_: "
-                         << last_ping_sent_ << " now: " << now
-                         << " (diff: " << (now - last_ping_sent_) << ")";
-        Ping(now);
-      } else {
-        RTC_LOG(LS_INFO) << ToString()
-                         << "WebRTC-ExtraICEPing/Not sending extra ping"
-                            " last_ping_sent_: "
-                         << last_ping_sent_ << " now: " << now
-                         << " (diff: " << (now - last_ping_sent_) << ")";
-      }
-    }
-  }
+  MaybeSendExtraPing();
 
   const rtc::SocketAddress& remote_addr = remote_candidate_.address();
   if (msg->type() == STUN_BINDING_REQUEST) {
@@ -584,39 +671,16 @@ void Connection::HandleStunBindingOrGoogPingRequest(IceMessage* msg) {
   if (port_->GetIceRole() == ICEROLE_CONTROLLED) {
     const StunUInt32Attribute* nomination_attr =
         msg->GetUInt32(STUN_ATTR_NOMINATION);
-    uint32_t nomination = 0;
-    if (nomination_attr) {
-      nomination = nomination_attr->value();
-      if (nomination == 0) {
-        RTC_LOG(LS_ERROR) << "Invalid nomination: " << nomination;
-      }
-    } else {
-      const StunByteStringAttribute* use_candidate_attr =
-          msg->GetByteString(STUN_ATTR_USE_CANDIDATE);
-      if (use_candidate_attr) {
-        nomination = 1;
-      }
-    }
-    // We don't un-nominate a connection, so we only keep a larger nomination.
-    if (nomination > remote_nomination_) {
-      set_remote_nomination(nomination);
-      SignalNominated(this);
-    }
+    OnRemoteNomination(nomination_attr
+                           ? absl::optional<uint32_t>(nomination_attr->value())
+                           : absl::nullopt,
+                       msg->GetByteString(STUN_ATTR_USE_CANDIDATE) != nullptr);
   }
   // Set the remote cost if the network_info attribute is available.
-  // Note: If packets are re-ordered, we may get incorrect network cost
-  // temporarily, but it should get the correct value shortly after that.
   const StunUInt32Attribute* network_attr =
       msg->GetUInt32(STUN_ATTR_GOOG_NETWORK_INFO);
   if (network_attr) {
-    uint32_t network_info = network_attr->value();
-    uint16_t network_cost = static_cast<uint16_t>(network_info);
-    if (network_cost != remote_candidate_.network_cost()) {
-      remote_candidate_.set_network_cost(network_cost);
-      // Network cost change will affect the connection ranking, so signal
-      // state change to force a re-sort in P2PTransportChannel.
-      SignalStateChange(this);
-    }
+    OnRemoteNetworkInfo(network_attr->value());
   }
 
   if (field_trials_->piggyback_ice_check_acknowledgement) {
@@ -624,6 +688,61 @@ void Connection::HandleStunBindingOrGoogPingRequest(IceMessage* msg) {
   }
 }
 
+void Connection::MaybeSendExtraPing() {
+  if (field_trials_->extra_ice_ping && last_ping_response_received_ == 0) {
+    if (local_candidate().type() == RELAY_PORT_TYPE ||
+        local_candidate().type() == PRFLX_PORT_TYPE ||
+        remote_candidate().type() == RELAY_PORT_TYPE ||
+        remote_candidate().type() == PRFLX_PORT_TYPE) {
+      const int64_t now = rtc::TimeMillis();
+      if (last_ping_sent_ + kMinExtraPingDelayMs <= now) {
+        RTC_LOG(LS_INFO) << ToString()
+                         << "WebRTC-ExtraICEPing/Sending extra ping"
+                            " last_ping_sent_: "
+                         << last_ping_sent_ << " now: " << now
+                         << " (diff: " << (now - last_ping_sent_) << ")";
+        Ping(now);
+      } else {
+        RTC_LOG(LS_INFO) << ToString()
+                         << "WebRTC-ExtraICEPing/Not sending extra ping"
+                            " last_ping_sent_: "
+                         << last_ping_sent_ << " now: " << now
+                         << " (diff: " << (now - last_ping_sent_) << ")";
+      }
+    }
+  }
+}
+
+void Connection::OnRemoteNomination(absl::optional<uint32_t> nomination,
+                                    bool use_candidate) {
+  uint32_t value = 0;
+  if (nomination) {
+    value = *nomination;
+    if (value == 0) {
+      RTC_LOG(LS_ERROR) << "Invalid nomination: " << value;
+    }
+  } else if (use_candidate) {
+    value = 1;
+  }
+  // We don't un-nominate a connection, so we only keep a larger nomination.
+  if (value > remote_nomination_) {
+    set_remote_nomination(value);
+    SignalNominated(this);
+  }
+}
+
+void Connection::OnRemoteNetworkInfo(uint32_t network_info) {
+  // Note: If packets are re-ordered, we may get incorrect network cost
+  // temporarily, but it should get the correct value shortly after that.
+  uint16_t network_cost = static_cast<uint16_t>(network_info);
+  if (network_cost != remote_candidate_.network_cost()) {
+    remote_candidate_.set_network_cost(network_cost);
+    // Network cost change will affect the connection ranking, so signal
+    // state change to force a re-sort in P2PTransportChannel.
+    SignalStateChange(this);
+  }
+}
+
 void Connection::SendStunBindingResponse(const StunMessage* message) {
   RTC_DCHECK_RUN_ON(network_thread_);
   RTC_DCHECK_EQ(message->type(), STUN_BINDING_REQUEST);
@@ -637,43 +756,57 @@ void Connection::SendStunBindingResponse(const StunMessage* message) {
     return;
   }
 
-  // Fill in the response.
-  StunMessage response(STUN_BINDING_RESPONSE, message->transaction_id());
   const StunUInt32Attribute* retransmit_attr =
       message->GetUInt32(STUN_ATTR_RETRANSMIT_COUNT);
-  if (retransmit_attr) {
+  bool announce_goog_ping = false;
+  if (field_trials_->announce_goog_ping) {
+    // Check if message contains a announce-request.
+    auto goog_misc = message->GetUInt16List(STUN_ATTR_GOOG_MISC_INFO);
+    announce_goog_ping =
+        goog_misc != nullptr &&
+        goog_misc->Size() >= kSupportGoogPingVersionRequestIndex &&
+        // Which version can we handle...currently any >= 1
+        goog_misc->GetType(kSupportGoogPingVersionRequestIndex) >= 1;
+  }
+  SendStunBindingResponseToRequest(
+      message->transaction_id(),
+      retransmit_attr ? absl::optional<uint32_t>(retransmit_attr->value())
+                      : absl::nullopt,
+      announce_goog_ping);
+}
+
+void Connection::SendStunBindingResponseToRequest(
+    absl::string_view transaction_id,
+    absl::optional<uint32_t> retransmit_count,
+    bool announce_goog_ping) {
+  // Fill in the response.
+  StunMessage response(STUN_BINDING_RESPONSE, transaction_id);
+  if (retransmit_count) {
     // Inherit the incoming retransmit value in the response so the other side
     // can see our view of lost pings.
     response.AddAttribute(std::make_unique<StunUInt32Attribute>(
-        STUN_ATTR_RETRANSMIT_COUNT, retransmit_attr->value()));
+        STUN_ATTR_RETRANSMIT_COUNT, *retransmit_count));
 
-    if (retransmit_attr->value() > CONNECTION_WRITE_CONNECT_FAILURES) {
+    if (*retransmit_count > CONNECTION_WRITE_CONNECT_FAILURES) {
       RTC_LOG(LS_INFO)
           << ToString()
           << ": Received a remote ping with high retransmit count: "
-          << retransmit_attr->value();
+          << *retransmit_count;
     }
   }
 
   response.AddAttribute(std::make_unique<StunXorAddressAttribute>(
       STUN_ATTR_XOR_MAPPED_ADDRESS, remote_candidate_.address()));
 
-  if (field_trials_->announce_goog_ping) {
-    // Check if message contains a announce-request.
-    auto goog_misc = message->GetUInt16List(STUN_ATTR_GOOG_MISC_INFO);
-    if (goog_misc != nullptr &&
-        goog_misc->Size() >= kSupportGoogPingVersionRequestIndex &&
-        // Which version can we handle...currently any >= 1
-        goog_misc->GetType(kSupportGoogPingVersionRequestIndex) >= 1) {
-      auto list =
-          StunAttribute::CreateUInt16ListAttribute(STUN_ATTR_GOOG_MISC_INFO);
-      list->AddTypeAtIndex(kSupportGoogPingVersionResponseIndex,
-                           kGoogPingVersion);
-      response.AddAttribute(std::move(list));
-    }
+  if (announce_goog_ping) {
+    auto list =
+        StunAttribute::CreateUInt16ListAttribute(STUN_ATTR_GOOG_MISC_INFO);
+    list->AddTypeAtIndex(kSupportGoogPingVersionResponseIndex,
+                         kGoogPingVersion);
+    response.AddAttribute(std::move(list));
   }
 
-  response.AddMessageIntegrity(local_candidate().password());
+  AddLocalMessageIntegrity(&response, /*integrity32=*/false);
   response.AddFingerprint();
 
   SendResponseMessage(response);
@@ -682,25 +815,50 @@ void Connection::SendStunBindingResponse(const StunMessage* message) {
 void Connection::SendGoogPingResponse(const StunMessage* message) {
   RTC_DCHECK_RUN_ON(network_thread_);
   RTC_DCHECK(message->type() == GOOG_PING_REQUEST);
+  SendGoogPingResponseToRequest(message->transaction_id());
+}
 
+void Connection::SendGoogPingResponseToRequest(
+    absl::string_view transaction_id) {
   // Fill in the response.
-  StunMessage response(GOOG_PING_RESPONSE, message->transaction_id());
-  response.AddMessageIntegrity32(local_candidate().password());
+  StunMessage response(GOOG_PING_RESPONSE, transaction_id);
+  AddLocalMessageIntegrity(&response, /*integrity32=*/true);
   SendResponseMessage(response);
 }
 
+void Connection::AddLocalMessageIntegrity(StunMessage* response,
+                                          bool integrity32) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  const std::string& password = local_candidate().password();
+  // The local candidate carries the password of the port, so reuse its key
+  // rather than keeping another HMAC context per connection.
+  if (port() && port()->password() == password) {
+    const StunMessageIntegrityKey& key = port()->integrity_key();
+    if (integrity32) {
+      response->AddMessageIntegrity32(key);
+    } else {
+      response->AddMessageIntegrity(key);
+    }
+  } else if (integrity32) {
+    response->AddMessageIntegrity32(password);
+  } else {
+    response->AddMessageIntegrity(password);
+  }
+}
+
 void Connection::SendResponseMessage(const StunMessage& response) {
   RTC_DCHECK_RUN_ON(network_thread_);
   // Where I send the response.
   const rtc::SocketAddress& addr = remote_candidate_.address();
 
   // Send the response.
-  rtc::ByteBufferWriter buf;
-  response.Write(&buf);
+  response_buffer_.Clear();
+  response.Write(&response_buffer_);
   rtc::PacketOptions options(port_->StunDscpValue());
   options.info_signaled_after_sent.packet_type =
       rtc::PacketType::kIceConnectivityCheckResponse;
-  auto err = port_->SendTo(buf.Data(), buf.Length(), addr, options, false);
+  auto err = port_->SendTo(response_buffer_.Data(), response_buffer_.Length(),
+                           addr, options, false);
   if (err < 0) {
     RTC_LOG(LS_ERROR) << ToString() << ": Failed to send "
                       << StunMethodToString(response.type())
@@ -991,7 +1149,8 @@ std::unique_ptr<IceMessage> Connection::BuildPingRequest() {
     list->AddTypeAtIndex(kSupportGoogPingVersionRequestIndex, kGoogPingVersion);
     message->AddAttribute(std::move(list));
   }
-  message->AddMessageIntegrity(remote_candidate_.password());
+  remote_integrity_key_.SetPassword(remote_candidate_.password());
+  message->AddMessageIntegrity(remote_integrity_key_);
   message->AddFingerprint();
 
   return message;
@@ -26,6 +26,7 @@
 #include "p2p/base/stun_request.h"
 #include "p2p/base/transport_description.h"
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/byte_buffer.h"
 #include "rtc_base/message_handler.h"
 #include "rtc_base/network.h"
 #include "rtc_base/numerics/event_based_exponential_moving_average.h"
@@ -311,6 +312,8 @@ class Connection : public CandidatePairInterface {
 
   void SendStunBindingResponse(const StunMessage* message);
   void SendGoogPingResponse(const StunMessage* message);
+  // Signs `response` with the local password, using the key of the port.
+  void AddLocalMessageIntegrity(StunMessage* response, bool integrity32);
   void SendResponseMessage(const StunMessage& response);
 
   // An accessor for unit tests.
@@ -385,6 +388,23 @@ class Connection : public CandidatePairInterface {
                              uint32_t transaction_id)
       RTC_RUN_ON(network_thread_);
 
+  // Answers a binding or GOOG_PING request from `view` and returns true, if
+  // that can be done without parsing it into an IceMessage.
+  bool MaybeHandleStunRequestView(const StunMessageView& view)
+      RTC_RUN_ON(network_thread_);
+  // Shared by MaybeHandleStunRequestView() and
+  // HandleStunBindingOrGoogPingRequest().
+  void MaybeSendExtraPing() RTC_RUN_ON(network_thread_);
+  void OnRemoteNomination(absl::optional<uint32_t> nomination,
+                          bool use_candidate) RTC_RUN_ON(network_thread_);
+  void OnRemoteNetworkInfo(uint32_t network_info) RTC_RUN_ON(network_thread_);
+  void SendStunBindingResponseToRequest(
+      absl::string_view transaction_id,
+      absl::optional<uint32_t> retransmit_count,
+      bool announce_goog_ping) RTC_RUN_ON(network_thread_);
+  void SendGoogPingResponseToRequest(absl::string_view transaction_id)
+      RTC_RUN_ON(network_thread_);
+
   // Check if this IceMessage is identical
   // to last message ack:ed STUN_BINDING_REQUEST.
   bool ShouldSendGoogPing(const StunMessage* message)
@@ -414,6 +434,12 @@ class Connection : public CandidatePairInterface {
   uint32_t remote_nomination_ RTC_GUARDED_BY(network_thread_) = 0;
 
   StunRequestManager requests_ RTC_GUARDED_BY(network_thread_);
+  // Reused to serialize the responses to connectivity checks.
+  rtc::ByteBufferWriter response_buffer_ RTC_GUARDED_BY(network_thread_);
+  // Signs the pings and checks the responses to them. The responses to the
+  // remote pings are signed with the key of the port.
+  StunMessageIntegrityKey remote_integrity_key_
+      RTC_GUARDED_BY(network_thread_);
   int rtt_ RTC_GUARDED_BY(network_thread_);
   int rtt_samples_ RTC_GUARDED_BY(network_thread_) = 0;
   // https://w3c.github.io/webrtc-stats/#dom-rtcicecandidatepairstats-totalroundtriptime
@@ -25,10 +25,12 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/dscp.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/rtc_certificate.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/stream.h"
 #include "rtc_base/thread.h"
+#include "system_wrappers/include/metrics.h"
 
 namespace cricket {
 
@@ -142,6 +144,8 @@ DtlsTransport::DtlsTransport(IceTransportInternal* ice_transport,
       ice_transport_(ice_transport),
       downward_(NULL),
       srtp_ciphers_(crypto_options.GetSupportedDtlsSrtpCryptoSuites()),
+      enable_session_resumption_(
+          crypto_options.dtls.enable_session_resumption),
       ssl_max_version_(max_version),
       event_log_(event_log) {
   RTC_DCHECK(ice_transport_);
@@ -371,6 +375,7 @@ bool DtlsTransport::SetupDtls() {
   dtls_->SetMode(rtc::SSL_MODE_DTLS);
   dtls_->SetMaxProtocolVersion(ssl_max_version_);
   dtls_->SetServerRole(*dtls_role_);
+  dtls_->SetSessionResumptionEnabled(enable_session_resumption_);
   dtls_->SignalEvent.connect(this, &DtlsTransport::OnDtlsEvent);
   dtls_->SignalSSLHandshakeError.connect(this,
                                          &DtlsTransport::OnDtlsHandshakeError);
@@ -682,7 +687,22 @@ void DtlsTransport::OnDtlsEvent(rtc::StreamInterface* dtls, int sig, int err) {
   RTC_DCHECK(dtls == dtls_.get());
   if (sig & rtc::SE_OPEN) {
     // This is the first time.
-    RTC_LOG(LS_INFO) << ToString() << ": DTLS handshake complete.";
+    const rtc::SSLHandshakeStats stats = dtls_->GetHandshakeStats();
+    RTC_LOG(LS_INFO) << ToString() << ": DTLS handshake complete"
+                     << (stats.session_resumed ? ", session resumed" : "")
+                     << ", processing time " << stats.processing_time_us
+                     << " us, " << stats.round_trips << " round trips, "
+                     << stats.retransmissions << " retransmissions.";
+    RTC_HISTOGRAM_BOOLEAN("WebRTC.PeerConnection.DtlsSessionResumed",
+                          stats.session_resumed);
+    RTC_HISTOGRAM_COUNTS_100000(
+        "WebRTC.PeerConnection.DtlsHandshakeProcessingTimeUs",
+        rtc::saturated_cast<int>(stats.processing_time_us));
+    RTC_HISTOGRAM_COUNTS_100("WebRTC.PeerConnection.DtlsHandshakeRoundTrips",
+                             stats.round_trips);
+    RTC_HISTOGRAM_COUNTS_100(
+        "WebRTC.PeerConnection.DtlsHandshakeRetransmissions",
+        stats.retransmissions);
     if (dtls_->GetState() == rtc::SS_OPEN) {
       // The check for OPEN shouldn't be necessary but let's make
       // sure we don't accidentally frob the state if it's closed.
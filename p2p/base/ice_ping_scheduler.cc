@@ -0,0 +1,150 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/ice_ping_scheduler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/time_utils.h"
+
+namespace cricket {
+
+using ::webrtc::SafeTask;
+using ::webrtc::TimeDelta;
+
+IcePingScheduler::IcePingScheduler(webrtc::TaskQueueBase* network_thread,
+                                   const Config& config)
+    : network_thread_(network_thread), config_(config) {
+  RTC_DCHECK(network_thread_);
+  RTC_DCHECK_GT(config_.tick.ms(), 0);
+  RTC_DCHECK_GT(config_.max_checks_per_tick, 0);
+}
+
+IcePingScheduler::~IcePingScheduler() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+}
+
+void IcePingScheduler::Schedule(Client* client, TimeDelta delay) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  RTC_DCHECK(client);
+  Cancel(client);
+  // Rounding up to the next tick boundary lets the checks due within the
+  // same tick share a wakeup. It also keeps a client that is run and
+  // scheduled again without delay from running twice on the same tick.
+  const int64_t tick_ms = config_.tick.ms();
+  AddToTick(client,
+            (rtc::TimeMillis() + std::max<int64_t>(delay.ms(), 0)) / tick_ms +
+                1);
+  ScheduleWakeup();
+}
+
+void IcePingScheduler::Cancel(Client* client) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  auto it = client_ticks_.find(client);
+  if (it == client_ticks_.end()) {
+    return;
+  }
+  auto tick_it = ticks_.find(it->second);
+  RTC_DCHECK(tick_it != ticks_.end());
+  tick_it->second.erase(absl::c_find(tick_it->second, client));
+  if (tick_it->second.empty()) {
+    ticks_.erase(tick_it);
+  }
+  client_ticks_.erase(it);
+}
+
+size_t IcePingScheduler::num_scheduled() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return client_ticks_.size();
+}
+
+int64_t IcePingScheduler::num_wakeups() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return num_wakeups_;
+}
+
+void IcePingScheduler::AddToTick(Client* client, int64_t tick) {
+  for (auto it = ticks_.lower_bound(tick);
+       it != ticks_.end() && it->first == tick &&
+       it->second.size() >= static_cast<size_t>(config_.max_checks_per_tick);
+       ++it) {
+    ++tick;
+  }
+  ticks_[tick].push_back(client);
+  client_ticks_[client] = tick;
+}
+
+void IcePingScheduler::ScheduleWakeup() {
+  if (ticks_.empty()) {
+    return;
+  }
+  const int64_t tick = ticks_.begin()->first;
+  // A pending wakeup for a later tick is left to expire, see OnTick().
+  if (wakeup_tick_ >= 0 && wakeup_tick_ <= tick) {
+    return;
+  }
+  wakeup_tick_ = tick;
+  const int64_t delay_ms =
+      std::max<int64_t>(tick * config_.tick.ms() - rtc::TimeMillis(), 0);
+  network_thread_->PostDelayedTask(
+      SafeTask(task_safety_.flag(), [this, tick] { OnTick(tick); }),
+      TimeDelta::Millis(delay_ms));
+}
+
+void IcePingScheduler::OnTick(int64_t tick) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  if (tick != wakeup_tick_) {
+    // Replaced by a wakeup for an earlier tick.
+    return;
+  }
+  wakeup_tick_ = -1;
+  // Also runs the clients of the ticks that were missed, if the thread was
+  // busy, but no more than on any other tick.
+  const int64_t last_tick =
+      std::max(tick, rtc::TimeMillis() / config_.tick.ms());
+  int num_run = 0;
+  while (num_run < config_.max_checks_per_tick && !ticks_.empty() &&
+         ticks_.begin()->first <= last_tick) {
+    auto it = ticks_.begin();
+    // Clients are taken one at a time, since each may cancel or schedule
+    // others.
+    Client* client = it->second.front();
+    it->second.erase(it->second.begin());
+    if (it->second.empty()) {
+      ticks_.erase(it);
+    }
+    client_ticks_.erase(client);
+    ++num_run;
+    client->OnPingDue();
+  }
+  if (num_run > 0) {
+    ++num_wakeups_;
+  }
+  // The missed clients that didn't fit are spread over the following ticks,
+  // in order, rather than run in a burst on the next wakeup.
+  std::vector<Client*> overdue;
+  while (!ticks_.empty() && ticks_.begin()->first <= last_tick) {
+    auto it = ticks_.begin();
+    for (Client* client : it->second) {
+      overdue.push_back(client);
+      client_ticks_.erase(client);
+    }
+    ticks_.erase(it);
+  }
+  for (Client* client : overdue) {
+    AddToTick(client, last_tick + 1);
+  }
+  ScheduleWakeup();
+}
+
+}  // namespace cricket
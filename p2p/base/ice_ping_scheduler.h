@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_ICE_PING_SCHEDULER_H_
+#define P2P_BASE_ICE_PING_SCHEDULER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <vector>
+
+#include "api/sequence_checker.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace cricket {
+
+// Runs the connectivity checks of many ICE transports from one timer, for
+// servers that host thousands of them. Instead of each transport posting its
+// own delayed task, the transports schedule themselves here and are run on
+// ticks of a fixed length, so that the checks due around the same time share
+// one wakeup and are sent back to back. At most `max_checks_per_tick` clients
+// are run per tick: the others are pushed to the following ticks, which
+// spreads bursts of checks, e.g. from transports created together or due
+// while the thread was busy, over time and keeps the control traffic from
+// delaying the media packets.
+//
+// Must be created, used and destroyed on the network thread of the
+// transports.
+class RTC_EXPORT IcePingScheduler {
+ public:
+  class Client {
+   public:
+    // Called when the delay passed to `Schedule` has elapsed. The client is
+    // no longer scheduled, and may schedule itself again.
+    virtual void OnPingDue() = 0;
+
+   protected:
+    virtual ~Client() = default;
+  };
+
+  struct Config {
+    webrtc::TimeDelta tick = webrtc::TimeDelta::Millis(5);
+    int max_checks_per_tick = 50;
+  };
+
+  IcePingScheduler(webrtc::TaskQueueBase* network_thread,
+                   const Config& config);
+  ~IcePingScheduler();
+
+  IcePingScheduler(const IcePingScheduler&) = delete;
+  IcePingScheduler& operator=(const IcePingScheduler&) = delete;
+
+  // Runs `client` on the first tick with room at or after `delay`. Replaces
+  // the previous schedule of `client`, if any.
+  void Schedule(Client* client, webrtc::TimeDelta delay);
+  void Cancel(Client* client);
+
+  // Number of clients waiting for their tick.
+  size_t num_scheduled() const;
+  // Number of ticks that ran at least one client.
+  int64_t num_wakeups() const;
+
+ private:
+  // Adds `client` to the first tick at or after `tick` with room.
+  void AddToTick(Client* client, int64_t tick);
+  void ScheduleWakeup();
+  void OnTick(int64_t tick);
+
+  RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker sequence_checker_;
+  webrtc::TaskQueueBase* const network_thread_;
+  const Config config_;
+  // Clients by tick number, in the order they were scheduled. A tick is the
+  // time in milliseconds divided by the tick length.
+  std::map<int64_t, std::vector<Client*>> ticks_
+      RTC_GUARDED_BY(sequence_checker_);
+  // The tick each scheduled client runs on.
+  std::map<Client*, int64_t> client_ticks_ RTC_GUARDED_BY(sequence_checker_);
+  // The tick of the pending wakeup task, if any.
+  int64_t wakeup_tick_ RTC_GUARDED_BY(sequence_checker_) = -1;
+  int64_t num_wakeups_ RTC_GUARDED_BY(sequence_checker_) = 0;
+  webrtc::ScopedTaskSafety task_safety_;
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_ICE_PING_SCHEDULER_H_
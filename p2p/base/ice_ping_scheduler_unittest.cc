@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/ice_ping_scheduler.h"
+
+#include <map>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "rtc_base/fake_clock.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+
+namespace cricket {
+namespace {
+
+using ::webrtc::TimeDelta;
+
+class FakeClient : public IcePingScheduler::Client {
+ public:
+  void OnPingDue() override { run_times_ms.push_back(rtc::TimeMillis()); }
+
+  std::vector<int64_t> run_times_ms;
+};
+
+class IcePingSchedulerTest : public ::testing::Test {
+ protected:
+  IcePingSchedulerTest() {
+    config_.tick = TimeDelta::Millis(5);
+    config_.max_checks_per_tick = 3;
+  }
+
+  rtc::ScopedFakeClock clock_;
+  rtc::AutoThread main_thread_;
+  IcePingScheduler::Config config_;
+};
+
+TEST_F(IcePingSchedulerTest, RunsClientAfterDelay) {
+  IcePingScheduler scheduler(rtc::Thread::Current(), config_);
+  FakeClient client;
+  scheduler.Schedule(&client, TimeDelta::Millis(20));
+  EXPECT_EQ(1u, scheduler.num_scheduled());
+  SIMULATED_WAIT(false, 19, clock_);
+  EXPECT_TRUE(client.run_times_ms.empty());
+  SIMULATED_WAIT(false, 10, clock_);
+  EXPECT_EQ(1u, client.run_times_ms.size());
+  EXPECT_EQ(0u, scheduler.num_scheduled());
+}
+
+TEST_F(IcePingSchedulerTest, CoalescesClientsDueInTheSameTick) {
+  config_.max_checks_per_tick = 50;
+  IcePingScheduler scheduler(rtc::Thread::Current(), config_);
+  std::vector<FakeClient> clients(100);
+  for (size_t i = 0; i < clients.size(); ++i) {
+    scheduler.Schedule(&clients[i], TimeDelta::Millis(i % 10));
+  }
+  SIMULATED_WAIT(false, 100, clock_);
+  for (const FakeClient& client : clients) {
+    EXPECT_EQ(1u, client.run_times_ms.size());
+  }
+  // Delays of 0-4 ms and 5-9 ms fall into two ticks.
+  EXPECT_EQ(2, scheduler.num_wakeups());
+}
+
+TEST_F(IcePingSchedulerTest, SpreadsBurstsOverTicks) {
+  IcePingScheduler scheduler(rtc::Thread::Current(), config_);
+  std::vector<FakeClient> clients(10);
+  for (FakeClient& client : clients) {
+    scheduler.Schedule(&client, TimeDelta::Zero());
+  }
+  SIMULATED_WAIT(false, 100, clock_);
+  std::map<int64_t, int> clients_by_run_time;
+  for (const FakeClient& client : clients) {
+    ASSERT_EQ(1u, client.run_times_ms.size());
+    ++clients_by_run_time[client.run_times_ms[0]];
+  }
+  EXPECT_EQ(4u, clients_by_run_time.size());
+  for (const auto& run_time : clients_by_run_time) {
+    EXPECT_LE(run_time.second, 3);
+  }
+  // The ticks follow each other.
+  EXPECT_EQ(15, clients_by_run_time.rbegin()->first -
+                    clients_by_run_time.begin()->first);
+}
+
+TEST_F(IcePingSchedulerTest, SpreadsMissedTicksAfterStall) {
+  IcePingScheduler scheduler(rtc::Thread::Current(), config_);
+  std::vector<FakeClient> clients(12);
+  for (FakeClient& client : clients) {
+    scheduler.Schedule(&client, TimeDelta::Zero());
+  }
+  // The thread is busy while the four ticks of the clients pass.
+  clock_.AdvanceTime(TimeDelta::Millis(50));
+  const int64_t stall_end_ms = rtc::TimeMillis();
+  SIMULATED_WAIT(false, 100, clock_);
+  std::map<int64_t, int> clients_by_run_time;
+  for (const FakeClient& client : clients) {
+    ASSERT_EQ(1u, client.run_times_ms.size());
+    ++clients_by_run_time[client.run_times_ms[0]];
+  }
+  // One tick's worth runs when the thread is back, the others on the ticks
+  // that follow.
+  EXPECT_EQ(stall_end_ms, clients_by_run_time.begin()->first);
+  EXPECT_EQ(4u, clients_by_run_time.size());
+  for (const auto& run_time : clients_by_run_time) {
+    EXPECT_EQ(3, run_time.second);
+  }
+  EXPECT_LE(clients_by_run_time.rbegin()->first - stall_end_ms, 20);
+}
+
+TEST_F(IcePingSchedulerTest, CancelledClientDoesNotRun) {
+  IcePingScheduler scheduler(rtc::Thread::Current(), config_);
+  FakeClient cancelled;
+  FakeClient other;
+  scheduler.Schedule(&cancelled, TimeDelta::Millis(10));
+  scheduler.Schedule(&other, TimeDelta::Millis(10));
+  scheduler.Cancel(&cancelled);
+  SIMULATED_WAIT(false, 100, clock_);
+  EXPECT_TRUE(cancelled.run_times_ms.empty());
+  EXPECT_EQ(1u, other.run_times_ms.size());
+}
+
+TEST_F(IcePingSchedulerTest, ScheduleReplacesPreviousSchedule) {
+  IcePingScheduler scheduler(rtc::Thread::Current(), config_);
+  FakeClient client;
+  const int64_t start_ms = rtc::TimeMillis();
+  scheduler.Schedule(&client, TimeDelta::Millis(100));
+  scheduler.Schedule(&client, TimeDelta::Millis(10));
+  EXPECT_EQ(1u, scheduler.num_scheduled());
+  SIMULATED_WAIT(false, 200, clock_);
+  ASSERT_EQ(1u, client.run_times_ms.size());
+  EXPECT_LT(client.run_times_ms[0] - start_ms, 20);
+}
+
+}  // namespace
+}  // namespace cricket
@@ -122,12 +122,14 @@ std::unique_ptr<P2PTransportChannel> P2PTransportChannel::Create(
         transport_name, component, init.port_allocator(), nullptr,
         std::make_unique<webrtc::WrappingAsyncDnsResolverFactory>(
             init.async_resolver_factory()),
-        init.event_log(), init.ice_controller_factory(), init.field_trials()));
+        init.event_log(), init.ice_controller_factory(), init.ping_scheduler(),
+        init.field_trials()));
   } else {
     return absl::WrapUnique(new P2PTransportChannel(
         transport_name, component, init.port_allocator(),
         init.async_dns_resolver_factory(), nullptr, init.event_log(),
-        init.ice_controller_factory(), init.field_trials()));
+        init.ice_controller_factory(), init.ping_scheduler(),
+        init.field_trials()));
   }
 }
 
@@ -143,6 +145,7 @@ P2PTransportChannel::P2PTransportChannel(
                           /* owned_dns_resolver_factory= */ nullptr,
                           /* event_log= */ nullptr,
                           /* ice_controller_factory= */ nullptr,
+                          /* ping_scheduler= */ nullptr,
                           field_trials) {}
 
 // Private constructor, called from Create()
@@ -155,6 +158,7 @@ P2PTransportChannel::P2PTransportChannel(
         owned_dns_resolver_factory,
     webrtc::RtcEventLog* event_log,
     IceControllerFactoryInterface* ice_controller_factory,
+    IcePingScheduler* ping_scheduler,
     const webrtc::FieldTrialsView* field_trials)
     : transport_name_(transport_name),
       component_(component),
@@ -166,6 +170,7 @@ P2PTransportChannel::P2PTransportChannel(
                                       : async_dns_resolver_factory),
       owned_dns_resolver_factory_(std::move(owned_dns_resolver_factory)),
       network_thread_(rtc::Thread::Current()),
+      ping_scheduler_(ping_scheduler),
       incoming_only_(false),
       error_(0),
       sort_dirty_(false),
@@ -220,6 +225,9 @@ P2PTransportChannel::P2PTransportChannel(
 P2PTransportChannel::~P2PTransportChannel() {
   TRACE_EVENT0("webrtc", "P2PTransportChannel::~P2PTransportChannel");
   RTC_DCHECK_RUN_ON(network_thread_);
+  if (ping_scheduler_) {
+    ping_scheduler_->Cancel(this);
+  }
   std::vector<Connection*> copy(connections().begin(), connections().end());
   for (Connection* connection : copy) {
     connection->SignalDestroyed.disconnect(this);
@@ -1739,8 +1747,7 @@ void P2PTransportChannel::MaybeStartPinging() {
     RTC_LOG(LS_INFO) << ToString()
                      << ": Have a pingable connection for the first time; "
                         "starting to ping.";
-    network_thread_->PostTask(
-        SafeTask(task_safety_.flag(), [this]() { CheckAndPing(); }));
+    ScheduleCheckAndPing(TimeDelta::Zero());
     regathering_controller_->Start();
     started_pinging_ = true;
   }
@@ -2080,8 +2087,26 @@ void P2PTransportChannel::CheckAndPing() {
     MarkConnectionPinged(conn);
   }
 
-  network_thread_->PostDelayedTask(
-      SafeTask(task_safety_.flag(), [this]() { CheckAndPing(); }), delay);
+  ScheduleCheckAndPing(delay);
+}
+
+void P2PTransportChannel::ScheduleCheckAndPing(TimeDelta delay) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  if (ping_scheduler_) {
+    ping_scheduler_->Schedule(this, delay);
+    return;
+  }
+  if (delay.IsZero()) {
+    network_thread_->PostTask(
+        SafeTask(task_safety_.flag(), [this]() { CheckAndPing(); }));
+  } else {
+    network_thread_->PostDelayedTask(
+        SafeTask(task_safety_.flag(), [this]() { CheckAndPing(); }), delay);
+  }
+}
+
+void P2PTransportChannel::OnPingDue() {
+  CheckAndPing();
 }
 
 // This method is only for unit testing.
@@ -44,6 +44,7 @@
 #include "api/task_queue/pending_task_safety_flag.h"
 #include "api/transport/enums.h"
 #include "api/transport/stun.h"
+#include "api/units/time_delta.h"
 #include "logging/rtc_event_log/events/rtc_event_ice_candidate_pair_config.h"
 #include "logging/rtc_event_log/ice_logger.h"
 #include "p2p/base/basic_async_resolver_factory.h"
@@ -51,6 +52,7 @@
 #include "p2p/base/connection.h"
 #include "p2p/base/ice_controller_factory_interface.h"
 #include "p2p/base/ice_controller_interface.h"
+#include "p2p/base/ice_ping_scheduler.h"
 #include "p2p/base/ice_switch_reason.h"
 #include "p2p/base/ice_transport_internal.h"
 #include "p2p/base/p2p_constants.h"
@@ -104,7 +106,8 @@ class RemoteCandidate : public Candidate {
 
 // P2PTransportChannel manages the candidates and connection process to keep
 // two P2P clients connected to each other.
-class RTC_EXPORT P2PTransportChannel : public IceTransportInternal {
+class RTC_EXPORT P2PTransportChannel : public IceTransportInternal,
+                                       public IcePingScheduler::Client {
  public:
   static std::unique_ptr<P2PTransportChannel> Create(
       absl::string_view transport_name,
@@ -249,6 +252,7 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal {
           owned_dns_resolver_factory,
       webrtc::RtcEventLog* event_log,
       IceControllerFactoryInterface* ice_controller_factory,
+      IcePingScheduler* ping_scheduler,
       const webrtc::FieldTrialsView* field_trials);
   bool IsGettingPorts() {
     RTC_DCHECK_RUN_ON(network_thread_);
@@ -334,6 +338,11 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal {
   void OnNominated(Connection* conn);
 
   void CheckAndPing();
+  // Runs CheckAndPing() after `delay`, from the ping scheduler if there is
+  // one.
+  void ScheduleCheckAndPing(webrtc::TimeDelta delay);
+  // IcePingScheduler::Client implementation.
+  void OnPingDue() override;
 
   void LogCandidatePairConfig(Connection* conn,
                               webrtc::IceCandidatePairConfigType type);
@@ -413,6 +422,9 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal {
   const std::unique_ptr<webrtc::AsyncDnsResolverFactoryInterface>
       owned_dns_resolver_factory_;
   rtc::Thread* const network_thread_;
+  // Shared with other channels, or null if this channel schedules its own
+  // checks.
+  IcePingScheduler* const ping_scheduler_;
   bool incoming_only_ RTC_GUARDED_BY(network_thread_);
   int error_ RTC_GUARDED_BY(network_thread_);
   std::vector<std::unique_ptr<PortAllocatorSession>> allocator_sessions_
@@ -19,6 +19,7 @@
 #include "p2p/base/basic_ice_controller.h"
 #include "p2p/base/connection.h"
 #include "p2p/base/fake_port_allocator.h"
+#include "p2p/base/ice_ping_scheduler.h"
 #include "p2p/base/ice_transport_internal.h"
 #include "p2p/base/mock_async_resolver.h"
 #include "p2p/base/packet_transport_internal.h"
@@ -3640,6 +3641,38 @@ TEST_F(P2PTransportChannelPingTest, TestAllConnectionsPingedSufficiently) {
       kDefaultTimeout);
 }
 
+// Verify that channels sharing a ping scheduler are pinged from its ticks.
+TEST_F(P2PTransportChannelPingTest, TestPingsFromSharedScheduler) {
+  IcePingScheduler scheduler(rtc::Thread::Current(), {});
+  std::vector<std::unique_ptr<FakePortAllocator>> allocators;
+  std::vector<std::unique_ptr<P2PTransportChannel>> channels;
+  std::vector<Connection*> connections;
+  for (int i = 0; i < 2; ++i) {
+    allocators.push_back(std::make_unique<FakePortAllocator>(
+        rtc::Thread::Current(), packet_socket_factory()));
+    webrtc::IceTransportInit init;
+    init.set_port_allocator(allocators.back().get());
+    init.set_ping_scheduler(&scheduler);
+    channels.push_back(
+        P2PTransportChannel::Create("shared scheduler", 1, std::move(init)));
+    PrepareChannel(channels.back().get());
+    channels.back()->MaybeStartGathering();
+    channels.back()->AddRemoteCandidate(
+        CreateUdpCandidate(LOCAL_PORT_TYPE, "1.1.1.1", 1, 1));
+    connections.push_back(
+        WaitForConnectionTo(channels.back().get(), "1.1.1.1", 1));
+    ASSERT_TRUE(connections.back() != nullptr);
+  }
+
+  EXPECT_TRUE_WAIT(connections[0]->num_pings_sent() > 0 &&
+                       connections[1]->num_pings_sent() > 0,
+                   kDefaultTimeout);
+  EXPECT_GT(scheduler.num_wakeups(), 0);
+  // Destroying a channel cancels its next check.
+  channels.pop_back();
+  EXPECT_EQ(1u, scheduler.num_scheduled());
+}
+
 // Verify that the connections are pinged at the right time.
 TEST_F(P2PTransportChannelPingTest, TestStunPingIntervals) {
   rtc::ScopedFakeClock clock;
@@ -240,6 +240,9 @@ const std::vector<Candidate>& Port::Candidates() const {
 }
 
 Connection* Port::GetConnection(const rtc::SocketAddress& remote_addr) {
+  if (RemoteAddressIndex<Connection>::IsIndexable(remote_addr)) {
+    return connection_index_.Find(remote_addr);
+  }
   AddressMap::const_iterator iter = connections_.find(remote_addr);
   if (iter != connections_.end())
     return iter->second;
@@ -336,8 +339,11 @@ void Port::PostAddAddress(bool is_final) {
 }
 
 void Port::AddOrReplaceConnection(Connection* conn) {
-  auto ret = connections_.insert(
-      std::make_pair(conn->remote_candidate().address(), conn));
+  const rtc::SocketAddress& remote_addr = conn->remote_candidate().address();
+  auto ret = connections_.insert(std::make_pair(remote_addr, conn));
+  if (RemoteAddressIndex<Connection>::IsIndexable(remote_addr)) {
+    connection_index_.Insert(remote_addr, conn);
+  }
   // If there is a different connection on the same remote address, replace
   // it with the new one and destroy the old one.
   if (ret.second == false && ret.first->second != conn) {
@@ -425,27 +431,36 @@ bool Port::GetStunMessage(const char* data,
                           const rtc::SocketAddress& addr,
                           std::unique_ptr<IceMessage>* out_msg,
                           std::string* out_username) {
-  // NOTE: This could clearly be optimized to avoid allocating any memory.
-  //       However, at the data rates we'll be looking at on the client side,
-  //       this probably isn't worth worrying about.
+  // Don't bother parsing the packet if we can tell it's not STUN. The view
+  // only indexes the attributes, and is used below to check the message
+  // integrity in place.
+  StunMessageView view;
+  if (!view.Parse(data, size)) {
+    out_username->clear();
+    return false;
+  }
+  return GetStunMessage(view, addr, out_msg, out_username);
+}
+
+bool Port::GetStunMessage(const StunMessageView& view,
+                          const rtc::SocketAddress& addr,
+                          std::unique_ptr<IceMessage>* out_msg,
+                          std::string* out_username) {
   RTC_DCHECK(out_msg != NULL);
   RTC_DCHECK(out_username != NULL);
   out_username->clear();
 
-  // Don't bother parsing the packet if we can tell it's not STUN.
   // In ICE mode, all STUN packets will have a valid fingerprint.
   // Except GOOG_PING_REQUEST/RESPONSE that does not send fingerprint.
-  int types[] = {GOOG_PING_REQUEST, GOOG_PING_RESPONSE,
-                 GOOG_PING_ERROR_RESPONSE};
-  if (!StunMessage::IsStunMethod(types, data, size) &&
-      !StunMessage::ValidateFingerprint(data, size)) {
+  if (view.type() != GOOG_PING_REQUEST && view.type() != GOOG_PING_RESPONSE &&
+      view.type() != GOOG_PING_ERROR_RESPONSE && !view.ValidateFingerprint()) {
     return false;
   }
 
   // Parse the request message.  If the packet is not a complete and correct
   // STUN message, then ignore it.
   std::unique_ptr<IceMessage> stun_msg(new IceMessage());
-  rtc::ByteBufferReader buf(data, size);
+  rtc::ByteBufferReader buf(view.data(), view.size());
   if (!stun_msg->Read(&buf) || (buf.Length() > 0)) {
     return false;
   }
@@ -459,8 +474,8 @@ bool Port::GetStunMessage(const char* data,
   if (stun_msg->type() == STUN_BINDING_REQUEST) {
     // Check for the presence of USERNAME and MESSAGE-INTEGRITY (if ICE) first.
     // If not present, fail with a 400 Bad Request.
-    if (!stun_msg->GetByteString(STUN_ATTR_USERNAME) ||
-        !stun_msg->GetByteString(STUN_ATTR_MESSAGE_INTEGRITY)) {
+    if (!view.HasAttribute(STUN_ATTR_USERNAME) ||
+        !view.HasAttribute(STUN_ATTR_MESSAGE_INTEGRITY)) {
       RTC_LOG(LS_ERROR) << ToString() << ": Received "
                         << StunMethodToString(stun_msg->type())
                         << " without username/M-I from: "
@@ -485,7 +500,7 @@ bool Port::GetStunMessage(const char* data,
     }
 
     // If ICE, and the MESSAGE-INTEGRITY is bad, fail with a 401 Unauthorized
-    if (stun_msg->ValidateMessageIntegrity(password_) !=
+    if (view.ValidateMessageIntegrity(integrity_key()) !=
         StunMessage::IntegrityStatus::kIntegrityOk) {
       RTC_LOG(LS_ERROR) << ToString() << ": Received "
                         << StunMethodToString(stun_msg->type())
@@ -552,7 +567,7 @@ bool Port::GetStunMessage(const char* data,
     // No stun attributes will be verified, if it's stun indication message.
     // Returning from end of the this method.
   } else if (stun_msg->type() == GOOG_PING_REQUEST) {
-    if (stun_msg->ValidateMessageIntegrity(password_) !=
+    if (view.ValidateMessageIntegrity(integrity_key()) !=
         StunMessage::IntegrityStatus::kIntegrityOk) {
       RTC_LOG(LS_ERROR) << ToString() << ": Received "
                         << StunMethodToString(stun_msg->type())
@@ -586,6 +601,32 @@ bool Port::GetStunMessage(const char* data,
   return true;
 }
 
+bool Port::ValidateStunRequest(const StunMessageView& view,
+                               absl::string_view* remote_ufrag) {
+  RTC_DCHECK(remote_ufrag);
+  *remote_ufrag = absl::string_view();
+  if (view.type() == GOOG_PING_REQUEST) {
+    return view.ValidateMessageIntegrity(integrity_key()) ==
+           StunMessage::IntegrityStatus::kIntegrityOk;
+  }
+  if (view.type() != STUN_BINDING_REQUEST || !view.ValidateFingerprint() ||
+      !view.HasAttribute(STUN_ATTR_MESSAGE_INTEGRITY)) {
+    return false;
+  }
+  // LFRAG:RFRAG, as in ParseStunUsername().
+  const absl::string_view username =
+      view.GetAttributeValue(STUN_ATTR_USERNAME);
+  const size_t colon_pos = username.find(':');
+  if (colon_pos == absl::string_view::npos ||
+      username.substr(0, colon_pos) != username_fragment() ||
+      view.ValidateMessageIntegrity(integrity_key()) !=
+          StunMessage::IntegrityStatus::kIntegrityOk) {
+    return false;
+  }
+  *remote_ufrag = username.substr(colon_pos + 1);
+  return true;
+}
+
 bool Port::IsCompatibleAddress(const rtc::SocketAddress& addr) {
   // Get a representative IP for the Network this port is configured to use.
   rtc::IPAddress ip = network_->GetBestIP();
@@ -613,6 +654,7 @@ void Port::DestroyAllConnections() {
     delete connection;
   }
   connections_.clear();
+  connection_index_.Clear();
 }
 
 void Port::set_timeout_delay(int delay) {
@@ -728,6 +770,11 @@ bool Port::CanHandleIncomingPacketsFrom(const rtc::SocketAddress&) const {
   return false;
 }
 
+const StunMessageIntegrityKey& Port::integrity_key() {
+  integrity_key_.SetPassword(password_);
+  return integrity_key_;
+}
+
 void Port::SendBindingErrorResponse(StunMessage* message,
                                     const rtc::SocketAddress& addr,
                                     int error_code,
@@ -912,6 +959,7 @@ bool Port::OnConnectionDestroyed(Connection* conn) {
     RTC_DCHECK_NOTREACHED() << "Calling Destroy recursively?";
     return false;
   }
+  connection_index_.Erase(conn->remote_candidate().address());
 
   HandleConnectionDestroyed(conn);
 
@@ -35,6 +35,7 @@
 #include "p2p/base/connection_info.h"
 #include "p2p/base/p2p_constants.h"
 #include "p2p/base/port_interface.h"
+#include "p2p/base/remote_address_index.h"
 #include "p2p/base/stun_request.h"
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/callback_list.h"
@@ -257,6 +258,9 @@ class Port : public PortInterface, public sigslot::has_slots<> {
 
   const std::string username_fragment() const;
   const std::string& password() const { return password_; }
+  // Returns the key for `password_`, rekeyed if the password changed. Shared
+  // by the connections of this port to sign their responses.
+  const StunMessageIntegrityKey& integrity_key();
 
   // May be called when this port was initially created by a pooled
   // PortAllocatorSession, and is now being assigned to an ICE transport.
@@ -438,6 +442,19 @@ class Port : public PortInterface, public sigslot::has_slots<> {
                       const rtc::SocketAddress& addr,
                       std::unique_ptr<IceMessage>* out_msg,
                       std::string* out_username);
+  // Same as above, for a message that has already been parsed into `view`.
+  bool GetStunMessage(const StunMessageView& view,
+                      const rtc::SocketAddress& addr,
+                      std::unique_ptr<IceMessage>* out_msg,
+                      std::string* out_username);
+
+  // Checks a binding or GOOG_PING request in place, without parsing it into an
+  // IceMessage. Returns true if GetStunMessage() would accept `view` without
+  // sending an error response; attributes that aren't comprehended are not
+  // checked for. For binding requests, `remote_ufrag` is set to the remote
+  // fragment of the username, which points into the message.
+  bool ValidateStunRequest(const StunMessageView& view,
+                           absl::string_view* remote_ufrag);
 
   // Checks if the address in addr is compatible with the port's ip.
   bool IsCompatibleAddress(const rtc::SocketAddress& addr);
@@ -502,8 +519,13 @@ class Port : public PortInterface, public sigslot::has_slots<> {
   // username_fragment().
   std::string ice_username_fragment_;
   std::string password_;
+  // Authenticates the connectivity checks received with `password_`.
+  StunMessageIntegrityKey integrity_key_;
   std::vector<Candidate> candidates_ RTC_GUARDED_BY(thread_);
   AddressMap connections_;
+  // Indexes the connections in `connections_` with a resolved remote address
+  // for GetConnection().
+  RemoteAddressIndex<Connection> connection_index_;
   int timeout_delay_;
   bool enable_port_packets_;
   IceRole ice_role_;
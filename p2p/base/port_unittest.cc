@@ -3314,6 +3314,74 @@ INSTANTIATE_TEST_SUITE_P(GoogPingTest,
                                            std::make_pair(false, true),
                                            std::make_pair(true, true)));
 
+// Checks that binding and GOOG_PING requests on an existing connection are
+// answered, including when they fail the checks and take the full path.
+TEST_F(PortTest, TestConnectivityChecksOnExistingConnection) {
+  auto port1_unique =
+      CreateTestPort(kLocalAddr1, "lfrag", "lpass",
+                     cricket::ICEROLE_CONTROLLING, kTiebreaker1);
+  auto* port1 = port1_unique.get();
+  auto port2 = CreateTestPort(kLocalAddr2, "rfrag", "rpass",
+                              cricket::ICEROLE_CONTROLLED, kTiebreaker2);
+
+  TestChannel ch1(std::move(port1_unique));
+  ch1.Start();
+  port2->PrepareAddress();
+  ASSERT_EQ_WAIT(1, ch1.complete_count(), kDefaultTimeout);
+  ASSERT_FALSE(port2->Candidates().empty());
+  ch1.CreateConnection(GetCandidate(port2.get()));
+  ASSERT_TRUE(ch1.conn() != nullptr);
+  ch1.conn()->set_use_candidate_attr(true);
+
+  ch1.Ping();
+  ASSERT_TRUE_WAIT(port1->last_stun_msg() != nullptr, kDefaultTimeout);
+  const std::string request_id = port1->last_stun_msg()->transaction_id();
+  auto* con = port2->CreateConnection(port1->Candidates()[0],
+                                      cricket::Port::ORIGIN_MESSAGE);
+  con->OnReadPacket(port1->last_stun_buf()->data<char>(),
+                    port1->last_stun_buf()->size(), /*packet_time_us=*/-1);
+
+  IceMessage* response = port2->last_stun_msg();
+  ASSERT_TRUE(response != nullptr);
+  EXPECT_EQ(STUN_BINDING_RESPONSE, response->type());
+  EXPECT_EQ(request_id, response->transaction_id());
+  EXPECT_EQ(StunMessage::IntegrityStatus::kIntegrityOk,
+            response->ValidateMessageIntegrity("rpass"));
+  const StunAddressAttribute* mapped_address =
+      response->GetAddress(STUN_ATTR_XOR_MAPPED_ADDRESS);
+  ASSERT_TRUE(mapped_address != nullptr);
+  EXPECT_EQ(kLocalAddr1, mapped_address->GetAddress());
+  EXPECT_EQ(1u, con->stats().recv_ping_requests);
+  EXPECT_TRUE(con->nominated());
+
+  port2->Reset();
+  const std::string ping_id = rtc::CreateRandomString(kStunTransactionIdLength);
+  IceMessage ping(GOOG_PING_REQUEST, ping_id);
+  ping.AddMessageIntegrity32("rpass");
+  rtc::ByteBufferWriter buf;
+  ping.Write(&buf);
+  con->OnReadPacket(buf.Data(), buf.Length(), /*packet_time_us=*/-1);
+  response = port2->last_stun_msg();
+  ASSERT_TRUE(response != nullptr);
+  EXPECT_EQ(GOOG_PING_RESPONSE, response->type());
+  EXPECT_EQ(ping_id, response->transaction_id());
+  EXPECT_EQ(2u, con->stats().recv_ping_requests);
+
+  // A GOOG_PING with a bad M-I gets an error response instead.
+  port2->Reset();
+  IceMessage bad_ping(GOOG_PING_REQUEST, ping_id);
+  bad_ping.AddMessageIntegrity32("lpass");
+  rtc::ByteBufferWriter bad_buf;
+  bad_ping.Write(&bad_buf);
+  con->OnReadPacket(bad_buf.Data(), bad_buf.Length(), /*packet_time_us=*/-1);
+  response = port2->last_stun_msg();
+  ASSERT_TRUE(response != nullptr);
+  EXPECT_EQ(GOOG_PING_ERROR_RESPONSE, response->type());
+  EXPECT_EQ(2u, con->stats().recv_ping_requests);
+
+  ch1.Stop();
+}
+
 // This test checks that a change in attributes falls back to STUN_BINDING
 TEST_F(PortTest, TestChangeInAttributeMakesGoogPingFallsbackToStunBinding) {
   IceFieldTrials trials;
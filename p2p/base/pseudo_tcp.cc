@@ -15,7 +15,9 @@
 #include <string.h>
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <iterator>
 #include <memory>
 #include <set>
 
@@ -115,6 +117,9 @@ const uint32_t DEF_ACK_DELAY = 100;  // 100 milliseconds
 
 const uint8_t FLAG_CTL = 0x02;
 const uint8_t FLAG_RST = 0x04;
+// The payload of an ACK holds SACK blocks instead of data. Only sent to peers
+// that announced TCP_OPT_SACK_PERMITTED.
+const uint8_t FLAG_SACK = 0x08;
 
 const uint8_t CTL_CONNECT = 0;
 
@@ -123,6 +128,17 @@ const uint8_t TCP_OPT_EOL = 0;        // End of list.
 const uint8_t TCP_OPT_NOOP = 1;       // No-op.
 const uint8_t TCP_OPT_MSS = 2;        // Maximum segment size.
 const uint8_t TCP_OPT_WND_SCALE = 3;  // Window scale factor.
+const uint8_t TCP_OPT_SACK_PERMITTED = 4;  // Selective acknowledgements.
+
+// A SACK block is a pair of 32-bit sequence numbers.
+const uint32_t SACK_BLOCK_SIZE = 8;
+// Number of segments reported above a hole before it is considered lost
+// (RFC 6675 DupThresh).
+const uint32_t SACK_DUP_THRESH = 3;
+
+// CUBIC multiplicative decrease factor and scaling constant (RFC 8312).
+const double CUBIC_BETA = 0.7;
+const double CUBIC_C = 0.4;
 
 const long DEFAULT_TIMEOUT =
     4000;  // If there are no pending clocks, wake up every 4 seconds
@@ -224,6 +240,9 @@ PseudoTcp::PseudoTcp(IPseudoTcpNotify* notify, uint32_t conv)
   m_conv = conv;
   m_rcv_wnd = m_rbuf_len;
   m_rwnd_scale = m_swnd_scale = 0;
+  m_rbuf_max_len = 0;
+  m_rcv_adv = 0;
+  m_rlist_latest = 0;
   m_snd_nxt = 0;
   m_snd_wnd = 1;
   m_snd_una = m_rcv_nxt = 0;
@@ -246,6 +265,11 @@ PseudoTcp::PseudoTcp(IPseudoTcpNotify* notify, uint32_t conv)
 
   m_dup_acks = 0;
   m_recover = 0;
+  m_sack_enabled = false;
+
+  m_cc = CC_NEWRENO;
+  m_cubic_w_max = m_cubic_epoch = m_cubic_origin = 0;
+  m_cubic_k = m_cubic_w_est = 0;
 
   m_ts_recent = m_ts_lastack = 0;
 
@@ -255,6 +279,7 @@ PseudoTcp::PseudoTcp(IPseudoTcpNotify* notify, uint32_t conv)
   m_use_nagling = true;
   m_ack_delay = DEF_ACK_DELAY;
   m_support_wnd_scale = true;
+  m_support_sack = true;
 }
 
 PseudoTcp::~PseudoTcp() {}
@@ -304,11 +329,17 @@ void PseudoTcp::NotifyClock(uint32_t now) {
       }
 
       uint32_t nInFlight = m_snd_nxt - m_snd_una;
-      m_ssthresh = std::max(nInFlight / 2, 2 * m_mss);
+      m_ssthresh = onCongestionEvent(nInFlight);
       // RTC_LOG(LS_INFO) << "m_ssthresh: " << m_ssthresh << "  nInFlight: " <<
       // nInFlight << "  m_mss: " << m_mss;
       m_cwnd = m_mss;
 
+      // Retransmissions made during SACK recovery may have been lost too.
+      for (SSegment& sseg : m_slist) {
+        sseg.sack_rexmit = false;
+      }
+      m_slist.front().sack_rexmit = true;
+
       // Back off retransmit timer.  Note: the limit is lower when connecting.
       uint32_t rto_limit = (m_state < TCP_ESTABLISHED) ? DEF_RTO : MAX_RTO;
       m_rx_rto = std::min(rto_limit, m_rx_rto * 2);
@@ -374,6 +405,10 @@ void PseudoTcp::GetOption(Option opt, int* value) {
     *value = m_sbuf_len;
   } else if (opt == OPT_RCVBUF) {
     *value = m_rbuf_len;
+  } else if (opt == OPT_MAX_RCVBUF) {
+    *value = m_rbuf_max_len;
+  } else if (opt == OPT_CONGESTION_CONTROL) {
+    *value = m_cc;
   } else {
     RTC_DCHECK_NOTREACHED();
   }
@@ -389,6 +424,14 @@ void PseudoTcp::SetOption(Option opt, int value) {
   } else if (opt == OPT_RCVBUF) {
     RTC_DCHECK(m_state == TCP_LISTEN);
     resizeReceiveBuffer(value);
+  } else if (opt == OPT_MAX_RCVBUF) {
+    RTC_DCHECK(m_state == TCP_LISTEN);
+    m_rbuf_max_len = value;
+    // Pick the window scale factor for the largest buffer.
+    resizeReceiveBuffer(m_rbuf_len);
+  } else if (opt == OPT_CONGESTION_CONTROL) {
+    RTC_DCHECK(value == CC_NEWRENO || value == CC_CUBIC);
+    m_cc = static_cast<CongestionControl>(value);
   } else {
     RTC_DCHECK_NOTREACHED();
   }
@@ -511,6 +554,14 @@ IPseudoTcpNotify::WriteResult PseudoTcp::packet(uint32_t seq,
   uint32_t now = Now();
 
   std::unique_ptr<uint8_t[]> buffer(new uint8_t[MAX_PACKET]);
+
+  // Report out-of-order data in ACKs, so the peer retransmits only the holes.
+  uint32_t sack_len = 0;
+  if ((len == 0) && m_sack_enabled && !m_rlist.empty()) {
+    sack_len = writeSackBlocks(buffer.get() + HEADER_SIZE);
+    flags |= FLAG_SACK;
+  }
+
   long_to_bytes(m_conv, buffer.get());
   long_to_bytes(seq, buffer.get() + 4);
   long_to_bytes(m_rcv_nxt, buffer.get() + 8);
@@ -524,6 +575,11 @@ IPseudoTcpNotify::WriteResult PseudoTcp::packet(uint32_t seq,
   long_to_bytes(m_ts_recent, buffer.get() + 20);
   m_ts_lastack = m_rcv_nxt;
 
+  // Remember the edge of the advertised window, to see if the peer fills it.
+  if ((m_rbuf_max_len > m_rbuf_len) && (m_rcv_adv == 0)) {
+    m_rcv_adv = m_rcv_nxt + m_rcv_wnd;
+  }
+
   if (len) {
     size_t bytes_read = 0;
     bool result =
@@ -543,7 +599,8 @@ IPseudoTcpNotify::WriteResult PseudoTcp::packet(uint32_t seq,
 #endif  // _DEBUGMSG
 
   IPseudoTcpNotify::WriteResult wres = m_notify->TcpWritePacket(
-      this, reinterpret_cast<char*>(buffer.get()), len + HEADER_SIZE);
+      this, reinterpret_cast<char*>(buffer.get()),
+      len + sack_len + HEADER_SIZE);
   // Note: When len is 0, this is an ACK packet.  We don't read the return value
   // for those, and thus we won't retry.  So go ahead and treat the packet as a
   // success (basically simulate as if it were dropped), which will prevent our
@@ -578,6 +635,19 @@ bool PseudoTcp::parse(const uint8_t* buffer, uint32_t size) {
   seg.data = reinterpret_cast<const char*>(buffer) + HEADER_SIZE;
   seg.len = size - HEADER_SIZE;
 
+  seg.num_sack_blocks = 0;
+  if (seg.flags & FLAG_SACK) {
+    // The payload is not data.
+    for (uint32_t offset = HEADER_SIZE; offset + SACK_BLOCK_SIZE <= size &&
+                                        seg.num_sack_blocks < kMaxSackBlocks;
+         offset += SACK_BLOCK_SIZE) {
+      SackBlock& block = seg.sack_blocks[seg.num_sack_blocks++];
+      block.start = bytes_to_long(buffer + offset);
+      block.end = bytes_to_long(buffer + offset + 4);
+    }
+    seg.len = 0;
+  }
+
 #if _DEBUGMSG >= _DBG_VERBOSE
   RTC_LOG(LS_INFO) << "--> <CONV=" << seg.conv
                    << "><FLG=" << static_cast<unsigned>(seg.flags)
@@ -696,6 +766,10 @@ bool PseudoTcp::process(Segment& seg) {
     m_ts_recent = seg.tsval;
   }
 
+  if ((seg.num_sack_blocks > 0) && m_sack_enabled) {
+    updateScoreboard(seg);
+  }
+
   // Check if this is a valuable ack
   if ((seg.ack > m_snd_una) && (seg.ack <= m_snd_nxt)) {
     // Calculate round-trip time
@@ -736,6 +810,7 @@ bool PseudoTcp::process(Segment& seg) {
     for (uint32_t nFree = nAcked; nFree > 0;) {
       RTC_DCHECK(!m_slist.empty());
       if (nFree < m_slist.front().len) {
+        m_slist.front().seq += nFree;
         m_slist.front().len -= nFree;
         nFree = 0;
       } else {
@@ -755,7 +830,7 @@ bool PseudoTcp::process(Segment& seg) {
         RTC_LOG(LS_INFO) << "exit recovery";
 #endif  // _DEBUGMSG
         m_dup_acks = 0;
-      } else {
+      } else if (!m_sack_enabled) {
 #if _DEBUGMSG >= _DBG_NORMAL
         RTC_LOG(LS_INFO) << "recovery retransmit";
 #endif  // _DEBUGMSG
@@ -765,13 +840,14 @@ bool PseudoTcp::process(Segment& seg) {
         }
         m_cwnd += m_mss - std::min(nAcked, m_cwnd);
       }
+      // With SACK, attemptSend() retransmits the holes that are left.
     } else {
       m_dup_acks = 0;
       // Slow start, congestion avoidance
       if (m_cwnd < m_ssthresh) {
         m_cwnd += m_mss;
       } else {
-        m_cwnd += std::max<uint32_t>(1, m_mss * m_mss / m_cwnd);
+        increaseCongestionWindow(nAcked, now);
       }
     }
   } else if (seg.ack == m_snd_una) {
@@ -795,11 +871,21 @@ bool PseudoTcp::process(Segment& seg) {
         }
         m_recover = m_snd_nxt;
         uint32_t nInFlight = m_snd_nxt - m_snd_una;
-        m_ssthresh = std::max(nInFlight / 2, 2 * m_mss);
+        m_ssthresh = onCongestionEvent(nInFlight);
         // RTC_LOG(LS_INFO) << "m_ssthresh: " << m_ssthresh << "  nInFlight: "
         // << nInFlight << "  m_mss: " << m_mss;
-        m_cwnd = m_ssthresh + 3 * m_mss;
-      } else if (m_dup_acks > 3) {
+        if (m_sack_enabled) {
+          // The scoreboard estimates what is in flight, so the window is not
+          // inflated by the duplicate acks.
+          m_cwnd = m_ssthresh;
+          for (SSegment& sseg : m_slist) {
+            sseg.sack_rexmit = false;
+          }
+          m_slist.front().sack_rexmit = true;
+        } else {
+          m_cwnd = m_ssthresh + 3 * m_mss;
+        }
+      } else if ((m_dup_acks > 3) && !m_sack_enabled) {
         m_cwnd += m_mss;
       }
     } else {
@@ -934,12 +1020,15 @@ bool PseudoTcp::process(Segment& seg) {
         RSegment rseg;
         rseg.seq = seg.seq;
         rseg.len = seg.len;
-        RList::iterator it = m_rlist.begin();
-        while ((it != m_rlist.end()) && (it->seq < rseg.seq)) {
-          ++it;
+        // Segments mostly arrive in order, so search from the back.
+        RList::iterator it = m_rlist.end();
+        while ((it != m_rlist.begin()) && (std::prev(it)->seq >= rseg.seq)) {
+          --it;
         }
         m_rlist.insert(it, rseg);
+        m_rlist_latest = rseg.seq;
       }
+      maybeGrowReceiveBuffer(seg.seq + seg.len);
     }
     if (bRecover) {
       RList::iterator it = m_rlist.begin();
@@ -1048,6 +1137,7 @@ void PseudoTcp::attemptSend(SendFlags sflags) {
 
   if (rtc::TimeDiff32(now, m_lastsend) > static_cast<long>(m_rx_rto)) {
     m_cwnd = m_mss;
+    m_cubic_epoch = 0;
   }
 
 #if _DEBUGMSG
@@ -1063,6 +1153,28 @@ void PseudoTcp::attemptSend(SendFlags sflags) {
     uint32_t nInFlight = m_snd_nxt - m_snd_una;
     uint32_t nUseable = (nInFlight < nWindow) ? (nWindow - nInFlight) : 0;
 
+    if (m_sack_enabled && (m_dup_acks >= 3)) {
+      // Retransmit the holes first, then send new data while the estimated
+      // pipe is below the congestion window.
+      uint32_t nPipe = 0;
+      SList::iterator lost = nextSackRetransmit(&nPipe);
+      if (nPipe >= cwnd) {
+        nUseable = 0;
+      } else if (lost != m_slist.end()) {
+        if (!transmit(lost, now)) {
+          RTC_LOG_F(LS_VERBOSE) << "transmit failed";
+          return;
+        }
+        lost->sack_rexmit = true;
+        sflags = sfNone;
+        continue;
+      } else {
+        nUseable = std::min(cwnd - nPipe, (nInFlight < m_snd_wnd)
+                                              ? (m_snd_wnd - nInFlight)
+                                              : 0);
+      }
+    }
+
     size_t snd_buffered = m_sbuf.GetBuffered();
     uint32_t nAvailable =
         std::min(static_cast<uint32_t>(snd_buffered) - nInFlight, m_mss);
@@ -1163,6 +1275,165 @@ void PseudoTcp::adjustMTU() {
   m_cwnd = std::max(m_cwnd, m_mss);
 }
 
+void PseudoTcp::updateScoreboard(const Segment& seg) {
+  uint32_t nHighest = seg.ack;
+  for (int i = 0; i < seg.num_sack_blocks; ++i) {
+    nHighest = std::max(nHighest, seg.sack_blocks[i].end);
+  }
+  for (SSegment& sseg : m_slist) {
+    if ((sseg.xmit == 0) || (sseg.seq >= nHighest)) {
+      break;
+    }
+    for (int i = 0; !sseg.sacked && (i < seg.num_sack_blocks); ++i) {
+      const SackBlock& block = seg.sack_blocks[i];
+      sseg.sacked =
+          (block.start <= sseg.seq) && (sseg.seq + sseg.len <= block.end);
+    }
+  }
+}
+
+PseudoTcp::SList::iterator PseudoTcp::nextSackRetransmit(uint32_t* pipe) {
+  // Walk down from the highest sequence number, so that the number of
+  // segments reported above each hole is known when reaching it. The first
+  // segment is lost since the recovery started.
+  SList::iterator lost = m_slist.end();
+  uint32_t nSackedAbove = 0;
+  *pipe = 0;
+  for (SList::iterator it = m_slist.end(); it != m_slist.begin();) {
+    --it;
+    if (it->xmit == 0) {
+      continue;
+    }
+    if (it->sacked) {
+      ++nSackedAbove;
+      continue;
+    }
+    bool bLost = (nSackedAbove >= SACK_DUP_THRESH) || (it == m_slist.begin());
+    if (!bLost || it->sack_rexmit) {
+      *pipe += it->len;
+    } else {
+      lost = it;
+    }
+  }
+  return lost;
+}
+
+uint32_t PseudoTcp::writeSackBlocks(uint8_t* buffer) const {
+  RTC_DCHECK(!m_rlist.empty());
+  SackBlock latest = {0, 0};
+  bool bHasLatest = false;
+  SackBlock others[kMaxSackBlocks];
+  int num_others = 0;
+  auto add_block = [&](const SackBlock& block) {
+    if ((block.start <= m_rlist_latest) && (m_rlist_latest < block.end)) {
+      latest = block;
+      bHasLatest = true;
+    } else if (num_others < kMaxSackBlocks) {
+      others[num_others++] = block;
+    }
+  };
+
+  // Merge the out-of-order segments into contiguous blocks.
+  RList::const_iterator it = m_rlist.begin();
+  SackBlock block = {it->seq, it->seq + it->len};
+  for (++it; it != m_rlist.end(); ++it) {
+    if (it->seq <= block.end) {
+      block.end = std::max(block.end, it->seq + it->len);
+    } else {
+      add_block(block);
+      block = {it->seq, it->seq + it->len};
+    }
+  }
+  add_block(block);
+
+  uint32_t len = 0;
+  if (bHasLatest) {
+    long_to_bytes(latest.start, buffer);
+    long_to_bytes(latest.end, buffer + 4);
+    len += SACK_BLOCK_SIZE;
+  }
+  for (int i = 0; (i < num_others) && (len < kMaxSackBlocks * SACK_BLOCK_SIZE);
+       ++i) {
+    long_to_bytes(others[i].start, buffer + len);
+    long_to_bytes(others[i].end, buffer + len + 4);
+    len += SACK_BLOCK_SIZE;
+  }
+  return len;
+}
+
+uint32_t PseudoTcp::onCongestionEvent(uint32_t nInFlight) {
+  if (m_cc != CC_CUBIC) {
+    return std::max(nInFlight / 2, 2 * m_mss);
+  }
+  // Fast convergence: a flow whose window keeps shrinking leaves room to
+  // the others.
+  if (nInFlight < m_cubic_w_max) {
+    m_cubic_w_max = static_cast<uint32_t>(nInFlight * (1 + CUBIC_BETA) / 2);
+  } else {
+    m_cubic_w_max = nInFlight;
+  }
+  m_cubic_epoch = 0;
+  return std::max(static_cast<uint32_t>(nInFlight * CUBIC_BETA), 2 * m_mss);
+}
+
+void PseudoTcp::increaseCongestionWindow(uint32_t nAcked, uint32_t now) {
+  if (m_cc != CC_CUBIC) {
+    m_cwnd += std::max<uint32_t>(1, m_mss * m_mss / m_cwnd);
+    return;
+  }
+
+  if (m_cubic_epoch == 0) {
+    m_cubic_epoch = std::max<uint32_t>(now, 1);
+    m_cubic_origin = std::max(m_cwnd, m_cubic_w_max);
+    m_cubic_k = (m_cwnd < m_cubic_w_max)
+                    ? std::cbrt(static_cast<double>(m_cubic_w_max - m_cwnd) /
+                                m_mss / CUBIC_C)
+                    : 0;
+    m_cubic_w_est = m_cwnd;
+  }
+
+  // The window the cubic function reaches one round trip from now, in bytes.
+  // Its time unit is the second.
+  double t = (rtc::TimeDiff32(now, m_cubic_epoch) + m_rx_srtt) / 1000.0;
+  double target = m_cubic_origin + CUBIC_C * std::pow(t - m_cubic_k, 3) * m_mss;
+  target = std::min(target, 1.5 * m_cwnd);
+
+  // Grow at least as fast as Reno would (the TCP-friendly region).
+  m_cubic_w_est += 3 * (1 - CUBIC_BETA) / (1 + CUBIC_BETA) * m_mss * nAcked /
+                   m_cwnd;
+
+  uint32_t increase = 1;
+  if (target > m_cwnd) {
+    increase = std::max<uint32_t>(
+        1, static_cast<uint32_t>((target - m_cwnd) * nAcked / m_cwnd));
+  }
+  m_cwnd =
+      std::max(m_cwnd + increase, static_cast<uint32_t>(m_cubic_w_est));
+}
+
+void PseudoTcp::maybeGrowReceiveBuffer(uint32_t seg_end) {
+  // The advertised window is rounded down to the scale factor, and the peer
+  // doesn't send less than a segment to fill it.
+  if ((m_rcv_adv == 0) ||
+      (seg_end + m_mss + (1 << m_rwnd_scale) < m_rcv_adv)) {
+    return;
+  }
+  m_rcv_adv = 0;
+  if ((m_rbuf_len >= m_rbuf_max_len) ||
+      (m_rbuf.GetBuffered() > m_rbuf_len / 2)) {
+    return;
+  }
+
+  uint32_t new_size = std::min(2 * m_rbuf_len, m_rbuf_max_len);
+  new_size = (new_size >> m_rwnd_scale) << m_rwnd_scale;
+  if ((new_size <= m_rbuf_len) || !m_rbuf.SetCapacity(new_size)) {
+    return;
+  }
+  m_rcv_wnd += new_size - m_rbuf_len;
+  m_rbuf_len = new_size;
+  RTC_LOG(LS_VERBOSE) << "Receive buffer grown to " << m_rbuf_len;
+}
+
 bool PseudoTcp::isReceiveBufferFull() const {
   size_t available_space = 0;
   m_rbuf.GetWriteRemaining(&available_space);
@@ -1173,6 +1444,10 @@ void PseudoTcp::disableWindowScale() {
   m_support_wnd_scale = false;
 }
 
+void PseudoTcp::disableSack() {
+  m_support_sack = false;
+}
+
 void PseudoTcp::queueConnectMessage() {
   rtc::ByteBufferWriter buf;
 
@@ -1182,6 +1457,10 @@ void PseudoTcp::queueConnectMessage() {
     buf.WriteUInt8(1);
     buf.WriteUInt8(m_rwnd_scale);
   }
+  if (m_support_sack) {
+    buf.WriteUInt8(TCP_OPT_SACK_PERMITTED);
+    buf.WriteUInt8(0);
+  }
   m_snd_wnd = static_cast<uint32_t>(buf.Length());
   queue(buf.Data(), static_cast<uint32_t>(buf.Length()), true);
 }
@@ -1226,10 +1505,16 @@ void PseudoTcp::parseOptions(const char* data, uint32_t len) {
     if (m_rwnd_scale > 0) {
       // Peer doesn't support TCP options and window scaling.
       // Revert receive buffer size to default value.
+      m_rbuf_max_len = 0;
       resizeReceiveBuffer(DEFAULT_RCV_BUF_SIZE);
       m_swnd_scale = 0;
     }
   }
+
+  // Peers that don't know about SACK blocks would take them for data.
+  m_sack_enabled = m_support_sack && (options_specified.find(
+                                          TCP_OPT_SACK_PERMITTED) !=
+                                      options_specified.end());
 }
 
 void PseudoTcp::applyOption(char kind, const char* data, uint32_t len) {
@@ -1244,6 +1529,12 @@ void PseudoTcp::applyOption(char kind, const char* data, uint32_t len) {
       return;
     }
     applyWindowScaleOption(data[0]);
+  } else if (kind == TCP_OPT_SACK_PERMITTED) {
+    // Selective acknowledgements.
+    // http://www.ietf.org/rfc/rfc2018.txt
+    if (len != 0) {
+      RTC_LOG_F(LS_WARNING) << "Invalid SACK permitted option received.";
+    }
   }
 }
 
@@ -1260,14 +1551,14 @@ void PseudoTcp::resizeReceiveBuffer(uint32_t new_size) {
   uint8_t scale_factor = 0;
 
   // Determine the scale factor such that the scaled window size can fit
-  // in a 16-bit unsigned integer.
-  while (new_size > 0xFFFF) {
+  // in a 16-bit unsigned integer, also after the buffer has grown.
+  for (uint32_t max_size = std::max(new_size, m_rbuf_max_len);
+       max_size > 0xFFFF; max_size >>= 1) {
     ++scale_factor;
-    new_size >>= 1;
   }
 
   // Determine the proper size of the buffer.
-  new_size <<= scale_factor;
+  new_size = (new_size >> scale_factor) << scale_factor;
   bool result = m_rbuf.SetCapacity(new_size);
 
   // Make sure the new buffer is large enough to contain data in the old
@@ -1277,7 +1568,7 @@ void PseudoTcp::resizeReceiveBuffer(uint32_t new_size) {
   RTC_DCHECK(result);
   m_rbuf_len = new_size;
   m_rwnd_scale = scale_factor;
-  m_ssthresh = new_size;
+  m_ssthresh = std::max(new_size, m_rbuf_max_len);
 
   size_t available_space = 0;
   m_rbuf.GetWriteRemaining(&available_space);
@@ -1304,7 +1595,9 @@ bool PseudoTcp::LockedFifoBuffer::SetCapacity(size_t size) {
 
   if (size != buffer_length_) {
     char* buffer = new char[size];
-    const size_t copy = data_length_;
+    // When growing, also keep the data written past the readable data with
+    // WriteOffset().
+    const size_t copy = (size > buffer_length_) ? buffer_length_ : data_length_;
     const size_t tail_copy = std::min(copy, buffer_length_ - read_position_);
     memcpy(buffer, &buffer_[read_position_], tail_copy);
     memcpy(buffer + tail_copy, &buffer_[0], copy - tail_copy);
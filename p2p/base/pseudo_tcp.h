@@ -91,17 +91,29 @@ class RTC_EXPORT PseudoTcp {
   // instance's behaviour for the kind of data it will carry.
   // If an unrecognized option is set or got, an assertion will fire.
   //
-  // Setting options for OPT_RCVBUF or OPT_SNDBUF after Connect() is called
-  // will result in an assertion.
+  // Setting options for OPT_RCVBUF, OPT_SNDBUF or OPT_MAX_RCVBUF after
+  // Connect() is called will result in an assertion.
   enum Option {
     OPT_NODELAY,   // Whether to enable Nagle's algorithm (0 == off)
     OPT_ACKDELAY,  // The Delayed ACK timeout (0 == off).
     OPT_RCVBUF,    // Set the receive buffer size, in bytes.
     OPT_SNDBUF,    // Set the send buffer size, in bytes.
+    // The size, in bytes, up to which the receive buffer grows while the
+    // peer sends as fast as the advertised window allows (0 == off). The
+    // window scale factor is sized for it when connecting.
+    OPT_MAX_RCVBUF,
+    OPT_CONGESTION_CONTROL,  // A CongestionControl value.
   };
   void GetOption(Option opt, int* value);
   void SetOption(Option opt, int value);
 
+  enum CongestionControl {
+    CC_NEWRENO,  // The default.
+    // CUBIC (RFC 8312) window growth, which recovers from losses faster on
+    // paths with a large bandwidth-delay product.
+    CC_CUBIC,
+  };
+
   // Returns current congestion window in bytes.
   uint32_t GetCongestionWindow() const;
 
@@ -119,6 +131,13 @@ class RTC_EXPORT PseudoTcp {
  protected:
   enum SendFlags { sfNone, sfDelayedAck, sfImmediateAck };
 
+  // Maximum number of SACK blocks sent in an ACK.
+  static constexpr int kMaxSackBlocks = 4;
+
+  struct SackBlock {
+    uint32_t start, end;
+  };
+
   struct Segment {
     uint32_t conv, seq, ack;
     uint8_t flags;
@@ -126,15 +145,27 @@ class RTC_EXPORT PseudoTcp {
     const char* data;
     uint32_t len;
     uint32_t tsval, tsecr;
+    // Data the peer has received above `ack`, if it sent SACK blocks.
+    SackBlock sack_blocks[kMaxSackBlocks];
+    int num_sack_blocks;
   };
 
   struct SSegment {
     SSegment(uint32_t s, uint32_t l, bool c)
-        : seq(s), len(l), /*tstamp(0),*/ xmit(0), bCtrl(c) {}
+        : seq(s),
+          len(l),
+          /*tstamp(0),*/ xmit(0),
+          bCtrl(c),
+          sacked(false),
+          sack_rexmit(false) {}
     uint32_t seq, len;
     // uint32_t tstamp;
     uint8_t xmit;
     bool bCtrl;
+    // Reported received by a SACK block.
+    bool sacked;
+    // Retransmitted during the current SACK based recovery.
+    bool sack_rexmit;
   };
   typedef std::list<SSegment> SList;
 
@@ -169,6 +200,31 @@ class RTC_EXPORT PseudoTcp {
 
   void adjustMTU();
 
+  // Marks the segments covered by the SACK blocks of `seg` as received.
+  void updateScoreboard(const Segment& seg);
+
+  // Returns the first segment to retransmit during SACK based recovery, or
+  // m_slist.end() if there is none, and sets `pipe` to the number of bytes
+  // estimated to be in flight (RFC 6675).
+  SList::iterator nextSackRetransmit(uint32_t* pipe);
+
+  // Writes SACK blocks for the out-of-order data in `m_rlist` to `buffer`,
+  // the one containing the latest segment first. Returns the bytes written.
+  uint32_t writeSackBlocks(uint8_t* buffer) const;
+
+  // Returns the slow start threshold after a loss while `nInFlight` bytes
+  // were in flight, and updates the congestion control state.
+  uint32_t onCongestionEvent(uint32_t nInFlight);
+
+  // Grows the congestion window in congestion avoidance for `nAcked` newly
+  // acknowledged bytes.
+  void increaseCongestionWindow(uint32_t nAcked, uint32_t now);
+
+  // Doubles the receive buffer, up to `m_rbuf_max_len`, when the segment
+  // ending at `seg_end` reached the advertised window while the application
+  // keeps up with reading.
+  void maybeGrowReceiveBuffer(uint32_t seg_end);
+
  protected:
   // This method is used in test only to query receive buffer state.
   bool isReceiveBufferFull() const;
@@ -177,6 +233,10 @@ class RTC_EXPORT PseudoTcp {
   // support for testing backward compatibility.
   void disableWindowScale();
 
+  // This method is only used in tests, to disable selective
+  // acknowledgements for testing backward compatibility.
+  void disableSack();
+
  private:
   // Queue the connect message with TCP options.
   void queueConnectMessage();
@@ -194,7 +254,8 @@ class RTC_EXPORT PseudoTcp {
   void resizeSendBuffer(uint32_t new_size);
 
   // Resize the receive buffer with `new_size` in bytes. This call adjusts
-  // window scale factor `m_swnd_scale` accordingly.
+  // window scale factor `m_swnd_scale` accordingly, leaving room for the
+  // buffer to grow up to `m_rbuf_max_len`.
   void resizeReceiveBuffer(uint32_t new_size);
 
   class LockedFifoBuffer final {
@@ -257,6 +318,11 @@ class RTC_EXPORT PseudoTcp {
   uint32_t m_rbuf_len, m_rcv_nxt, m_rcv_wnd, m_lastrecv;
   uint8_t m_rwnd_scale;  // Window scale factor.
   LockedFifoBuffer m_rbuf;
+  // Receive buffer auto-tuning limit, and right edge of the last advertised
+  // window.
+  uint32_t m_rbuf_max_len, m_rcv_adv;
+  // Sequence number of the last segment saved to `m_rlist`.
+  uint32_t m_rlist_latest;
 
   // Outgoing data
   SList m_slist;
@@ -277,10 +343,22 @@ class RTC_EXPORT PseudoTcp {
 
   // Congestion avoidance, Fast retransmit/recovery, Delayed ACKs
   uint32_t m_ssthresh, m_cwnd;
-  uint8_t m_dup_acks;
+  uint32_t m_dup_acks;
   uint32_t m_recover;
   uint32_t m_t_ack;
 
+  // Selective acknowledgements, used when both sides support them.
+  bool m_sack_enabled;
+
+  // CUBIC state: window before the last reduction, start of the current
+  // congestion avoidance epoch (0 if none), the window the cubic function
+  // grows back to, the time it takes to get there, and the window a Reno
+  // flow would have.
+  CongestionControl m_cc;
+  uint32_t m_cubic_w_max, m_cubic_epoch, m_cubic_origin;
+  double m_cubic_k;
+  double m_cubic_w_est;
+
   // Configuration options
   bool m_use_nagling;
   uint32_t m_ack_delay;
@@ -288,6 +366,7 @@ class RTC_EXPORT PseudoTcp {
   // This is used by unit tests to test backward compatibility of
   // PseudoTcp implementations that don't support window scaling.
   bool m_support_wnd_scale;
+  bool m_support_sack;
 };
 
 }  // namespace cricket
@@ -21,6 +21,8 @@
 #include "api/task_queue/pending_task_safety_flag.h"
 #include "api/task_queue/task_queue_base.h"
 #include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/fake_clock.h"
 #include "rtc_base/gunit.h"
 #include "rtc_base/helpers.h"
 #include "rtc_base/logging.h"
@@ -35,6 +37,7 @@ using ::webrtc::TimeDelta;
 
 static const int kConnectTimeoutMs = 10000;  // ~3 * default RTO of 3000ms
 static const int kTransferTimeoutMs = 15000;
+static const int kSimulatedTransferTimeoutMs = 600000;
 static const int kBlockSize = 4096;
 
 class PseudoTcpForTest : public cricket::PseudoTcp {
@@ -45,6 +48,8 @@ class PseudoTcpForTest : public cricket::PseudoTcp {
   bool isReceiveBufferFull() const { return PseudoTcp::isReceiveBufferFull(); }
 
   void disableWindowScale() { PseudoTcp::disableWindowScale(); }
+
+  void disableSack() { PseudoTcp::disableSack(); }
 };
 
 class PseudoTcpTestBase : public ::testing::Test,
@@ -102,8 +107,18 @@ class PseudoTcpTestBase : public ::testing::Test,
   void SetLocalOptRcvBuf(int size) {
     local_.SetOption(PseudoTcp::OPT_RCVBUF, size);
   }
+  void SetOptMaxRcvBuf(int size) {
+    local_.SetOption(PseudoTcp::OPT_MAX_RCVBUF, size);
+    remote_.SetOption(PseudoTcp::OPT_MAX_RCVBUF, size);
+  }
+  void SetOptCongestionControl(PseudoTcp::CongestionControl cc) {
+    local_.SetOption(PseudoTcp::OPT_CONGESTION_CONTROL, cc);
+    remote_.SetOption(PseudoTcp::OPT_CONGESTION_CONTROL, cc);
+  }
   void DisableRemoteWindowScale() { remote_.disableWindowScale(); }
   void DisableLocalWindowScale() { local_.disableWindowScale(); }
+  void DisableRemoteSack() { remote_.disableSack(); }
+  void DisableLocalSack() { local_.disableSack(); }
 
  protected:
   int Connect() {
@@ -225,7 +240,8 @@ class PseudoTcpTestBase : public ::testing::Test,
 
 class PseudoTcpTest : public PseudoTcpTestBase {
  public:
-  void TestTransfer(int size) {
+  // Returns the throughput in Kbps. Time is simulated with `clock`, if set.
+  int TestTransfer(int size, rtc::ScopedFakeClock* clock = nullptr) {
     uint32_t start;
     int32_t elapsed;
     size_t received;
@@ -241,11 +257,17 @@ class PseudoTcpTest : public PseudoTcpTestBase {
     // Connect and wait until connected.
     start = rtc::Time32();
     EXPECT_EQ(0, Connect());
-    EXPECT_TRUE_WAIT(have_connected_, kConnectTimeoutMs);
     // Sending will start from OnTcpWriteable and complete when all data has
     // been received.
-    EXPECT_TRUE_WAIT(have_disconnected_, kTransferTimeoutMs);
-    elapsed = rtc::Time32() - start;
+    if (clock) {
+      EXPECT_TRUE_SIMULATED_WAIT(have_connected_, kConnectTimeoutMs, *clock);
+      EXPECT_TRUE_SIMULATED_WAIT(have_disconnected_,
+                                 kSimulatedTransferTimeoutMs, *clock);
+    } else {
+      EXPECT_TRUE_WAIT(have_connected_, kConnectTimeoutMs);
+      EXPECT_TRUE_WAIT(have_disconnected_, kTransferTimeoutMs);
+    }
+    elapsed = std::max<int32_t>(rtc::Time32() - start, 1);
     recv_stream_.GetSize(&received);
     // Ensure we closed down OK and we got the right data.
     // TODO(?): Ensure the errors are cleared properly.
@@ -256,6 +278,7 @@ class PseudoTcpTest : public PseudoTcpTestBase {
               memcmp(send_stream_.GetBuffer(), recv_stream_.GetBuffer(), size));
     RTC_LOG(LS_INFO) << "Transferred " << received << " bytes in " << elapsed
                      << " ms (" << size * 8 / elapsed << " Kbps)";
+    return size * 8 / elapsed;
   }
 
  private:
@@ -578,6 +601,32 @@ class PseudoTcpTestReceiveWindow : public PseudoTcpTestBase {
   std::vector<size_t> recv_position_;
 };
 
+// Measures bulk transfers over a link with a 100 ms RTT, in simulated time so
+// that large transfers over slow links finish quickly.
+class PseudoTcpThroughputTest : public PseudoTcpTest {
+ public:
+  PseudoTcpThroughputTest() {
+    // The endpoints have already read the real clock.
+    clock_.SetTime(webrtc::Timestamp::Millis(rtc::SystemTimeMillis()));
+    SetLocalMtu(1500);
+    SetRemoteMtu(1500);
+    SetDelay(50);
+  }
+
+  int TestTransfer(int size) {
+    return PseudoTcpTest::TestTransfer(size, &clock_);
+  }
+
+  int GetRemoteRcvBuf() {
+    int size = 0;
+    remote_.GetOption(PseudoTcp::OPT_RCVBUF, &size);
+    return size;
+  }
+
+ protected:
+  rtc::ScopedFakeClock clock_;
+};
+
 // Basic end-to-end data transfer tests
 
 // Test the normal case of sending data from one side to the other.
@@ -738,6 +787,44 @@ TEST_F(PseudoTcpTest, TestSendVerySmallReceiveBuffer) {
   TestTransfer(100000);
 }
 
+// Test packet loss with a sender that doesn't support SACK.
+TEST_F(PseudoTcpTest, TestSendWithLossLocalNoSack) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetLoss(10);
+  DisableLocalSack();
+  TestTransfer(100000);
+}
+
+// Test packet loss with a receiver that doesn't support SACK.
+TEST_F(PseudoTcpTest, TestSendWithLossRemoteNoSack) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetLoss(10);
+  DisableRemoteSack();
+  TestTransfer(100000);
+}
+
+// Test packet loss with CUBIC congestion control.
+TEST_F(PseudoTcpTest, TestSendWithLossAndCubic) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetLoss(10);
+  SetOptCongestionControl(PseudoTcp::CC_CUBIC);
+  TestTransfer(100000);
+}
+
+// Test a receive buffer that grows, while data is received out of order.
+TEST_F(PseudoTcpTest, TestSendWithLossAndGrowingReceiveBuffer) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetDelay(10);
+  SetLoss(5);
+  SetOptSndBuf(1000000);
+  SetOptMaxRcvBuf(1000000);
+  TestTransfer(1000000);
+}
+
 // Ping-pong (request/response) tests
 
 // Test sending <= 1x MTU of data in each ping/pong.  Should take <10ms.
@@ -842,6 +929,47 @@ TEST_F(PseudoTcpTestReceiveWindow, TestSetReceiveWindowSize) {
   EXPECT_EQ(100000u, EstimateReceiveWindowSize());
 }
 
+// Throughput tests over a 100 ms RTT. The throughput of each transfer is
+// logged, for comparison.
+
+// Test a loss-free link, where the default 60 KB receive buffer caps the
+// throughput at 60 KB per round trip.
+TEST_F(PseudoTcpThroughputTest, TestHighBdpLink) {
+  TestTransfer(4000000);
+}
+
+// Test that a growing receive buffer lifts that cap.
+TEST_F(PseudoTcpThroughputTest, TestHighBdpLinkWithGrowingReceiveBuffer) {
+  SetOptSndBuf(4000000);
+  SetOptMaxRcvBuf(4000000);
+  EXPECT_GT(TestTransfer(4000000), 60 * 1024 * 8 / 100);
+  EXPECT_GT(GetRemoteRcvBuf(), 60 * 1024);
+}
+
+// Test 3% packet loss with the NewReno recovery of peers that don't support
+// SACK.
+TEST_F(PseudoTcpThroughputTest, TestLossyLinkWithoutSack) {
+  SetLoss(3);
+  DisableLocalSack();
+  DisableRemoteSack();
+  TestTransfer(4000000);
+}
+
+// Test 3% packet loss with selective retransmissions.
+TEST_F(PseudoTcpThroughputTest, TestLossyLinkWithSack) {
+  SetLoss(3);
+  TestTransfer(4000000);
+}
+
+// Test 3% packet loss with SACK, CUBIC and a growing receive buffer.
+TEST_F(PseudoTcpThroughputTest, TestLossyLinkWithSackAndCubic) {
+  SetLoss(3);
+  SetOptSndBuf(4000000);
+  SetOptMaxRcvBuf(4000000);
+  SetOptCongestionControl(PseudoTcp::CC_CUBIC);
+  TestTransfer(4000000);
+}
+
 /* Test sending data with mismatched MTUs. We should detect this and reduce
 // our packet size accordingly.
 // TODO(?): This doesn't actually work right now. The current code
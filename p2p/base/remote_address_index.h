@@ -0,0 +1,208 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_REMOTE_ADDRESS_INDEX_H_
+#define P2P_BASE_REMOTE_ADDRESS_INDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/socket_address.h"
+
+namespace cricket {
+
+// Maps remote addresses with a resolved IP to objects, e.g. the connections of
+// a port, for the lookup that runs on every received packet. It is a flat
+// open-addressing hash table with linear probing, keyed on the address family,
+// the IP bytes and the port, so that unlike comparing SocketAddresses, lookups
+// never compare hostnames. The last hit is cached, since most ports have a
+// single active connection.
+template <typename T>
+class RemoteAddressIndex {
+ public:
+  RemoteAddressIndex() = default;
+  RemoteAddressIndex(const RemoteAddressIndex&) = delete;
+  RemoteAddressIndex& operator=(const RemoteAddressIndex&) = delete;
+
+  // Returns true if `address` can be indexed. Addresses with an unspecified
+  // or any IP are compared by hostname and must be looked up elsewhere.
+  static bool IsIndexable(const rtc::SocketAddress& address) {
+    return !rtc::IPIsUnspec(address.ipaddr()) &&
+           !rtc::IPIsAny(address.ipaddr());
+  }
+
+  // Maps `address` to `value`, replacing any previous value.
+  void Insert(const rtc::SocketAddress& address, T* value) {
+    RTC_DCHECK(IsIndexable(address));
+    RTC_DCHECK(value);
+    if ((size_ + 1) * 4 > slots_.size() * 3) {
+      Rehash(slots_.empty() ? kMinCapacity : 2 * slots_.size());
+    }
+    const Key key = MakeKey(address);
+    const size_t mask = slots_.size() - 1;
+    for (size_t i = Hash(key) & mask;; i = (i + 1) & mask) {
+      Slot& slot = slots_[i];
+      if (!slot.value) {
+        slot.key = key;
+        slot.value = value;
+        ++size_;
+        break;
+      }
+      if (slot.key == key) {
+        slot.value = value;
+        break;
+      }
+    }
+    last_value_ = nullptr;
+  }
+
+  // Returns false if `address` was not mapped.
+  bool Erase(const rtc::SocketAddress& address) {
+    if (size_ == 0) {
+      return false;
+    }
+    const Key key = MakeKey(address);
+    size_t i = FindSlot(key);
+    if (i == kNotFound) {
+      return false;
+    }
+    // Shift the following entries of the probe sequence back into the hole,
+    // unless they are before their home slot.
+    const size_t mask = slots_.size() - 1;
+    slots_[i].value = nullptr;
+    for (size_t j = (i + 1) & mask; slots_[j].value; j = (j + 1) & mask) {
+      const size_t home = Hash(slots_[j].key) & mask;
+      if (((j - home) & mask) >= ((j - i) & mask)) {
+        slots_[i] = slots_[j];
+        slots_[j].value = nullptr;
+        i = j;
+      }
+    }
+    --size_;
+    last_value_ = nullptr;
+    return true;
+  }
+
+  // Returns the value mapped to `address`, or null.
+  T* Find(const rtc::SocketAddress& address) const {
+    if (size_ == 0) {
+      return nullptr;
+    }
+    const Key key = MakeKey(address);
+    if (last_value_ && key == last_key_) {
+      return last_value_;
+    }
+    const size_t i = FindSlot(key);
+    if (i == kNotFound) {
+      return nullptr;
+    }
+    last_key_ = key;
+    last_value_ = slots_[i].value;
+    return last_value_;
+  }
+
+  void Clear() {
+    slots_.clear();
+    size_ = 0;
+    last_value_ = nullptr;
+  }
+
+  size_t size() const { return size_; }
+
+ private:
+  static constexpr size_t kMinCapacity = 8;
+  static constexpr size_t kNotFound = static_cast<size_t>(-1);
+
+  struct Key {
+    bool operator==(const Key& other) const {
+      return ip_high == other.ip_high && ip_low == other.ip_low &&
+             family_and_port == other.family_and_port;
+    }
+
+    // IPv4 addresses only use the low word.
+    uint64_t ip_high = 0;
+    uint64_t ip_low = 0;
+    uint32_t family_and_port = 0;
+  };
+
+  struct Slot {
+    Key key;
+    // Null for empty slots.
+    T* value = nullptr;
+  };
+
+  static Key MakeKey(const rtc::SocketAddress& address) {
+    Key key;
+    const rtc::IPAddress& ip = address.ipaddr();
+    if (ip.family() == AF_INET) {
+      const in_addr ipv4 = ip.ipv4_address();
+      memcpy(&key.ip_low, &ipv4, sizeof(ipv4));
+    } else if (ip.family() == AF_INET6) {
+      const in6_addr ipv6 = ip.ipv6_address();
+      static_assert(sizeof(ipv6) == 2 * sizeof(uint64_t), "");
+      memcpy(&key.ip_high, &ipv6, sizeof(uint64_t));
+      memcpy(&key.ip_low, reinterpret_cast<const char*>(&ipv6) + 8,
+             sizeof(uint64_t));
+    }
+    key.family_and_port =
+        (static_cast<uint32_t>(ip.family()) << 16) | address.port();
+    return key;
+  }
+
+  static size_t Hash(const Key& key) {
+    uint64_t h = (key.ip_high * 0x9E3779B97F4A7C15ull) ^ key.ip_low;
+    h = (h ^ key.family_and_port) * 0xFF51AFD7ED558CCDull;
+    return static_cast<size_t>(h ^ (h >> 32));
+  }
+
+  size_t FindSlot(const Key& key) const {
+    const size_t mask = slots_.size() - 1;
+    for (size_t i = Hash(key) & mask;; i = (i + 1) & mask) {
+      const Slot& slot = slots_[i];
+      if (!slot.value) {
+        return kNotFound;
+      }
+      if (slot.key == key) {
+        return i;
+      }
+    }
+  }
+
+  void Rehash(size_t capacity) {
+    std::vector<Slot> old_slots(capacity);
+    old_slots.swap(slots_);
+    const size_t mask = capacity - 1;
+    for (const Slot& old_slot : old_slots) {
+      if (!old_slot.value) {
+        continue;
+      }
+      size_t i = Hash(old_slot.key) & mask;
+      while (slots_[i].value) {
+        i = (i + 1) & mask;
+      }
+      slots_[i] = old_slot;
+    }
+  }
+
+  // The capacity is a power of two.
+  std::vector<Slot> slots_;
+  size_t size_ = 0;
+  mutable Key last_key_;
+  mutable T* last_value_ = nullptr;
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_REMOTE_ADDRESS_INDEX_H_
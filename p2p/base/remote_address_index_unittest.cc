@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/remote_address_index.h"
+
+#include <map>
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace cricket {
+namespace {
+
+TEST(RemoteAddressIndexTest, InsertFindAndErase) {
+  RemoteAddressIndex<int> index;
+  int a = 0, b = 0;
+  const rtc::SocketAddress kAddr("1.2.3.4", 5000);
+  EXPECT_EQ(nullptr, index.Find(kAddr));
+  index.Insert(kAddr, &a);
+  EXPECT_EQ(&a, index.Find(kAddr));
+  EXPECT_EQ(&a, index.Find(kAddr));
+  EXPECT_EQ(nullptr, index.Find(rtc::SocketAddress("1.2.3.4", 5001)));
+  EXPECT_EQ(nullptr, index.Find(rtc::SocketAddress("1.2.3.5", 5000)));
+
+  // Replacing updates the cached last hit.
+  index.Insert(kAddr, &b);
+  EXPECT_EQ(1u, index.size());
+  EXPECT_EQ(&b, index.Find(kAddr));
+
+  EXPECT_TRUE(index.Erase(kAddr));
+  EXPECT_FALSE(index.Erase(kAddr));
+  EXPECT_EQ(nullptr, index.Find(kAddr));
+  EXPECT_EQ(0u, index.size());
+}
+
+TEST(RemoteAddressIndexTest, FamiliesAreDistinct) {
+  RemoteAddressIndex<int> index;
+  int v4 = 0, v6 = 0;
+  index.Insert(rtc::SocketAddress("1.2.3.4", 5000), &v4);
+  index.Insert(rtc::SocketAddress("::ffff:1.2.3.4", 5000), &v6);
+  EXPECT_EQ(&v4, index.Find(rtc::SocketAddress("1.2.3.4", 5000)));
+  EXPECT_EQ(&v6, index.Find(rtc::SocketAddress("::ffff:1.2.3.4", 5000)));
+  EXPECT_EQ(nullptr, index.Find(rtc::SocketAddress("::1.2.3.4", 5000)));
+}
+
+TEST(RemoteAddressIndexTest, UnresolvedAddressesAreNotIndexable) {
+  EXPECT_TRUE(RemoteAddressIndex<int>::IsIndexable(
+      rtc::SocketAddress("1.2.3.4", 5000)));
+  EXPECT_TRUE(RemoteAddressIndex<int>::IsIndexable(
+      rtc::SocketAddress("2001:db8::1", 5000)));
+  EXPECT_FALSE(RemoteAddressIndex<int>::IsIndexable(
+      rtc::SocketAddress("host.local", 5000)));
+  EXPECT_FALSE(RemoteAddressIndex<int>::IsIndexable(
+      rtc::SocketAddress("0.0.0.0", 5000)));
+}
+
+// Compares against std::map through growth and erasures, which move entries
+// within probe sequences.
+TEST(RemoteAddressIndexTest, MatchesMap) {
+  RemoteAddressIndex<int> index;
+  std::map<rtc::SocketAddress, int*> map;
+  std::vector<int> values(64);
+  std::vector<rtc::SocketAddress> addresses;
+  for (int i = 0; i < 200; ++i) {
+    rtc::IPAddress ip = (i % 2) ? rtc::IPAddress(0x0A000000 + i / 8)
+                                : rtc::IPAddress(in6addr_loopback);
+    addresses.emplace_back(ip, 1000 + i % 8);
+  }
+  webrtc::Random random(1234);
+  for (int n = 0; n < 5000; ++n) {
+    const rtc::SocketAddress& address =
+        addresses[random.Rand(addresses.size() - 1)];
+    if (random.Rand(2) == 0) {
+      EXPECT_EQ(map.erase(address) == 1, index.Erase(address));
+    } else {
+      int* value = &values[random.Rand(values.size() - 1)];
+      map[address] = value;
+      index.Insert(address, value);
+    }
+    ASSERT_EQ(map.size(), index.size());
+    const rtc::SocketAddress& probe =
+        addresses[random.Rand(addresses.size() - 1)];
+    auto it = map.find(probe);
+    EXPECT_EQ(it == map.end() ? nullptr : it->second, index.Find(probe));
+  }
+  for (const auto& [address, value] : map) {
+    EXPECT_EQ(value, index.Find(address));
+  }
+}
+
+}  // namespace
+}  // namespace cricket
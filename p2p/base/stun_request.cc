@@ -110,7 +110,10 @@ bool StunRequestManager::CheckResponse(StunMessage* msg) {
   bool skip_integrity_checking = false;
   if (request->msg()->integrity() == StunMessage::IntegrityStatus::kNotSet) {
     skip_integrity_checking = true;
-  } else {
+  } else if (msg->integrity() == StunMessage::IntegrityStatus::kNotSet ||
+             msg->password() != request->msg()->password()) {
+    // Skipped if the owner already checked the response with the password of
+    // the request, like Connection does.
     msg->ValidateMessageIntegrity(request->msg()->password());
   }
 
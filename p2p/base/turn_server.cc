@@ -10,12 +10,13 @@
 
 #include "p2p/base/turn_server.h"
 
+#include <string.h>
+
 #include <algorithm>
 #include <memory>
 #include <tuple>  // for std::tie
 #include <utility>
 
-#include "absl/algorithm/container.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
@@ -24,6 +25,7 @@
 #include "api/transport/stun.h"
 #include "p2p/base/async_stun_tcp_socket.h"
 #include "rtc_base/byte_buffer.h"
+#include "rtc_base/byte_order.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/helpers.h"
 #include "rtc_base/logging.h"
@@ -58,6 +60,62 @@ bool IsTurnChannelData(uint16_t msg_type) {
 
 }  // namespace
 
+bool ParseSendIndication(const char* data,
+                         size_t size,
+                         rtc::SocketAddress* peer,
+                         const char** payload,
+                         size_t* payload_size) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+  if (size < kStunHeaderSize ||
+      rtc::GetBE16(bytes) != TURN_SEND_INDICATION ||
+      rtc::GetBE16(bytes + 2) != size - kStunHeaderSize ||
+      rtc::GetBE32(bytes + 4) != kStunMagicCookie) {
+    return false;
+  }
+  bool has_peer = false;
+  bool has_payload = false;
+  size_t pos = kStunHeaderSize;
+  while (pos + kStunAttributeHeaderSize <= size) {
+    const uint16_t attr_type = rtc::GetBE16(bytes + pos);
+    const size_t attr_length = rtc::GetBE16(bytes + pos + 2);
+    pos += kStunAttributeHeaderSize;
+    if (attr_length > size - pos) {
+      return false;
+    }
+    const uint8_t* value = bytes + pos;
+    if (attr_type == STUN_ATTR_XOR_PEER_ADDRESS && !has_peer) {
+      if (attr_length < 4) {
+        return false;
+      }
+      const uint16_t port = rtc::GetBE16(value + 2) ^ (kStunMagicCookie >> 16);
+      if (value[1] == STUN_ADDRESS_IPV4 && attr_length == 8) {
+        const uint32_t ip = rtc::GetBE32(value + 4) ^ kStunMagicCookie;
+        peer->SetIP(rtc::IPAddress(ip));
+      } else if (value[1] == STUN_ADDRESS_IPV6 && attr_length == 20) {
+        // The address is XOR-ed with the magic cookie and the transaction id,
+        // which are the 16 bytes following the message length.
+        in6_addr ip;
+        uint8_t* ip_bytes = reinterpret_cast<uint8_t*>(&ip);
+        for (size_t i = 0; i < sizeof(ip); ++i) {
+          ip_bytes[i] = value[4 + i] ^ bytes[4 + i];
+        }
+        peer->SetIP(rtc::IPAddress(ip));
+      } else {
+        return false;
+      }
+      peer->SetPort(port);
+      has_peer = true;
+    } else if (attr_type == STUN_ATTR_DATA && !has_payload) {
+      *payload = reinterpret_cast<const char*>(value);
+      *payload_size = attr_length;
+      has_payload = true;
+    }
+    // Attributes are padded to a multiple of four bytes.
+    pos += (attr_length + 3) & ~size_t{3};
+  }
+  return pos == size && has_peer && has_payload;
+}
+
 int GetStunSuccessResponseTypeOrZero(const StunMessage& req) {
   const int resp_type = GetStunSuccessResponseType(req.type());
   return resp_type == -1 ? 0 : resp_type;
@@ -177,6 +235,19 @@ void TurnServer::OnInternalPacket(rtc::AsyncPacketSocket* socket,
   TurnServerConnection conn(addr, iter->second, socket);
   uint16_t msg_type = rtc::GetBE16(data);
   if (!IsTurnChannelData(msg_type)) {
+    // Send indications need no authentication, so unless someone observes the
+    // parsed messages they are relayed straight from the packet.
+    if (msg_type == TURN_SEND_INDICATION && stun_message_observer_ == nullptr) {
+      TurnServerAllocation* allocation = FindAllocation(&conn);
+      rtc::SocketAddress peer;
+      const char* payload;
+      size_t payload_size;
+      if (allocation &&
+          ParseSendIndication(data, size, &peer, &payload, &payload_size)) {
+        allocation->HandleSendIndicationData(payload, payload_size, peer);
+        return;
+      }
+    }
     // This is a STUN message.
     HandleStunMessage(&conn, data, size);
   } else {
@@ -491,9 +562,15 @@ void TurnServer::SendStun(TurnServerConnection* conn, StunMessage* msg) {
 
 void TurnServer::Send(TurnServerConnection* conn,
                       const rtc::ByteBufferWriter& buf) {
+  Send(conn, buf.Data(), buf.Length());
+}
+
+void TurnServer::Send(TurnServerConnection* conn,
+                      const char* data,
+                      size_t size) {
   RTC_DCHECK_RUN_ON(thread_);
   rtc::PacketOptions options;
-  conn->socket()->SendTo(buf.Data(), buf.Length(), conn->src(), options);
+  conn->socket()->SendTo(data, size, conn->src(), options);
 }
 
 void TurnServer::DestroyAllocation(TurnServerAllocation* allocation) {
@@ -539,6 +616,11 @@ bool TurnServerConnection::operator==(const TurnServerConnection& c) const {
   return src_ == c.src_ && dst_ == c.dst_ && proto_ == c.proto_;
 }
 
+size_t TurnServerConnection::Hash::operator()(
+    const TurnServerConnection& conn) const {
+  return conn.src_.Hash() ^ (conn.dst_.Hash() << 1) ^ conn.proto_;
+}
+
 bool TurnServerConnection::operator<(const TurnServerConnection& c) const {
   return std::tie(src_, dst_, proto_) < std::tie(c.src_, c.dst_, c.proto_);
 }
@@ -567,6 +649,7 @@ TurnServerAllocation::TurnServerAllocation(TurnServer* server,
 
 TurnServerAllocation::~TurnServerAllocation() {
   channels_.clear();
+  channel_ids_by_peer_.clear();
   perms_.clear();
   RTC_LOG(LS_INFO) << ToString() << ": Allocation destroyed";
 }
@@ -667,15 +750,22 @@ void TurnServerAllocation::HandleSendIndication(const TurnMessage* msg) {
     return;
   }
 
+  HandleSendIndicationData(data_attr->bytes(), data_attr->length(),
+                           peer_attr->GetAddress());
+}
+
+void TurnServerAllocation::HandleSendIndicationData(
+    const char* data,
+    size_t size,
+    const rtc::SocketAddress& peer) {
   // If a permission exists, send the data on to the peer.
-  if (HasPermission(peer_attr->GetAddress().ipaddr())) {
-    SendExternal(data_attr->bytes(), data_attr->length(),
-                 peer_attr->GetAddress());
+  if (HasPermission(peer.ipaddr())) {
+    SendExternal(data, size, peer);
   } else {
     RTC_LOG(LS_WARNING) << ToString()
                         << ": Received send indication without permission"
                            " peer="
-                        << peer_attr->GetAddress().ToSensitiveString();
+                        << peer.ToSensitiveString();
   }
 }
 
@@ -736,14 +826,15 @@ void TurnServerAllocation::HandleChannelBindRequest(const TurnMessage* msg) {
 
   // Add or refresh this channel.
   if (channel1 == channels_.end()) {
-    channel1 = channels_.insert(
-        channels_.end(), {.id = channel_id, .peer = peer_attr->GetAddress()});
+    channel1 = channels_.try_emplace(channel_id).first;
+    channel1->second.peer = peer_attr->GetAddress();
+    channel_ids_by_peer_[peer_attr->GetAddress()] = channel_id;
   } else {
-    channel1->pending_delete.reset();
+    channel1->second.pending_delete.reset();
   }
   thread_->PostDelayedTask(
-      SafeTask(channel1->pending_delete.flag(),
-               [this, channel1] { channels_.erase(channel1); }),
+      SafeTask(channel1->second.pending_delete.flag(),
+               [this, channel_id] { RemoveChannel(channel_id); }),
       kChannelTimeout);
 
   // Channel binds also refresh permissions.
@@ -765,7 +856,7 @@ void TurnServerAllocation::HandleChannelData(const char* data, size_t size) {
   if (channel != channels_.end()) {
     // Send the data to the peer address.
     SendExternal(data + TURN_CHANNEL_HEADER_SIZE,
-                 size - TURN_CHANNEL_HEADER_SIZE, channel->peer);
+                 size - TURN_CHANNEL_HEADER_SIZE, channel->second.peer);
   } else {
     RTC_LOG(LS_WARNING) << ToString()
                         << ": Received channel data for invalid channel, id="
@@ -783,11 +874,12 @@ void TurnServerAllocation::OnExternalPacket(
   auto channel = FindChannel(addr);
   if (channel != channels_.end()) {
     // There is a channel bound to this address. Send as a channel message.
-    rtc::ByteBufferWriter buf;
-    buf.WriteUInt16(channel->id);
-    buf.WriteUInt16(static_cast<uint16_t>(size));
-    buf.WriteBytes(data, size);
-    server_->Send(&conn_, buf);
+    channel_data_buffer_.resize(TURN_CHANNEL_HEADER_SIZE + size);
+    char* buf = channel_data_buffer_.data();
+    rtc::SetBE16(buf, static_cast<uint16_t>(channel->first));
+    rtc::SetBE16(buf + 2, static_cast<uint16_t>(size));
+    memcpy(buf + TURN_CHANNEL_HEADER_SIZE, data, size);
+    server_->Send(&conn_, buf, channel_data_buffer_.size());
   } else if (!server_->enable_permission_checks_ ||
              HasPermission(addr.ipaddr())) {
     // No channel, but a permission exists. Send as a data indication.
@@ -813,37 +905,37 @@ TimeDelta TurnServerAllocation::ComputeLifetime(const TurnMessage& msg) {
 }
 
 bool TurnServerAllocation::HasPermission(const rtc::IPAddress& addr) {
-  return FindPermission(addr) != perms_.end();
+  return perms_.find(addr) != perms_.end();
 }
 
 void TurnServerAllocation::AddPermission(const rtc::IPAddress& addr) {
-  auto perm = FindPermission(addr);
-  if (perm == perms_.end()) {
-    perm = perms_.insert(perms_.end(), {.peer = addr});
-  } else {
-    perm->pending_delete.reset();
+  auto [perm, inserted] = perms_.try_emplace(addr);
+  if (!inserted) {
+    perm->second.pending_delete.reset();
   }
-  thread_->PostDelayedTask(SafeTask(perm->pending_delete.flag(),
-                                    [this, perm] { perms_.erase(perm); }),
+  thread_->PostDelayedTask(SafeTask(perm->second.pending_delete.flag(),
+                                    [this, addr] { perms_.erase(addr); }),
                            kPermissionTimeout);
 }
 
-TurnServerAllocation::PermissionList::iterator
-TurnServerAllocation::FindPermission(const rtc::IPAddress& addr) {
-  return absl::c_find_if(perms_,
-                         [&](const Permission& p) { return p.peer == addr; });
-}
-
-TurnServerAllocation::ChannelList::iterator TurnServerAllocation::FindChannel(
+TurnServerAllocation::ChannelMap::iterator TurnServerAllocation::FindChannel(
     int channel_id) {
-  return absl::c_find_if(channels_,
-                         [&](const Channel& c) { return c.id == channel_id; });
+  return channels_.find(channel_id);
 }
 
-TurnServerAllocation::ChannelList::iterator TurnServerAllocation::FindChannel(
+TurnServerAllocation::ChannelMap::iterator TurnServerAllocation::FindChannel(
     const rtc::SocketAddress& addr) {
-  return absl::c_find_if(channels_,
-                         [&](const Channel& c) { return c.peer == addr; });
+  auto it = channel_ids_by_peer_.find(addr);
+  return it != channel_ids_by_peer_.end() ? channels_.find(it->second)
+                                          : channels_.end();
+}
+
+void TurnServerAllocation::RemoveChannel(int channel_id) {
+  auto channel = channels_.find(channel_id);
+  if (channel != channels_.end()) {
+    channel_ids_by_peer_.erase(channel->second.peer);
+    channels_.erase(channel);
+  }
 }
 
 void TurnServerAllocation::SendResponse(TurnMessage* msg) {
@@ -11,11 +11,9 @@
 #ifndef P2P_BASE_TURN_SERVER_H_
 #define P2P_BASE_TURN_SERVER_H_
 
-#include <list>
-#include <map>
 #include <memory>
-#include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -26,6 +24,7 @@
 #include "api/units/time_delta.h"
 #include "p2p/base/port_interface.h"
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/ip_address.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/ssl_adapter.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
@@ -44,9 +43,24 @@ class TurnServer;
 // The default server port for TURN, as specified in RFC5766.
 const int TURN_SERVER_PORT = 3478;
 
+// Extracts the XOR-PEER-ADDRESS and DATA attributes of a send indication
+// without building a TurnMessage. Returns false if the message is malformed or
+// uses anything this parser does not handle, e.g. a legacy RFC 3489 header, in
+// which case it should go through the regular STUN path instead. `payload`
+// points into `data`. Exposed for testing.
+bool ParseSendIndication(const char* data,
+                         size_t size,
+                         rtc::SocketAddress* peer,
+                         const char** payload,
+                         size_t* payload_size);
+
 // Encapsulates the client's connection to the server.
 class TurnServerConnection {
  public:
+  struct Hash {
+    size_t operator()(const TurnServerConnection& conn) const;
+  };
+
   TurnServerConnection() : proto_(PROTO_UDP), socket_(NULL) {}
   TurnServerConnection(const rtc::SocketAddress& src,
                        ProtocolType proto,
@@ -91,19 +105,34 @@ class TurnServerAllocation : public sigslot::has_slots<> {
 
   void HandleTurnMessage(const TurnMessage* msg);
   void HandleChannelData(const char* data, size_t size);
+  // Relays the payload of a send indication that was parsed without building
+  // a TurnMessage.
+  void HandleSendIndicationData(const char* data,
+                                size_t size,
+                                const rtc::SocketAddress& peer);
 
  private:
   struct Channel {
     webrtc::ScopedTaskSafety pending_delete;
-    int id;
     rtc::SocketAddress peer;
   };
   struct Permission {
     webrtc::ScopedTaskSafety pending_delete;
-    rtc::IPAddress peer;
   };
-  using PermissionList = std::list<Permission>;
-  using ChannelList = std::list<Channel>;
+  struct IPAddressHash {
+    size_t operator()(const rtc::IPAddress& addr) const {
+      return rtc::HashIP(addr);
+    }
+  };
+  struct SocketAddressHash {
+    size_t operator()(const rtc::SocketAddress& addr) const {
+      return addr.Hash();
+    }
+  };
+  using PermissionMap =
+      std::unordered_map<rtc::IPAddress, Permission, IPAddressHash>;
+  // Channels by channel number.
+  using ChannelMap = std::unordered_map<int, Channel>;
 
   void PostDeleteSelf(webrtc::TimeDelta delay);
 
@@ -122,9 +151,9 @@ class TurnServerAllocation : public sigslot::has_slots<> {
   static webrtc::TimeDelta ComputeLifetime(const TurnMessage& msg);
   bool HasPermission(const rtc::IPAddress& addr);
   void AddPermission(const rtc::IPAddress& addr);
-  PermissionList::iterator FindPermission(const rtc::IPAddress& addr);
-  ChannelList::iterator FindChannel(int channel_id);
-  ChannelList::iterator FindChannel(const rtc::SocketAddress& addr);
+  ChannelMap::iterator FindChannel(int channel_id);
+  ChannelMap::iterator FindChannel(const rtc::SocketAddress& addr);
+  void RemoveChannel(int channel_id);
 
   void SendResponse(TurnMessage* msg);
   void SendBadRequestResponse(const TurnMessage* req);
@@ -143,8 +172,12 @@ class TurnServerAllocation : public sigslot::has_slots<> {
   std::string transaction_id_;
   std::string username_;
   std::string last_nonce_;
-  PermissionList perms_;
-  ChannelList channels_;
+  PermissionMap perms_;
+  ChannelMap channels_;
+  std::unordered_map<rtc::SocketAddress, int, SocketAddressHash>
+      channel_ids_by_peer_;
+  // Reused for the channel data messages sent to the client.
+  std::vector<char> channel_data_buffer_;
   webrtc::ScopedTaskSafety safety_;
 };
 
@@ -179,9 +212,17 @@ class StunMessageObserver {
 // AddInternalServerSocket, and a factory to create external sockets via
 // SetExternalSocketFactory, and it's ready to go.
 // Not yet wired up: TCP support.
+//
+// ChannelData messages and send indications from clients are relayed without
+// building a TurnMessage, so relaying costs one hash lookup per packet. All
+// state lives on `thread`; to use several cores, run one TurnServer per thread,
+// each with its own internal sockets, and spread the clients over them by
+// 5-tuple, e.g. with SO_REUSEPORT or with one port per server.
 class TurnServer : public sigslot::has_slots<> {
  public:
-  typedef std::map<TurnServerConnection, std::unique_ptr<TurnServerAllocation>>
+  typedef std::unordered_map<TurnServerConnection,
+                             std::unique_ptr<TurnServerAllocation>,
+                             TurnServerConnection::Hash>
       AllocationMap;
 
   explicit TurnServer(webrtc::TaskQueueBase* thread);
@@ -323,18 +364,20 @@ class TurnServer : public sigslot::has_slots<> {
 
   void SendStun(TurnServerConnection* conn, StunMessage* msg);
   void Send(TurnServerConnection* conn, const rtc::ByteBufferWriter& buf);
+  void Send(TurnServerConnection* conn, const char* data, size_t size);
 
   void DestroyAllocation(TurnServerAllocation* allocation) RTC_RUN_ON(thread_);
   void DestroyInternalSocket(rtc::AsyncPacketSocket* socket)
       RTC_RUN_ON(thread_);
 
-  typedef std::map<rtc::AsyncPacketSocket*, ProtocolType> InternalSocketMap;
+  typedef std::unordered_map<rtc::AsyncPacketSocket*, ProtocolType>
+      InternalSocketMap;
   struct ServerSocketInfo {
     ProtocolType proto;
     // If non-null, used to wrap accepted sockets.
     std::unique_ptr<rtc::SSLAdapterFactory> ssl_adapter_factory;
   };
-  typedef std::map<rtc::Socket*, ServerSocketInfo> ServerSocketMap;
+  typedef std::unordered_map<rtc::Socket*, ServerSocketInfo> ServerSocketMap;
 
   webrtc::TaskQueueBase* const thread_;
   const std::string nonce_key_;
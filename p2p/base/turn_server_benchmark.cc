@@ -0,0 +1,230 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/transport/stun.h"
+#include "benchmark/benchmark.h"
+#include "p2p/base/test_turn_server.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/system/unused.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/virtual_socket_server.h"
+
+namespace cricket {
+namespace {
+
+constexpr char kUsername[] = "user";
+constexpr int kChannelNumber = 0x4000;
+// Responses to the two allocate requests and the channel bind or create
+// permission request.
+constexpr int kNumSetupResponses = 3;
+
+const rtc::SocketAddress kTurnIntAddr("99.99.99.1", 3478);
+const rtc::SocketAddress kTurnExtAddr("99.99.99.2", 0);
+const rtc::SocketAddress kPeerAddr("2.2.2.2", 5000);
+
+// Endpoint on the virtual network that counts the packets it receives and
+// keeps the last one.
+class Endpoint : public sigslot::has_slots<> {
+ public:
+  Endpoint(rtc::SocketFactory* socket_factory,
+           const rtc::SocketAddress& address)
+      : socket_(rtc::AsyncUDPSocket::Create(socket_factory, address)) {
+    RTC_CHECK(socket_);
+    socket_->SignalReadPacket.connect(this, &Endpoint::OnReadPacket);
+  }
+
+  void SendTo(const void* data,
+              size_t size,
+              const rtc::SocketAddress& address) {
+    rtc::PacketOptions options;
+    socket_->SendTo(data, size, address, options);
+  }
+
+  void SendStun(const StunMessage& msg, const rtc::SocketAddress& address) {
+    rtc::ByteBufferWriter buf;
+    msg.Write(&buf);
+    SendTo(buf.Data(), buf.Length(), address);
+  }
+
+  // Parses the last received packet as a TURN message.
+  std::unique_ptr<TurnMessage> ReadLastMessage() const {
+    auto msg = std::make_unique<TurnMessage>();
+    rtc::ByteBufferReader buf(last_packet_.data(), last_packet_.size());
+    RTC_CHECK(msg->Read(&buf));
+    return msg;
+  }
+
+  int num_received() const { return num_received_; }
+
+ private:
+  void OnReadPacket(rtc::AsyncPacketSocket* /* socket */,
+                    const char* data,
+                    size_t size,
+                    const rtc::SocketAddress& /* address */,
+                    const int64_t& /* packet_time_us */) {
+    last_packet_.assign(data, data + size);
+    ++num_received_;
+  }
+
+  std::unique_ptr<rtc::AsyncUDPSocket> socket_;
+  std::vector<char> last_packet_;
+  int num_received_ = 0;
+};
+
+// Delivers packets on the virtual network until `endpoint` has received
+// `num_packets` in total. VirtualSocketServer::ProcessMessagesUntilIdle() does
+// not return while the allocation timers are pending.
+void ProcessUntilReceived(rtc::Thread* thread,
+                          const Endpoint& endpoint,
+                          int num_packets) {
+  while (endpoint.num_received() < num_packets) {
+    thread->ProcessMessages(0);
+  }
+}
+
+// A TURN client with one allocation and either a channel or a permission for
+// `kPeerAddr`.
+class Client : public Endpoint {
+ public:
+  Client(rtc::Thread* thread,
+         rtc::SocketFactory* socket_factory,
+         const rtc::SocketAddress& address,
+         bool bind_channel)
+      : Endpoint(socket_factory, address) {
+    // The first request is rejected with the nonce to use.
+    TurnMessage allocate(STUN_ALLOCATE_REQUEST);
+    allocate.AddAttribute(std::make_unique<StunUInt32Attribute>(
+        STUN_ATTR_REQUESTED_TRANSPORT, IPPROTO_UDP << 24));
+    SendStun(allocate, kTurnIntAddr);
+    ProcessUntilReceived(thread, *this, 1);
+    nonce_ = std::string(
+        ReadLastMessage()->GetByteString(STUN_ATTR_NONCE)->string_view());
+
+    TurnMessage authenticated_allocate(STUN_ALLOCATE_REQUEST);
+    authenticated_allocate.AddAttribute(std::make_unique<StunUInt32Attribute>(
+        STUN_ATTR_REQUESTED_TRANSPORT, IPPROTO_UDP << 24));
+    SendAuthenticatedRequest(authenticated_allocate);
+    ProcessUntilReceived(thread, *this, 2);
+    std::unique_ptr<TurnMessage> response = ReadLastMessage();
+    RTC_CHECK_EQ(response->type(), STUN_ALLOCATE_RESPONSE);
+    relay_address_ =
+        response->GetAddress(STUN_ATTR_XOR_RELAYED_ADDRESS)->GetAddress();
+
+    TurnMessage bind(bind_channel ? TURN_CHANNEL_BIND_REQUEST
+                                  : TURN_CREATE_PERMISSION_REQUEST);
+    if (bind_channel) {
+      bind.AddAttribute(std::make_unique<StunUInt32Attribute>(
+          STUN_ATTR_CHANNEL_NUMBER, kChannelNumber << 16));
+    }
+    bind.AddAttribute(std::make_unique<StunXorAddressAttribute>(
+        STUN_ATTR_XOR_PEER_ADDRESS, kPeerAddr));
+    SendAuthenticatedRequest(bind);
+    ProcessUntilReceived(thread, *this, 3);
+    RTC_CHECK(IsStunSuccessResponseType(ReadLastMessage()->type()));
+  }
+
+  const rtc::SocketAddress& relay_address() const { return relay_address_; }
+
+ private:
+  void SendAuthenticatedRequest(TurnMessage& msg) {
+    msg.AddAttribute(std::make_unique<StunByteStringAttribute>(
+        STUN_ATTR_USERNAME, kUsername));
+    msg.AddAttribute(
+        std::make_unique<StunByteStringAttribute>(STUN_ATTR_REALM, kTestRealm));
+    msg.AddAttribute(
+        std::make_unique<StunByteStringAttribute>(STUN_ATTR_NONCE, nonce_));
+    std::string key;
+    RTC_CHECK(
+        ComputeStunCredentialHash(kUsername, kTestRealm, kUsername, &key));
+    msg.AddMessageIntegrity(key);
+    SendStun(msg, kTurnIntAddr);
+  }
+
+  std::string nonce_;
+  rtc::SocketAddress relay_address_;
+};
+
+// Relays one packet of `state.range(1)` bytes in each direction for each of
+// `state.range(0)` allocations per iteration. Clients send ChannelData
+// messages when `bind_channel` is set and send indications otherwise.
+void RelayPackets(benchmark::State& state, bool bind_channel) {
+  const int num_clients = state.range(0);
+  const size_t payload_size = state.range(1);
+  rtc::VirtualSocketServer vss;
+  rtc::AutoSocketServerThread thread(&vss);
+  TestTurnServer turn_server(&thread, &vss, kTurnIntAddr, kTurnExtAddr);
+  Endpoint peer(&vss, kPeerAddr);
+  std::vector<std::unique_ptr<Client>> clients;
+  for (int i = 0; i < num_clients; ++i) {
+    clients.push_back(std::make_unique<Client>(
+        &thread, &vss, rtc::SocketAddress("1.1.1.1", 10000 + i),
+        bind_channel));
+  }
+
+  const std::vector<char> payload(payload_size, 'x');
+  rtc::ByteBufferWriter client_packet;
+  if (bind_channel) {
+    client_packet.WriteUInt16(kChannelNumber);
+    client_packet.WriteUInt16(static_cast<uint16_t>(payload_size));
+    client_packet.WriteBytes(payload.data(), payload_size);
+  } else {
+    TurnMessage send_indication(TURN_SEND_INDICATION);
+    send_indication.AddAttribute(std::make_unique<StunXorAddressAttribute>(
+        STUN_ATTR_XOR_PEER_ADDRESS, kPeerAddr));
+    send_indication.AddAttribute(std::make_unique<StunByteStringAttribute>(
+        STUN_ATTR_DATA, payload.data(), payload_size));
+    send_indication.Write(&client_packet);
+  }
+
+  int num_iterations = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    for (const std::unique_ptr<Client>& client : clients) {
+      client->SendTo(client_packet.Data(), client_packet.Length(),
+                     kTurnIntAddr);
+      peer.SendTo(payload.data(), payload_size, client->relay_address());
+    }
+    ++num_iterations;
+    ProcessUntilReceived(&thread, peer, num_iterations * num_clients);
+    for (const std::unique_ptr<Client>& client : clients) {
+      ProcessUntilReceived(&thread, *client,
+                           kNumSetupResponses + num_iterations);
+    }
+  }
+
+  state.SetItemsProcessed(2 * state.iterations() * num_clients);
+  state.SetBytesProcessed(2 * state.iterations() * num_clients *
+                          payload_size);
+}
+
+void BM_TurnServerRelayChannelData(benchmark::State& state) {
+  RelayPackets(state, /*bind_channel=*/true);
+}
+
+void BM_TurnServerRelaySendIndication(benchmark::State& state) {
+  RelayPackets(state, /*bind_channel=*/false);
+}
+
+BENCHMARK(BM_TurnServerRelayChannelData)
+    ->ArgsProduct({{1, 100, 1000}, {160, 1200}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_TurnServerRelaySendIndication)
+    ->ArgsProduct({{1, 100, 1000}, {160, 1200}})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace cricket
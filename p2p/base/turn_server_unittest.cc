@@ -10,13 +10,23 @@
 
 #include "p2p/base/turn_server.h"
 
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/transport/stun.h"
+#include "api/units/time_delta.h"
 #include "p2p/base/basic_packet_socket_factory.h"
+#include "p2p/base/test_turn_server.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/byte_order.h"
+#include "rtc_base/fake_clock.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/virtual_socket_server.h"
 #include "test/gtest.h"
 
-// NOTE: This is a work in progress. Currently this file only has tests for
-// TurnServerConnection, a primitive class used by TurnServer.
-
 namespace cricket {
 
 class TurnServerConnectionTest : public ::testing::Test {
@@ -28,6 +38,7 @@ class TurnServerConnectionTest : public ::testing::Test {
     EXPECT_TRUE(a == b);
     EXPECT_FALSE(a < b);
     EXPECT_FALSE(b < a);
+    EXPECT_EQ(TurnServerConnection::Hash()(a), TurnServerConnection::Hash()(b));
   }
 
   void ExpectNotEqual(const TurnServerConnection& a,
@@ -62,4 +73,334 @@ TEST_F(TurnServerConnectionTest, ComparisonOperators) {
   ExpectNotEqual(connection1, connection4);
 }
 
+namespace {
+
+constexpr char kUsername[] = "user";
+constexpr int kChannelNumber = 0x4000;
+
+const rtc::SocketAddress kTurnIntAddr("99.99.99.1", 3478);
+const rtc::SocketAddress kTurnExtAddr("99.99.99.2", 0);
+const rtc::SocketAddress kClientAddr("1.1.1.1", 10000);
+const rtc::SocketAddress kPeerAddr("2.2.2.2", 5000);
+const rtc::SocketAddress kOtherPeerAddr("2.2.2.3", 5000);
+const rtc::SocketAddress kIpv6PeerAddr("2400:4030:1:2c00:be30:abcd:efab:cdef",
+                                       5000);
+
+std::string SerializeMessage(const StunMessage& msg) {
+  rtc::ByteBufferWriter buf;
+  msg.Write(&buf);
+  return std::string(buf.Data(), buf.Length());
+}
+
+std::string SendIndication(const rtc::SocketAddress& peer,
+                           absl::string_view payload) {
+  TurnMessage msg(TURN_SEND_INDICATION);
+  msg.AddAttribute(std::make_unique<StunXorAddressAttribute>(
+      STUN_ATTR_XOR_PEER_ADDRESS, peer));
+  msg.AddAttribute(
+      std::make_unique<StunByteStringAttribute>(STUN_ATTR_DATA, payload));
+  return SerializeMessage(msg);
+}
+
+bool Parse(absl::string_view packet,
+           rtc::SocketAddress* peer,
+           absl::string_view* payload) {
+  const char* payload_data = nullptr;
+  size_t payload_size = 0;
+  if (!ParseSendIndication(packet.data(), packet.size(), peer, &payload_data,
+                           &payload_size)) {
+    return false;
+  }
+  *payload = absl::string_view(payload_data, payload_size);
+  return true;
+}
+
+}  // namespace
+
+TEST(TurnServerParseSendIndicationTest, ParsesIpv4Peer) {
+  const std::string packet = SendIndication(kPeerAddr, "payload");
+  rtc::SocketAddress peer;
+  absl::string_view payload;
+  ASSERT_TRUE(Parse(packet, &peer, &payload));
+  EXPECT_EQ(kPeerAddr, peer);
+  EXPECT_EQ("payload", payload);
+}
+
+TEST(TurnServerParseSendIndicationTest, ParsesIpv6Peer) {
+  const std::string packet = SendIndication(kIpv6PeerAddr, "payload");
+  rtc::SocketAddress peer;
+  absl::string_view payload;
+  ASSERT_TRUE(Parse(packet, &peer, &payload));
+  EXPECT_EQ(kIpv6PeerAddr, peer);
+  EXPECT_EQ("payload", payload);
+}
+
+TEST(TurnServerParseSendIndicationTest, RejectsTruncatedMessages) {
+  const std::string packet = SendIndication(kPeerAddr, "payload");
+  rtc::SocketAddress peer;
+  absl::string_view payload;
+  // Truncated headers, and messages shorter than their header says.
+  for (size_t size = 0; size < packet.size(); ++size) {
+    EXPECT_FALSE(Parse(absl::string_view(packet.data(), size), &peer,
+                       &payload));
+  }
+  // A header length that matches the truncated size, cutting off the DATA
+  // attribute.
+  std::string truncated = packet.substr(0, packet.size() - 4);
+  rtc::SetBE16(&truncated[2], truncated.size() - kStunHeaderSize);
+  EXPECT_FALSE(Parse(truncated, &peer, &payload));
+}
+
+TEST(TurnServerParseSendIndicationTest, RejectsAttributeLengthsPastTheEnd) {
+  const std::string packet = SendIndication(kPeerAddr, "payload");
+  // XOR-PEER-ADDRESS, then DATA.
+  constexpr size_t kPeerLengthOffset = kStunHeaderSize + 2;
+  constexpr size_t kDataLengthOffset = kStunHeaderSize + 4 + 8 + 2;
+  rtc::SocketAddress peer;
+  absl::string_view payload;
+  for (size_t offset : {kPeerLengthOffset, kDataLengthOffset}) {
+    for (uint16_t length : {uint16_t{0x0400}, uint16_t{0xffff}}) {
+      std::string munged = packet;
+      rtc::SetBE16(&munged[offset], length);
+      EXPECT_FALSE(Parse(munged, &peer, &payload));
+    }
+  }
+  // DATA fits, but its padding doesn't.
+  std::string munged = packet;
+  rtc::SetBE16(&munged[kDataLengthOffset], 8 + 1);
+  EXPECT_FALSE(Parse(munged, &peer, &payload));
+}
+
+TEST(TurnServerParseSendIndicationTest, UsesFirstOfDuplicateAttributes) {
+  TurnMessage msg(TURN_SEND_INDICATION);
+  msg.AddAttribute(std::make_unique<StunXorAddressAttribute>(
+      STUN_ATTR_XOR_PEER_ADDRESS, kPeerAddr));
+  msg.AddAttribute(
+      std::make_unique<StunByteStringAttribute>(STUN_ATTR_DATA, "first"));
+  msg.AddAttribute(std::make_unique<StunXorAddressAttribute>(
+      STUN_ATTR_XOR_PEER_ADDRESS, kOtherPeerAddr));
+  msg.AddAttribute(
+      std::make_unique<StunByteStringAttribute>(STUN_ATTR_DATA, "second"));
+  const std::string packet = SerializeMessage(msg);
+
+  rtc::SocketAddress peer;
+  absl::string_view payload;
+  ASSERT_TRUE(Parse(packet, &peer, &payload));
+  // Same as the regular STUN path.
+  TurnMessage parsed;
+  rtc::ByteBufferReader buf(packet.data(), packet.size());
+  ASSERT_TRUE(parsed.Read(&buf));
+  EXPECT_EQ(parsed.GetAddress(STUN_ATTR_XOR_PEER_ADDRESS)->GetAddress(), peer);
+  EXPECT_EQ(parsed.GetByteString(STUN_ATTR_DATA)->string_view(), payload);
+  EXPECT_EQ(kPeerAddr, peer);
+  EXPECT_EQ("first", payload);
+}
+
+TEST(TurnServerParseSendIndicationTest, LeavesOtherMessagesToStunPath) {
+  const std::string packet = SendIndication(kPeerAddr, "payload");
+  rtc::SocketAddress peer;
+  absl::string_view payload;
+
+  // Legacy RFC 3489 header, without the magic cookie.
+  std::string munged = packet;
+  munged[4] ^= 0x01;
+  EXPECT_FALSE(Parse(munged, &peer, &payload));
+
+  // Not a send indication.
+  munged = packet;
+  rtc::SetBE16(&munged[0], TURN_CREATE_PERMISSION_REQUEST);
+  EXPECT_FALSE(Parse(munged, &peer, &payload));
+
+  // Unknown address family.
+  munged = packet;
+  munged[kStunHeaderSize + 4 + 1] = 0x03;
+  EXPECT_FALSE(Parse(munged, &peer, &payload));
+
+  // No DATA.
+  TurnMessage msg(TURN_SEND_INDICATION);
+  msg.AddAttribute(std::make_unique<StunXorAddressAttribute>(
+      STUN_ATTR_XOR_PEER_ADDRESS, kPeerAddr));
+  EXPECT_FALSE(Parse(SerializeMessage(msg), &peer, &payload));
+}
+
+namespace {
+
+// Endpoint on the virtual network that keeps the packets it receives.
+class Endpoint : public sigslot::has_slots<> {
+ public:
+  Endpoint(rtc::SocketFactory* socket_factory,
+           const rtc::SocketAddress& address)
+      : socket_(rtc::AsyncUDPSocket::Create(socket_factory, address)) {
+    socket_->SignalReadPacket.connect(this, &Endpoint::OnReadPacket);
+  }
+
+  void SendTo(absl::string_view packet, const rtc::SocketAddress& address) {
+    rtc::PacketOptions options;
+    socket_->SendTo(packet.data(), packet.size(), address, options);
+  }
+
+  const std::vector<std::string>& packets() const { return packets_; }
+
+ private:
+  void OnReadPacket(rtc::AsyncPacketSocket* /* socket */,
+                    const char* data,
+                    size_t size,
+                    const rtc::SocketAddress& /* address */,
+                    const int64_t& /* packet_time_us */) {
+    packets_.emplace_back(data, size);
+  }
+
+  std::unique_ptr<rtc::AsyncUDPSocket> socket_;
+  std::vector<std::string> packets_;
+};
+
+class MessageCounter : public StunMessageObserver {
+ public:
+  explicit MessageCounter(int* num_messages) : num_messages_(num_messages) {}
+  void ReceivedMessage(const TurnMessage* msg) override { ++*num_messages_; }
+  void ReceivedChannelData(const char* data, size_t size) override {}
+
+ private:
+  int* const num_messages_;
+};
+
+}  // namespace
+
+class TurnServerTest : public ::testing::Test {
+ public:
+  TurnServerTest()
+      : thread_(&vss_),
+        turn_server_(&thread_, &vss_, kTurnIntAddr, kTurnExtAddr),
+        client_(&vss_, kClientAddr),
+        peer_(&vss_, kPeerAddr),
+        other_peer_(&vss_, kOtherPeerAddr) {}
+
+ protected:
+  // Delivers packets until `endpoint` has received `num_packets` in total.
+  void ProcessUntilReceived(const Endpoint& endpoint, size_t num_packets) {
+    for (int i = 0; i < 100 && endpoint.packets().size() < num_packets; ++i) {
+      thread_.ProcessMessages(0);
+    }
+    ASSERT_EQ(num_packets, endpoint.packets().size());
+  }
+
+  // Sends `request` and returns the response.
+  std::unique_ptr<TurnMessage> SendRequest(TurnMessage& request) {
+    if (!nonce_.empty()) {
+      request.AddAttribute(std::make_unique<StunByteStringAttribute>(
+          STUN_ATTR_USERNAME, kUsername));
+      request.AddAttribute(std::make_unique<StunByteStringAttribute>(
+          STUN_ATTR_REALM, kTestRealm));
+      request.AddAttribute(
+          std::make_unique<StunByteStringAttribute>(STUN_ATTR_NONCE, nonce_));
+      std::string key;
+      EXPECT_TRUE(
+          ComputeStunCredentialHash(kUsername, kTestRealm, kUsername, &key));
+      request.AddMessageIntegrity(key);
+    }
+    client_.SendTo(SerializeMessage(request), kTurnIntAddr);
+    ProcessUntilReceived(client_, client_.packets().size() + 1);
+    auto response = std::make_unique<TurnMessage>();
+    rtc::ByteBufferReader buf(client_.packets().back().data(),
+                              client_.packets().back().size());
+    EXPECT_TRUE(response->Read(&buf));
+    return response;
+  }
+
+  void Allocate() {
+    // The first request is rejected with the nonce to use.
+    TurnMessage allocate(STUN_ALLOCATE_REQUEST);
+    allocate.AddAttribute(std::make_unique<StunUInt32Attribute>(
+        STUN_ATTR_REQUESTED_TRANSPORT, IPPROTO_UDP << 24));
+    nonce_ = std::string(
+        SendRequest(allocate)->GetByteString(STUN_ATTR_NONCE)->string_view());
+
+    TurnMessage authenticated_allocate(STUN_ALLOCATE_REQUEST);
+    authenticated_allocate.AddAttribute(std::make_unique<StunUInt32Attribute>(
+        STUN_ATTR_REQUESTED_TRANSPORT, IPPROTO_UDP << 24));
+    std::unique_ptr<TurnMessage> response =
+        SendRequest(authenticated_allocate);
+    ASSERT_EQ(STUN_ALLOCATE_RESPONSE, response->type());
+    relay_address_ =
+        response->GetAddress(STUN_ATTR_XOR_RELAYED_ADDRESS)->GetAddress();
+  }
+
+  void Refresh() {
+    TurnMessage refresh(TURN_REFRESH_REQUEST);
+    EXPECT_EQ(TURN_REFRESH_RESPONSE, SendRequest(refresh)->type());
+  }
+
+  void CreatePermission(const rtc::SocketAddress& peer) {
+    TurnMessage request(TURN_CREATE_PERMISSION_REQUEST);
+    request.AddAttribute(std::make_unique<StunXorAddressAttribute>(
+        STUN_ATTR_XOR_PEER_ADDRESS, peer));
+    EXPECT_EQ(TURN_CREATE_PERMISSION_RESPONSE, SendRequest(request)->type());
+  }
+
+  void BindChannel(int channel_number, const rtc::SocketAddress& peer) {
+    TurnMessage request(TURN_CHANNEL_BIND_REQUEST);
+    request.AddAttribute(std::make_unique<StunUInt32Attribute>(
+        STUN_ATTR_CHANNEL_NUMBER, channel_number << 16));
+    request.AddAttribute(std::make_unique<StunXorAddressAttribute>(
+        STUN_ATTR_XOR_PEER_ADDRESS, peer));
+    EXPECT_EQ(TURN_CHANNEL_BIND_RESPONSE, SendRequest(request)->type());
+  }
+
+  rtc::ScopedFakeClock fake_clock_;
+  rtc::VirtualSocketServer vss_;
+  rtc::AutoSocketServerThread thread_;
+  TestTurnServer turn_server_;
+  Endpoint client_;
+  Endpoint peer_;
+  Endpoint other_peer_;
+  std::string nonce_;
+  rtc::SocketAddress relay_address_;
+};
+
+TEST_F(TurnServerTest, RelaysSendIndication) {
+  Allocate();
+  CreatePermission(kPeerAddr);
+  client_.SendTo(SendIndication(kPeerAddr, "payload"), kTurnIntAddr);
+  ProcessUntilReceived(peer_, 1);
+  EXPECT_EQ("payload", peer_.packets()[0]);
+}
+
+TEST_F(TurnServerTest, RelaysSendIndicationThroughStunPathWhenObserved) {
+  int num_messages = 0;
+  turn_server_.server()->SetStunMessageObserver(
+      std::make_unique<MessageCounter>(&num_messages));
+  Allocate();
+  CreatePermission(kPeerAddr);
+  const int num_setup_messages = num_messages;
+
+  client_.SendTo(SendIndication(kPeerAddr, "payload"), kTurnIntAddr);
+  ProcessUntilReceived(peer_, 1);
+  EXPECT_EQ("payload", peer_.packets()[0]);
+  EXPECT_EQ(num_setup_messages + 1, num_messages);
+}
+
+TEST_F(TurnServerTest, ExpiredChannelNoLongerMapsItsPeer) {
+  Allocate();
+  BindChannel(kChannelNumber, kPeerAddr);
+  peer_.SendTo("via channel", relay_address_);
+  const size_t num_client_packets = client_.packets().size() + 1;
+  ProcessUntilReceived(client_, num_client_packets);
+  EXPECT_EQ(kChannelNumber, rtc::GetBE16(client_.packets().back().data()));
+
+  // Keep the allocation alive while the channel expires.
+  fake_clock_.AdvanceTime(webrtc::TimeDelta::Minutes(9));
+  Refresh();
+  fake_clock_.AdvanceTime(webrtc::TimeDelta::Minutes(2));
+  thread_.ProcessMessages(0);
+
+  // Reuse the channel number for another peer. Data from the first peer must
+  // not be sent on it.
+  BindChannel(kChannelNumber, kOtherPeerAddr);
+  CreatePermission(kPeerAddr);
+  peer_.SendTo("via indication", relay_address_);
+  ProcessUntilReceived(client_, client_.packets().size() + 1);
+  EXPECT_EQ(TURN_DATA_INDICATION,
+            rtc::GetBE16(client_.packets().back().data()));
+}
+
 }  // namespace cricket
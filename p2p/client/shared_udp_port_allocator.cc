@@ -0,0 +1,434 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/client/shared_udp_port_allocator.h"
+
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "api/transport/stun.h"
+#include "p2p/base/connection.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace cricket {
+
+// The socket of a single port. It forwards to the shared socket, and only
+// signals the packets sent by its port, so that the ports do not see each
+// other's traffic.
+class SharedUdpPortAllocator::PortSocket : public rtc::AsyncPacketSocket {
+ public:
+  explicit PortSocket(SharedUdpPortAllocator* allocator)
+      : allocator_(allocator) {}
+  ~PortSocket() override { allocator_->RemovePortSocket(this); }
+
+  UDPPort* port() const { return port_; }
+  void set_port(UDPPort* port) { port_ = port; }
+  const std::string& ufrag() const { return ufrag_; }
+  void set_ufrag(absl::string_view ufrag) { ufrag_ = std::string(ufrag); }
+
+  // Hands a packet received on the shared socket to the port.
+  void DeliverPacket(const char* data,
+                     size_t size,
+                     const rtc::SocketAddress& remote_addr,
+                     int64_t packet_time_us) {
+    if (port_) {
+      port_->HandleIncomingPacket(this, data, size, remote_addr,
+                                  packet_time_us);
+    }
+  }
+
+  rtc::SocketAddress GetLocalAddress() const override {
+    return allocator_->socket_->GetLocalAddress();
+  }
+  rtc::SocketAddress GetRemoteAddress() const override {
+    return rtc::SocketAddress();
+  }
+  int Send(const void* pv,
+           size_t cb,
+           const rtc::PacketOptions& options) override {
+    return allocator_->socket_->Send(pv, cb, options);
+  }
+  int SendTo(const void* pv,
+             size_t cb,
+             const rtc::SocketAddress& addr,
+             const rtc::PacketOptions& options) override {
+    allocator_->sending_port_socket_ = this;
+    int sent = allocator_->socket_->SendTo(pv, cb, addr, options);
+    allocator_->sending_port_socket_ = nullptr;
+    return sent;
+  }
+  // The shared socket stays open.
+  int Close() override { return 0; }
+  State GetState() const override { return allocator_->socket_->GetState(); }
+  int GetOption(rtc::Socket::Option opt, int* value) override {
+    return allocator_->socket_->GetOption(opt, value);
+  }
+  int SetOption(rtc::Socket::Option opt, int value) override {
+    return allocator_->socket_->SetOption(opt, value);
+  }
+  int GetError() const override { return allocator_->socket_->GetError(); }
+  void SetError(int error) override { allocator_->socket_->SetError(error); }
+
+ private:
+  SharedUdpPortAllocator* const allocator_;
+  UDPPort* port_ = nullptr;
+  std::string ufrag_;
+};
+
+// Host port on the shared socket. Its connections are registered with the
+// allocator, which hands them the packets from their remote address directly.
+class SharedUdpPortAllocator::SharedUdpPort : public UDPPort {
+ public:
+  static std::unique_ptr<SharedUdpPort> Create(
+      SharedUdpPortAllocator* allocator,
+      PortSocket* socket,
+      absl::string_view username,
+      absl::string_view password) {
+    // Using `new` to access a non-public constructor.
+    auto port = absl::WrapUnique(
+        new SharedUdpPort(allocator, socket, username, password));
+    port->set_stun_keepalive_delay(absl::nullopt);
+    if (!port->Init()) {
+      return nullptr;
+    }
+    return port;
+  }
+
+  ~SharedUdpPort() override {
+    // The remaining connections are deleted without notifying
+    // HandleConnectionDestroyed().
+    for (const auto& [address, connection] : connections()) {
+      allocator_->RemoveConnection(connection);
+    }
+  }
+
+  Connection* CreateConnection(const Candidate& address,
+                               CandidateOrigin origin) override {
+    Connection* connection = UDPPort::CreateConnection(address, origin);
+    if (connection) {
+      allocator_->AddConnection(connection);
+    }
+    return connection;
+  }
+
+ protected:
+  void HandleConnectionDestroyed(Connection* connection) override {
+    allocator_->RemoveConnection(connection);
+  }
+
+ private:
+  SharedUdpPort(SharedUdpPortAllocator* allocator,
+                PortSocket* socket,
+                absl::string_view username,
+                absl::string_view password)
+      : UDPPort(allocator->network_thread_,
+                allocator->socket_factory_,
+                &allocator->network_,
+                socket,
+                username,
+                password,
+                /*emit_local_for_anyaddress=*/false,
+                allocator->field_trials_),
+        allocator_(allocator) {}
+
+  SharedUdpPortAllocator* const allocator_;
+};
+
+// Session with the single host port of its ICE credentials on the shared
+// socket. The port is complete as soon as it is created.
+class SharedUdpPortAllocatorSession : public PortAllocatorSession {
+ public:
+  SharedUdpPortAllocatorSession(SharedUdpPortAllocator* allocator,
+                                absl::string_view content_name,
+                                int component,
+                                absl::string_view ice_ufrag,
+                                absl::string_view ice_pwd)
+      : PortAllocatorSession(content_name,
+                             component,
+                             ice_ufrag,
+                             ice_pwd,
+                             allocator->flags()),
+        allocator_(allocator) {}
+
+  void SetCandidateFilter(uint32_t filter) override {
+    candidate_filter_ = filter;
+  }
+
+  void StartGettingPorts() override {
+    if (!port_ && !allocation_done_) {
+      CreatePort();
+    }
+    running_ = true;
+  }
+  void StopGettingPorts() override { running_ = false; }
+  bool IsGettingPorts() override { return running_; }
+  void ClearGettingPorts() override { running_ = false; }
+
+  std::vector<PortInterface*> ReadyPorts() const override {
+    std::vector<PortInterface*> ports;
+    if (port_) {
+      ports.push_back(port_.get());
+    }
+    return ports;
+  }
+  std::vector<Candidate> ReadyCandidates() const override {
+    if (!port_ || !(candidate_filter_ & CF_HOST)) {
+      return std::vector<Candidate>();
+    }
+    return port_->Candidates();
+  }
+  bool CandidatesAllocationDone() const override { return allocation_done_; }
+  void PruneAllPorts() override {
+    if (port_) {
+      port_->Prune();
+    }
+  }
+
+ protected:
+  // Pooled sessions are handed out with new credentials.
+  void UpdateIceParametersInternal() override {
+    if (!port_) {
+      return;
+    }
+    port_->SetIceParameters(component(), username(), password());
+    allocator_->SetPortSocketUfrag(port_socket_.get(), username());
+  }
+
+ private:
+  void CreatePort() {
+    port_socket_ = allocator_->CreatePortSocket(username());
+    port_ = SharedUdpPortAllocator::SharedUdpPort::Create(
+        allocator_, port_socket_.get(), username(), password());
+    if (!port_) {
+      RTC_LOG(LS_WARNING) << "Failed to create port on shared socket "
+                          << allocator_->address_.ToSensitiveString();
+      port_socket_.reset();
+      allocation_done_ = true;
+      SignalCandidatesAllocationDone(this);
+      return;
+    }
+    port_socket_->set_port(port_.get());
+    port_->set_content_name(content_name());
+    port_->set_component(component());
+    port_->set_generation(generation());
+    port_->SubscribePortDestroyed(
+        [this](PortInterface* port) { OnPortDestroyed(port); });
+    port_->SignalPortComplete.connect(
+        this, &SharedUdpPortAllocatorSession::OnPortComplete);
+    port_->KeepAliveUntilPruned();
+    SignalPortReady(this, port_.get());
+    // The shared socket is bound, so the port completes synchronously.
+    port_->PrepareAddress();
+  }
+
+  void OnPortComplete(Port* port) {
+    std::vector<Candidate> candidates = ReadyCandidates();
+    if (!candidates.empty()) {
+      SignalCandidatesReady(this, candidates);
+    }
+    allocation_done_ = true;
+    SignalCandidatesAllocationDone(this);
+  }
+
+  void OnPortDestroyed(PortInterface* port) {
+    RTC_DCHECK_EQ(port, port_.get());
+    // The port deletes itself.
+    port_.release();
+    port_socket_.reset();
+  }
+
+  SharedUdpPortAllocator* const allocator_;
+  std::unique_ptr<SharedUdpPortAllocator::PortSocket> port_socket_;
+  std::unique_ptr<SharedUdpPortAllocator::SharedUdpPort> port_;
+  uint32_t candidate_filter_ = CF_ALL;
+  bool allocation_done_ = false;
+  bool running_ = false;
+};
+
+std::unique_ptr<SharedUdpPortAllocator> SharedUdpPortAllocator::Create(
+    rtc::Thread* network_thread,
+    rtc::PacketSocketFactory* socket_factory,
+    const rtc::SocketAddress& address,
+    const webrtc::FieldTrialsView* field_trials) {
+  RTC_DCHECK(network_thread->IsCurrent());
+  RTC_DCHECK(!address.IsAnyIP());
+  RTC_DCHECK_NE(address.port(), 0);
+  std::unique_ptr<rtc::AsyncPacketSocket> socket(
+      socket_factory->CreateUdpSocket(address, address.port(),
+                                      address.port()));
+  if (!socket) {
+    RTC_LOG(LS_WARNING) << "Failed to bind shared UDP socket to "
+                        << address.ToSensitiveString();
+    return nullptr;
+  }
+  // Using `new` to access a non-public constructor.
+  return absl::WrapUnique(new SharedUdpPortAllocator(
+      network_thread, socket_factory, std::move(socket), field_trials));
+}
+
+SharedUdpPortAllocator::SharedUdpPortAllocator(
+    rtc::Thread* network_thread,
+    rtc::PacketSocketFactory* socket_factory,
+    std::unique_ptr<rtc::AsyncPacketSocket> socket,
+    const webrtc::FieldTrialsView* field_trials)
+    : network_thread_(network_thread),
+      socket_factory_(socket_factory),
+      field_trials_(field_trials),
+      socket_(std::move(socket)),
+      address_(socket_->GetLocalAddress()),
+      network_("shared_udp",
+               "shared_udp",
+               address_.ipaddr(),
+               address_.ipaddr().family() == AF_INET ? 32 : 128,
+               field_trials) {
+  network_.AddIP(address_.ipaddr());
+  socket_->SignalReadPacket.connect(this,
+                                    &SharedUdpPortAllocator::OnReadPacket);
+  socket_->SignalSentPacket.connect(this,
+                                    &SharedUdpPortAllocator::OnSentPacket);
+  socket_->SignalReadyToSend.connect(this,
+                                     &SharedUdpPortAllocator::OnReadyToSend);
+  Initialize();
+}
+
+SharedUdpPortAllocator::~SharedUdpPortAllocator() {
+  CheckRunOnValidThreadIfInitialized();
+  // The sessions depend on us, so destroy the pooled ones first.
+  DiscardCandidatePool();
+  RTC_DCHECK(ports_by_ufrag_.empty());
+}
+
+PortAllocatorSession* SharedUdpPortAllocator::CreateSessionInternal(
+    absl::string_view content_name,
+    int component,
+    absl::string_view ice_ufrag,
+    absl::string_view ice_pwd) {
+  return new SharedUdpPortAllocatorSession(this, content_name, component,
+                                           ice_ufrag, ice_pwd);
+}
+
+std::unique_ptr<SharedUdpPortAllocator::PortSocket>
+SharedUdpPortAllocator::CreatePortSocket(absl::string_view ufrag) {
+  auto port_socket = std::make_unique<PortSocket>(this);
+  SetPortSocketUfrag(port_socket.get(), ufrag);
+  return port_socket;
+}
+
+void SharedUdpPortAllocator::SetPortSocketUfrag(PortSocket* port_socket,
+                                                absl::string_view ufrag) {
+  auto it = ports_by_ufrag_.find(port_socket->ufrag());
+  if (it != ports_by_ufrag_.end() && it->second == port_socket) {
+    ports_by_ufrag_.erase(it);
+  }
+  port_socket->set_ufrag(ufrag);
+  PortSocket*& entry = ports_by_ufrag_[port_socket->ufrag()];
+  if (entry) {
+    RTC_LOG(LS_WARNING) << "Ufrag " << ufrag
+                        << " is used by more than one port on the shared "
+                           "socket; binding requests go to the newest.";
+  }
+  entry = port_socket;
+}
+
+void SharedUdpPortAllocator::RemovePortSocket(PortSocket* port_socket) {
+  auto it = ports_by_ufrag_.find(port_socket->ufrag());
+  if (it != ports_by_ufrag_.end() && it->second == port_socket) {
+    ports_by_ufrag_.erase(it);
+  }
+  if (sending_port_socket_ == port_socket) {
+    sending_port_socket_ = nullptr;
+  }
+}
+
+void SharedUdpPortAllocator::AddConnection(Connection* connection) {
+  const rtc::SocketAddress& address = connection->remote_candidate().address();
+  if (!RemoteAddressIndex<Connection>::IsIndexable(address)) {
+    return;
+  }
+  const Connection* previous = connections_by_address_.Find(address);
+  const Port* port = static_cast<const Connection*>(connection)->port();
+  if (previous && previous->port() != port) {
+    RTC_LOG(LS_WARNING) << "Remote address " << address.ToSensitiveString()
+                        << " moved to the port with ufrag "
+                        << port->username_fragment();
+  }
+  connections_by_address_.Insert(address, connection);
+}
+
+void SharedUdpPortAllocator::RemoveConnection(Connection* connection) {
+  const rtc::SocketAddress& address = connection->remote_candidate().address();
+  // The address may have moved to a newer connection.
+  if (RemoteAddressIndex<Connection>::IsIndexable(address) &&
+      connections_by_address_.Find(address) == connection) {
+    connections_by_address_.Erase(address);
+  }
+}
+
+SharedUdpPortAllocator::PortSocket*
+SharedUdpPortAllocator::FindPortSocketByUsername(const char* data,
+                                                 size_t size) const {
+  StunMessageView view;
+  if (!view.Parse(data, size) || view.type() != STUN_BINDING_REQUEST) {
+    return nullptr;
+  }
+  // The USERNAME of a connectivity check is "<local ufrag>:<remote ufrag>".
+  absl::string_view username = view.GetAttributeValue(STUN_ATTR_USERNAME);
+  size_t colon = username.find(':');
+  if (colon == absl::string_view::npos) {
+    return nullptr;
+  }
+  auto it = ports_by_ufrag_.find(username.substr(0, colon));
+  return it != ports_by_ufrag_.end() ? it->second : nullptr;
+}
+
+void SharedUdpPortAllocator::OnReadPacket(
+    rtc::AsyncPacketSocket* socket,
+    const char* data,
+    size_t size,
+    const rtc::SocketAddress& remote_addr,
+    const int64_t& packet_time_us) {
+  RTC_DCHECK_EQ(socket, socket_.get());
+  if (RemoteAddressIndex<Connection>::IsIndexable(remote_addr)) {
+    if (Connection* connection = connections_by_address_.Find(remote_addr)) {
+      // What UDPPort does for packets from the address of a connection.
+      connection->OnReadPacket(data, size, packet_time_us);
+      return;
+    }
+  }
+  PortSocket* port_socket = FindPortSocketByUsername(data, size);
+  if (!port_socket) {
+    RTC_LOG(LS_VERBOSE) << "Dropping packet of " << size
+                        << " bytes from unknown address "
+                        << remote_addr.ToSensitiveString();
+    return;
+  }
+  port_socket->DeliverPacket(data, size, remote_addr, packet_time_us);
+}
+
+void SharedUdpPortAllocator::OnSentPacket(rtc::AsyncPacketSocket* socket,
+                                          const rtc::SentPacket& sent_packet) {
+  if (sending_port_socket_) {
+    sending_port_socket_->SignalSentPacket(sending_port_socket_, sent_packet);
+  }
+}
+
+void SharedUdpPortAllocator::OnReadyToSend(rtc::AsyncPacketSocket* socket) {
+  std::vector<PortSocket*> port_sockets;
+  port_sockets.reserve(ports_by_ufrag_.size());
+  for (const auto& [ufrag, port_socket] : ports_by_ufrag_) {
+    port_sockets.push_back(port_socket);
+  }
+  for (PortSocket* port_socket : port_sockets) {
+    port_socket->SignalReadyToSend(port_socket);
+  }
+}
+
+}  // namespace cricket
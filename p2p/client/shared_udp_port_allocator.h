@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_CLIENT_SHARED_UDP_PORT_ALLOCATOR_H_
+#define P2P_CLIENT_SHARED_UDP_PORT_ALLOCATOR_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/field_trials_view.h"
+#include "api/packet_socket_factory.h"
+#include "p2p/base/port_allocator.h"
+#include "p2p/base/remote_address_index.h"
+#include "p2p/base/udp_port.h"
+#include "rtc_base/async_packet_socket.h"
+#include "rtc_base/network.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread.h"
+
+namespace cricket {
+
+// Port allocator for servers that terminate ICE for many peers, e.g. an
+// ICE-lite media server. All sessions share a single UDP socket bound to a
+// fixed address, and each session has a single host port on it, so no
+// candidates are gathered and no socket is created per transport.
+//
+// Received packets are demultiplexed to the connection for their remote
+// address, registered when a port creates it, and otherwise to a port by the
+// local ufrag in the USERNAME of a STUN binding request. Other packets from
+// unknown addresses are dropped. Transports sharing the allocator must
+// therefore use distinct ufrags and must not share remote addresses.
+//
+// The allocator only provides the ports; advertising ICE-lite in the session
+// description is up to the application. Socket options set on a port, such as
+// DSCP, apply to the shared socket. Must be created and used on the network
+// thread.
+class RTC_EXPORT SharedUdpPortAllocator : public PortAllocator {
+ public:
+  // Returns null if the socket could not be bound to `address`, which must
+  // have a specific IP and port.
+  static std::unique_ptr<SharedUdpPortAllocator> Create(
+      rtc::Thread* network_thread,
+      rtc::PacketSocketFactory* socket_factory,
+      const rtc::SocketAddress& address,
+      const webrtc::FieldTrialsView* field_trials = nullptr);
+
+  ~SharedUdpPortAllocator() override;
+
+  void SetNetworkIgnoreMask(int network_ignore_mask) override {}
+
+  const rtc::SocketAddress& address() const { return address_; }
+  size_t num_ports() const { return ports_by_ufrag_.size(); }
+
+ protected:
+  PortAllocatorSession* CreateSessionInternal(
+      absl::string_view content_name,
+      int component,
+      absl::string_view ice_ufrag,
+      absl::string_view ice_pwd) override;
+
+ private:
+  class PortSocket;
+  class SharedUdpPort;
+  friend class SharedUdpPortAllocatorSession;
+
+  SharedUdpPortAllocator(rtc::Thread* network_thread,
+                         rtc::PacketSocketFactory* socket_factory,
+                         std::unique_ptr<rtc::AsyncPacketSocket> socket,
+                         const webrtc::FieldTrialsView* field_trials);
+
+  // Called by the sessions to create the socket of their port, which forwards
+  // to the shared socket. Binding requests for `ufrag` are routed to it.
+  std::unique_ptr<PortSocket> CreatePortSocket(absl::string_view ufrag);
+  void SetPortSocketUfrag(PortSocket* port_socket, absl::string_view ufrag);
+  void RemovePortSocket(PortSocket* port_socket);
+  // Routes packets from the remote address of `connection` to it, until it is
+  // removed or another connection is added for the address.
+  void AddConnection(Connection* connection);
+  void RemoveConnection(Connection* connection);
+  PortSocket* FindPortSocketByUsername(const char* data, size_t size) const;
+
+  void OnReadPacket(rtc::AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const rtc::SocketAddress& remote_addr,
+                    const int64_t& packet_time_us);
+  void OnSentPacket(rtc::AsyncPacketSocket* socket,
+                    const rtc::SentPacket& sent_packet);
+  void OnReadyToSend(rtc::AsyncPacketSocket* socket);
+
+  rtc::Thread* const network_thread_;
+  rtc::PacketSocketFactory* const socket_factory_;
+  const webrtc::FieldTrialsView* const field_trials_;
+  const std::unique_ptr<rtc::AsyncPacketSocket> socket_;
+  const rtc::SocketAddress address_;
+  // The network of the host candidates.
+  rtc::Network network_;
+  std::map<std::string, PortSocket*, std::less<>> ports_by_ufrag_;
+  RemoteAddressIndex<Connection> connections_by_address_;
+  // The port socket sending on the shared socket, which the sent packet
+  // notification is for.
+  PortSocket* sending_port_socket_ = nullptr;
+};
+
+}  // namespace cricket
+
+#endif  // P2P_CLIENT_SHARED_UDP_PORT_ALLOCATOR_H_
@@ -0,0 +1,356 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/client/shared_udp_port_allocator.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/transport/stun.h"
+#include "p2p/base/basic_packet_socket_factory.h"
+#include "p2p/base/connection.h"
+#include "p2p/base/p2p_transport_channel.h"
+#include "p2p/client/basic_port_allocator.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/fake_network.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/virtual_socket_server.h"
+#include "test/gtest.h"
+
+namespace cricket {
+namespace {
+
+constexpr int kTimeoutMs = 1000;
+constexpr int kConnectTimeoutMs = 5000;
+constexpr char kRemoteUfrag[] = "remote";
+
+const rtc::SocketAddress kServerAddr("10.0.0.1", 3478);
+const rtc::SocketAddress kClientAddr1("1.1.1.1", 5000);
+const rtc::SocketAddress kClientAddr2("1.1.1.2", 5000);
+
+// A session on the shared socket, which accepts every authenticated binding
+// request like an ICE-lite transport.
+class Session : public sigslot::has_slots<> {
+ public:
+  Session(PortAllocator* allocator, const std::string& ufrag)
+      : ufrag_(ufrag),
+        password_(ufrag + "-password-of-22-chars"),
+        session_(allocator->CreateSession("audio", ICE_CANDIDATE_COMPONENT_RTP,
+                                          ufrag_, password_)) {
+    session_->SignalPortReady.connect(this, &Session::OnPortReady);
+    session_->StartGettingPorts();
+  }
+
+  const std::string& ufrag() const { return ufrag_; }
+  const std::string& password() const { return password_; }
+  PortAllocatorSession* session() { return session_.get(); }
+  PortInterface* port() { return port_; }
+  int num_unknown_addresses() const { return num_unknown_addresses_; }
+  int num_sent_packets() const { return num_sent_packets_; }
+  const std::string& last_data() const { return last_data_; }
+
+ private:
+  void OnPortReady(PortAllocatorSession* session, PortInterface* port) {
+    port_ = port;
+    // ICE-lite agents are always controlled.
+    port->SetIceRole(ICEROLE_CONTROLLED);
+    port->SignalUnknownAddress.connect(this, &Session::OnUnknownAddress);
+    port->SignalSentPacket.connect(this, &Session::OnSentPacket);
+  }
+
+  void OnUnknownAddress(PortInterface* port,
+                        const rtc::SocketAddress& address,
+                        ProtocolType proto,
+                        IceMessage* stun_msg,
+                        const std::string& remote_ufrag,
+                        bool port_muxed) {
+    ++num_unknown_addresses_;
+    Candidate remote_candidate;
+    remote_candidate.set_address(address);
+    remote_candidate.set_component(ICE_CANDIDATE_COMPONENT_RTP);
+    remote_candidate.set_protocol(UDP_PROTOCOL_NAME);
+    remote_candidate.set_username(remote_ufrag);
+    Connection* connection =
+        port->CreateConnection(remote_candidate, PortInterface::ORIGIN_MESSAGE);
+    connection->SignalReadPacket.connect(this, &Session::OnReadPacket);
+    connection->HandleStunBindingOrGoogPingRequest(stun_msg);
+  }
+
+  void OnSentPacket(const rtc::SentPacket& sent_packet) {
+    ++num_sent_packets_;
+  }
+
+  void OnReadPacket(Connection* connection,
+                    const char* data,
+                    size_t size,
+                    int64_t packet_time_us) {
+    last_data_.assign(data, size);
+  }
+
+  const std::string ufrag_;
+  const std::string password_;
+  std::unique_ptr<PortAllocatorSession> session_;
+  PortInterface* port_ = nullptr;
+  int num_unknown_addresses_ = 0;
+  int num_sent_packets_ = 0;
+  std::string last_data_;
+};
+
+class Client : public sigslot::has_slots<> {
+ public:
+  Client(rtc::SocketFactory* socket_factory, const rtc::SocketAddress& address)
+      : socket_(rtc::AsyncUDPSocket::Create(socket_factory, address)) {
+    socket_->SignalReadPacket.connect(this, &Client::OnReadPacket);
+  }
+
+  void SendBindingRequest(const Session& session) {
+    IceMessage request(STUN_BINDING_REQUEST);
+    request.AddAttribute(std::make_unique<StunByteStringAttribute>(
+        STUN_ATTR_USERNAME, session.ufrag() + ":" + kRemoteUfrag));
+    request.AddAttribute(
+        std::make_unique<StunUInt32Attribute>(STUN_ATTR_PRIORITY, 1));
+    request.AddAttribute(std::make_unique<StunUInt64Attribute>(
+        STUN_ATTR_ICE_CONTROLLING, 1));
+    request.AddMessageIntegrity(session.password());
+    request.AddFingerprint();
+    rtc::ByteBufferWriter buf;
+    request.Write(&buf);
+    SendTo(buf.Data(), buf.Length());
+  }
+
+  void SendTo(const void* data, size_t size) {
+    socket_->SendTo(data, size, kServerAddr, rtc::PacketOptions());
+  }
+
+  int num_received() const { return num_received_; }
+
+ private:
+  void OnReadPacket(rtc::AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const rtc::SocketAddress& address,
+                    const int64_t& packet_time_us) {
+    ++num_received_;
+  }
+
+  std::unique_ptr<rtc::AsyncUDPSocket> socket_;
+  int num_received_ = 0;
+};
+
+class SharedUdpPortAllocatorTest : public ::testing::Test {
+ protected:
+  SharedUdpPortAllocatorTest()
+      : thread_(&vss_),
+        socket_factory_(&vss_),
+        allocator_(SharedUdpPortAllocator::Create(&thread_,
+                                                  &socket_factory_,
+                                                  kServerAddr)) {}
+
+  rtc::VirtualSocketServer vss_;
+  rtc::AutoSocketServerThread thread_;
+  rtc::BasicPacketSocketFactory socket_factory_;
+  std::unique_ptr<SharedUdpPortAllocator> allocator_;
+};
+
+TEST_F(SharedUdpPortAllocatorTest, SessionsGetHostCandidateOnSharedSocket) {
+  ASSERT_TRUE(allocator_);
+  EXPECT_EQ(kServerAddr, allocator_->address());
+  Session first(allocator_.get(), "first");
+  Session second(allocator_.get(), "second");
+  EXPECT_EQ(2u, allocator_->num_ports());
+  for (Session* session : {&first, &second}) {
+    ASSERT_TRUE(session->port());
+    EXPECT_TRUE(session->session()->CandidatesAllocationDone());
+    std::vector<Candidate> candidates = session->session()->ReadyCandidates();
+    ASSERT_EQ(1u, candidates.size());
+    EXPECT_EQ(LOCAL_PORT_TYPE, candidates[0].type());
+    EXPECT_EQ(kServerAddr, candidates[0].address());
+    EXPECT_EQ(session->ufrag(), candidates[0].username());
+  }
+}
+
+TEST_F(SharedUdpPortAllocatorTest, CreateFailsIfAddressIsInUse) {
+  ASSERT_TRUE(allocator_);
+  EXPECT_FALSE(
+      SharedUdpPortAllocator::Create(&thread_, &socket_factory_, kServerAddr));
+}
+
+TEST_F(SharedUdpPortAllocatorTest, DemultiplexesByUsernameThenAddress) {
+  Session first(allocator_.get(), "first");
+  Session second(allocator_.get(), "second");
+  Client client1(&vss_, kClientAddr1);
+  Client client2(&vss_, kClientAddr2);
+
+  // Data from an unknown address is dropped.
+  client1.SendTo("data", 4);
+  client1.SendBindingRequest(second);
+  // Answered with a binding response on the shared socket.
+  EXPECT_EQ_WAIT(1, client1.num_received(), kTimeoutMs);
+  EXPECT_EQ(0, first.num_unknown_addresses());
+  EXPECT_EQ(1, second.num_unknown_addresses());
+  EXPECT_EQ(1, second.num_sent_packets());
+  EXPECT_EQ(0, first.num_sent_packets());
+  EXPECT_TRUE(second.last_data().empty());
+
+  client2.SendBindingRequest(first);
+  EXPECT_EQ_WAIT(1, client2.num_received(), kTimeoutMs);
+  EXPECT_EQ(1, first.num_unknown_addresses());
+  EXPECT_EQ(1, second.num_unknown_addresses());
+
+  // Later packets are routed by the remote address.
+  client1.SendTo("to second", 9);
+  client2.SendTo("to first", 8);
+  EXPECT_EQ_WAIT("to second", second.last_data(), kTimeoutMs);
+  EXPECT_EQ_WAIT("to first", first.last_data(), kTimeoutMs);
+}
+
+TEST_F(SharedUdpPortAllocatorTest, DropsBindingRequestsForUnknownUfrag) {
+  Session first(allocator_.get(), "first");
+  Client client(&vss_, kClientAddr1);
+  {
+    Session gone(allocator_.get(), "gone");
+    EXPECT_EQ(2u, allocator_->num_ports());
+    client.SendBindingRequest(gone);
+  }
+  EXPECT_EQ(1u, allocator_->num_ports());
+  client.SendBindingRequest(first);
+  EXPECT_EQ_WAIT(1, client.num_received(), kTimeoutMs);
+  EXPECT_EQ(1, first.num_unknown_addresses());
+}
+
+// A P2PTransportChannel that keeps the last packet it received.
+class Channel : public sigslot::has_slots<> {
+ public:
+  Channel(PortAllocator* allocator,
+          IceRole role,
+          const IceParameters& local,
+          const IceParameters& remote)
+      : channel_("audio", ICE_CANDIDATE_COMPONENT_RTP, allocator) {
+    channel_.SetIceRole(role);
+    channel_.SetIceTiebreaker(role == ICEROLE_CONTROLLING ? 2 : 1);
+    channel_.SetIceParameters(local);
+    channel_.SetRemoteIceParameters(remote);
+    channel_.SignalReadPacket.connect(this, &Channel::OnReadPacket);
+    channel_.MaybeStartGathering();
+  }
+
+  P2PTransportChannel& channel() { return channel_; }
+  const std::string& last_data() const { return last_data_; }
+
+  void Send(const std::string& data) {
+    channel_.SendPacket(data.data(), data.size(), rtc::PacketOptions(), 0);
+  }
+
+ private:
+  void OnReadPacket(rtc::PacketTransportInternal* transport,
+                    const char* data,
+                    size_t size,
+                    const int64_t& packet_time_us,
+                    int flags) {
+    last_data_.assign(data, size);
+  }
+
+  P2PTransportChannel channel_;
+  std::string last_data_;
+};
+
+// A peer on its own address, gathering a host candidate with a
+// BasicPortAllocator.
+class Peer {
+ public:
+  Peer(rtc::PacketSocketFactory* socket_factory,
+       const rtc::SocketAddress& address,
+       absl::string_view ufrag)
+      : allocator_(&network_manager_, socket_factory) {
+    network_manager_.AddInterface(address);
+    allocator_.set_flags(PORTALLOCATOR_DISABLE_TCP |
+                         PORTALLOCATOR_DISABLE_STUN |
+                         PORTALLOCATOR_DISABLE_RELAY);
+    allocator_.Initialize();
+    parameters_ = IceParameters(std::string(ufrag),
+                                std::string(ufrag) + "-password-of-22-chars",
+                                /*renomination=*/false);
+  }
+
+  // Connects to `server`, whose host candidate is on `server_address`.
+  void Connect(const IceParameters& server,
+               const rtc::SocketAddress& server_address) {
+    channel_ = std::make_unique<Channel>(&allocator_, ICEROLE_CONTROLLING,
+                                         parameters_, server);
+    Candidate candidate(ICE_CANDIDATE_COMPONENT_RTP, UDP_PROTOCOL_NAME,
+                        server_address, /*priority=*/1, server.ufrag,
+                        server.pwd, LOCAL_PORT_TYPE, /*generation=*/0,
+                        /*foundation=*/"1");
+    channel_->channel().AddRemoteCandidate(candidate);
+  }
+
+  const IceParameters& parameters() const { return parameters_; }
+  Channel& channel() { return *channel_; }
+
+ private:
+  rtc::FakeNetworkManager network_manager_;
+  BasicPortAllocator allocator_;
+  IceParameters parameters_;
+  std::unique_ptr<Channel> channel_;
+};
+
+TEST_F(SharedUdpPortAllocatorTest, ConnectsP2PTransportChannels) {
+  const IceParameters server_parameters1("server1", "server1-password-of-22",
+                                         /*renomination=*/false);
+  const IceParameters server_parameters2("server2", "server2-password-of-22",
+                                         /*renomination=*/false);
+  Peer peer1(&socket_factory_, kClientAddr1, "peer1");
+  Peer peer2(&socket_factory_, kClientAddr2, "peer2");
+  // The server side learns the peer candidates from their checks.
+  auto server1 = std::make_unique<Channel>(
+      allocator_.get(), ICEROLE_CONTROLLED, server_parameters1,
+      peer1.parameters());
+  Channel server2(allocator_.get(), ICEROLE_CONTROLLED, server_parameters2,
+                  peer2.parameters());
+  EXPECT_EQ(2u, allocator_->num_ports());
+  peer1.Connect(server_parameters1, kServerAddr);
+  peer2.Connect(server_parameters2, kServerAddr);
+
+  EXPECT_TRUE_WAIT(server1->channel().writable() &&
+                       server2.channel().writable() &&
+                       peer1.channel().channel().writable() &&
+                       peer2.channel().channel().writable(),
+                   kConnectTimeoutMs);
+  for (Channel* channel : {server1.get(), &server2}) {
+    ASSERT_TRUE(channel->channel().selected_connection());
+    EXPECT_EQ(kServerAddr, channel->channel()
+                               .selected_connection()
+                               ->local_candidate()
+                               .address());
+  }
+
+  peer1.channel().Send("to server1");
+  peer2.channel().Send("to server2");
+  server1->Send("to peer1");
+  server2.Send("to peer2");
+  EXPECT_EQ_WAIT("to server1", server1->last_data(), kTimeoutMs);
+  EXPECT_EQ_WAIT("to server2", server2.last_data(), kTimeoutMs);
+  EXPECT_EQ_WAIT("to peer1", peer1.channel().last_data(), kTimeoutMs);
+  EXPECT_EQ_WAIT("to peer2", peer2.channel().last_data(), kTimeoutMs);
+
+  // The connections of a destroyed channel no longer receive packets.
+  server1.reset();
+  EXPECT_EQ(1u, allocator_->num_ports());
+  peer1.channel().Send("dropped");
+  peer2.channel().Send("still to server2");
+  EXPECT_EQ_WAIT("still to server2", server2.last_data(), kTimeoutMs);
+}
+
+}  // namespace
+}  // namespace cricket
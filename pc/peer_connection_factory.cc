@@ -105,7 +105,8 @@ PeerConnectionFactory::PeerConnectionFactory(
           (dependencies->transport_controller_send_factory)
               ? std::move(dependencies->transport_controller_send_factory)
               : std::make_unique<RtpTransportControllerSendFactory>()),
-      metronome_(std::move(dependencies->metronome)) {}
+      metronome_(std::move(dependencies->metronome)),
+      certificate_pool_(std::move(dependencies->certificate_pool)) {}
 
 PeerConnectionFactory::PeerConnectionFactory(
     PeerConnectionFactoryDependencies dependencies)
@@ -210,6 +211,11 @@ PeerConnectionFactory::CreatePeerConnectionOrError(
     dependencies.cert_generator =
         std::make_unique<rtc::RTCCertificateGenerator>(signaling_thread(),
                                                        network_thread());
+    if (certificate_pool_) {
+      dependencies.cert_generator =
+          std::make_unique<rtc::PooledRTCCertificateGenerator>(
+              certificate_pool_, std::move(dependencies.cert_generator));
+    }
   }
   if (!dependencies.allocator) {
     dependencies.allocator = std::make_unique<cricket::BasicPortAllocator>(
@@ -43,6 +43,7 @@
 #include "pc/connection_context.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/rtc_certificate_generator.h"
+#include "rtc_base/rtc_certificate_pool.h"
 #include "rtc_base/thread.h"
 #include "rtc_base/thread_annotations.h"
 
@@ -157,6 +158,7 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   const std::unique_ptr<RtpTransportControllerSendFactoryInterface>
       transport_controller_send_factory_;
   std::unique_ptr<Metronome> metronome_;
+  const rtc::scoped_refptr<rtc::RTCCertificatePool> certificate_pool_;
 };
 
 }  // namespace webrtc
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/crc32_pclmul.h"
+
+#include <emmintrin.h>
+#include <smmintrin.h>
+#include <wmmintrin.h>
+
+#include "rtc_base/checks.h"
+
+namespace rtc {
+namespace crc32_internal {
+
+namespace {
+
+// Folding constants for the reflected CRC32 polynomial 0xEDB88320, from
+// "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction",
+// Intel, 2009. k1 and k2 fold by 512 bits, k3 and k4 by 128 bits, k5 folds 64
+// bits to 32 bits, and the last pair is the Barrett reduction constants.
+alignas(16) constexpr uint64_t kK1K2[] = {0x0154442bd4, 0x01c6e41596};
+alignas(16) constexpr uint64_t kK3K4[] = {0x01751997d0, 0x00ccaa009e};
+alignas(16) constexpr uint64_t kK5[] = {0x0163cd6124, 0x0000000000};
+alignas(16) constexpr uint64_t kPoly[] = {0x01db710641, 0x01f7011641};
+
+__m128i Load(const uint8_t* buf) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf));
+}
+
+// Returns `x` multiplied by `k` modulo the polynomial, xored with `data`.
+__m128i Fold(__m128i x, __m128i k, __m128i data) {
+  const __m128i low = _mm_clmulepi64_si128(x, k, 0x00);
+  const __m128i high = _mm_clmulepi64_si128(x, k, 0x11);
+  return _mm_xor_si128(_mm_xor_si128(high, low), data);
+}
+
+}  // namespace
+
+uint32_t UpdateCrc32Pclmul(uint32_t crc, const uint8_t* buf, size_t len) {
+  RTC_DCHECK_GE(len, 64);
+  RTC_DCHECK_EQ(len % 16, 0);
+
+  __m128i x1 = _mm_xor_si128(Load(buf), _mm_cvtsi32_si128(crc));
+  __m128i x2 = Load(buf + 16);
+  __m128i x3 = Load(buf + 32);
+  __m128i x4 = Load(buf + 48);
+  buf += 64;
+  len -= 64;
+
+  // Fold four 128-bit lanes in parallel.
+  __m128i k = _mm_load_si128(reinterpret_cast<const __m128i*>(kK1K2));
+  while (len >= 64) {
+    x1 = Fold(x1, k, Load(buf));
+    x2 = Fold(x2, k, Load(buf + 16));
+    x3 = Fold(x3, k, Load(buf + 32));
+    x4 = Fold(x4, k, Load(buf + 48));
+    buf += 64;
+    len -= 64;
+  }
+
+  // Fold the lanes into one, then the remaining 16-byte blocks.
+  k = _mm_load_si128(reinterpret_cast<const __m128i*>(kK3K4));
+  x1 = Fold(x1, k, x2);
+  x1 = Fold(x1, k, x3);
+  x1 = Fold(x1, k, x4);
+  while (len >= 16) {
+    x1 = Fold(x1, k, Load(buf));
+    buf += 16;
+    len -= 16;
+  }
+
+  // Fold 128 bits to 64 bits.
+  const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+  x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+  k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(kK5));
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), k, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  // Barrett reduction to 32 bits.
+  k = _mm_load_si128(reinterpret_cast<const __m128i*>(kPoly));
+  x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), k, 0x10);
+  x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask), k, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+  return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+}  // namespace crc32_internal
+}  // namespace rtc
@@ -0,0 +1,29 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_CRC32_PCLMUL_H_
+#define RTC_BASE_CRC32_PCLMUL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace rtc {
+namespace crc32_internal {
+
+// Updates the CRC32 register `crc`, i.e. the checksum before the final
+// inversion, with `len` bytes from `buf` by folding 64 bytes at a time with
+// carry-less multiplications. `len` must be a multiple of 16 and at least 64.
+// Must only be called when the CPU supports SSE4.1 and PCLMULQDQ.
+uint32_t UpdateCrc32Pclmul(uint32_t crc, const uint8_t* buf, size_t len);
+
+}  // namespace crc32_internal
+}  // namespace rtc
+
+#endif  // RTC_BASE_CRC32_PCLMUL_H_
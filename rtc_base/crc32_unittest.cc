@@ -11,6 +11,7 @@
 #include "rtc_base/crc32.h"
 
 #include <string>
+#include <vector>
 
 #include "test/gtest.h"
 
@@ -34,4 +35,49 @@ TEST(Crc32Test, TestMultipleUpdates) {
   EXPECT_EQ(0x171A3F5FU, c);
 }
 
+namespace {
+
+// Bit by bit reference implementation.
+uint32_t ReferenceCrc32(const uint8_t* buf, size_t len) {
+  uint32_t c = 0xFFFFFFFF;
+  for (size_t i = 0; i < len; ++i) {
+    c ^= buf[i];
+    for (int j = 0; j < 8; ++j) {
+      c = (c & 1) ? (c >> 1) ^ 0xEDB88320 : c >> 1;
+    }
+  }
+  return c ^ 0xFFFFFFFF;
+}
+
+}  // namespace
+
+// Covers the lengths and alignments where the accelerated implementations
+// fold blocks and hand the rest to the table.
+TEST(Crc32Test, TestMatchesReference) {
+  std::vector<uint8_t> buffer(1024 + 16);
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    buffer[i] = static_cast<uint8_t>(i * 131 + (i >> 3));
+  }
+  for (size_t offset = 0; offset < 16; offset += 5) {
+    for (size_t len = 0; len <= 1024; len += (len < 300 ? 1 : 61)) {
+      const uint8_t* data = buffer.data() + offset;
+      EXPECT_EQ(ReferenceCrc32(data, len), ComputeCrc32(data, len))
+          << "offset " << offset << ", length " << len;
+    }
+  }
+}
+
+TEST(Crc32Test, TestMultipleLargeUpdates) {
+  std::vector<uint8_t> buffer(500);
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    buffer[i] = static_cast<uint8_t>(i ^ 0x5A);
+  }
+  const uint32_t expected = ReferenceCrc32(buffer.data(), buffer.size());
+  for (size_t split : {1, 63, 64, 65, 100, 250, 499}) {
+    uint32_t c = UpdateCrc32(0, buffer.data(), split);
+    c = UpdateCrc32(c, buffer.data() + split, buffer.size() - split);
+    EXPECT_EQ(expected, c) << "split " << split;
+  }
+}
+
 }  // namespace rtc
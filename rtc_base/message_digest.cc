@@ -40,6 +40,16 @@ MessageDigest* MessageDigestFactory::Create(absl::string_view alg) {
   return digest;
 }
 
+MessageDigest* MessageDigestFactory::CreateHmac(absl::string_view alg,
+                                                absl::string_view key) {
+  MessageDigest* digest = new OpenSSLHmac(alg, key);
+  if (digest->Size() == 0) {  // invalid algorithm
+    delete digest;
+    digest = nullptr;
+  }
+  return digest;
+}
+
 bool IsFips180DigestAlgorithm(absl::string_view alg) {
   // These are the FIPS 180 algorithms.  According to RFC 4572 Section 5,
   // "Self-signed certificates (for which legacy certificates are not a
@@ -45,6 +45,12 @@ class MessageDigest {
 class MessageDigestFactory {
  public:
   static MessageDigest* Create(absl::string_view alg);
+  // Creates a digest that computes RFC 2104 HMACs of its input with `key`.
+  // The padded key is hashed once here, so each HMAC only costs hashing the
+  // input and the inner digest, which is what makes it worth keeping for a
+  // key that signs many short messages. Finish() resets to the keyed state.
+  static MessageDigest* CreateHmac(absl::string_view alg,
+                                   absl::string_view key);
 };
 
 // A check that an algorithm is in a list of approved digest algorithms
@@ -10,6 +10,8 @@
 
 #include "rtc_base/message_digest.h"
 
+#include <memory>
+
 #include "absl/strings/string_view.h"
 #include "rtc_base/string_encode.h"
 #include "test/gtest.h"
@@ -153,4 +155,39 @@ TEST(MessageDigestTest, TestBadHmac) {
   EXPECT_EQ("", ComputeHmac("sha-9000", "key", "abc"));
 }
 
+// Test vectors from RFC 2202, computed with keyed digests that are reused.
+TEST(MessageDigestTest, TestKeyedHmac) {
+  std::unique_ptr<MessageDigest> hmac(
+      MessageDigestFactory::CreateHmac(DIGEST_SHA_1, "Jefe"));
+  ASSERT_TRUE(hmac);
+  EXPECT_EQ(20U, hmac->Size());
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ("effcdf6ae5eb2fa2d27416d5f184df9c259a7c79",
+              ComputeDigest(hmac.get(), "what do ya want for nothing?"));
+  }
+
+  // Input given in several updates.
+  hmac.reset(MessageDigestFactory::CreateHmac(DIGEST_SHA_1,
+                                              std::string(80, '\xaa')));
+  ASSERT_TRUE(hmac);
+  absl::string_view input =
+      "Test Using Larger Than Block-Size Key and Larger "
+      "Than One Block-Size Data";
+  hmac->Update(input.data(), 10);
+  hmac->Update(input.data() + 10, input.size() - 10);
+  char output[20];
+  EXPECT_EQ(sizeof(output), hmac->Finish(output, sizeof(output)));
+  EXPECT_EQ("e8e99d0f45237d786d6bbaa7965c7808bbff1a91",
+            hex_encode(absl::string_view(output, sizeof(output))));
+  EXPECT_EQ(0U, hmac->Finish(output, sizeof(output) - 1));
+
+  hmac.reset(
+      MessageDigestFactory::CreateHmac(DIGEST_MD5, std::string(16, '\x0b')));
+  ASSERT_TRUE(hmac);
+  EXPECT_EQ("9294727a3638bb1c13f48ef8158bfc9d",
+            ComputeDigest(hmac.get(), "Hi There"));
+
+  EXPECT_EQ(nullptr, MessageDigestFactory::CreateHmac("sha-9000", "key"));
+}
+
 }  // namespace rtc
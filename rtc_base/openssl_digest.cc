@@ -10,12 +10,19 @@
 
 #include "rtc_base/openssl_digest.h"
 
+#include <string.h>
+
 #include "absl/strings/string_view.h"
 #include "rtc_base/checks.h"  // RTC_DCHECK, RTC_CHECK
 #include "rtc_base/openssl.h"
 
 namespace rtc {
 
+namespace {
+// Block size of SHA-384 and SHA-512, the largest of the supported digests.
+constexpr size_t kMaxBlockSize = 128;
+}  // namespace
+
 OpenSSLDigest::OpenSSLDigest(absl::string_view algorithm) {
   ctx_ = EVP_MD_CTX_new();
   RTC_CHECK(ctx_ != nullptr);
@@ -56,6 +63,76 @@ size_t OpenSSLDigest::Finish(void* buf, size_t len) {
   return md_len;
 }
 
+OpenSSLHmac::OpenSSLHmac(absl::string_view algorithm, absl::string_view key) {
+  if (!OpenSSLDigest::GetDigestEVP(algorithm, &md_)) {
+    md_ = nullptr;
+    return;
+  }
+  inner_ = EVP_MD_CTX_new();
+  outer_ = EVP_MD_CTX_new();
+  ctx_ = EVP_MD_CTX_new();
+  RTC_CHECK(inner_ != nullptr && outer_ != nullptr && ctx_ != nullptr);
+
+  // Keys longer than a block are hashed first (RFC 2104, section 2).
+  const size_t block_size = EVP_MD_block_size(md_);
+  unsigned char padded_key[kMaxBlockSize] = {};
+  RTC_CHECK_LE(block_size, sizeof(padded_key));
+  if (key.size() > block_size) {
+    unsigned int md_len;
+    EVP_Digest(key.data(), key.size(), padded_key, &md_len, md_, nullptr);
+  } else {
+    memcpy(padded_key, key.data(), key.size());
+  }
+
+  unsigned char pad[kMaxBlockSize];
+  for (size_t i = 0; i < block_size; ++i) {
+    pad[i] = padded_key[i] ^ 0x36;
+  }
+  EVP_DigestInit_ex(inner_, md_, nullptr);
+  EVP_DigestUpdate(inner_, pad, block_size);
+  for (size_t i = 0; i < block_size; ++i) {
+    pad[i] = padded_key[i] ^ 0x5c;
+  }
+  EVP_DigestInit_ex(outer_, md_, nullptr);
+  EVP_DigestUpdate(outer_, pad, block_size);
+  EVP_MD_CTX_copy_ex(ctx_, inner_);
+}
+
+OpenSSLHmac::~OpenSSLHmac() {
+  EVP_MD_CTX_free(ctx_);
+  EVP_MD_CTX_free(outer_);
+  EVP_MD_CTX_free(inner_);
+}
+
+size_t OpenSSLHmac::Size() const {
+  if (!md_) {
+    return 0;
+  }
+  return EVP_MD_size(md_);
+}
+
+void OpenSSLHmac::Update(const void* buf, size_t len) {
+  if (!md_) {
+    return;
+  }
+  EVP_DigestUpdate(ctx_, buf, len);
+}
+
+size_t OpenSSLHmac::Finish(void* buf, size_t len) {
+  if (!md_ || len < Size()) {
+    return 0;
+  }
+  unsigned char inner_digest[EVP_MAX_MD_SIZE];
+  unsigned int md_len;
+  EVP_DigestFinal_ex(ctx_, inner_digest, &md_len);
+  EVP_MD_CTX_copy_ex(ctx_, outer_);
+  EVP_DigestUpdate(ctx_, inner_digest, md_len);
+  EVP_DigestFinal_ex(ctx_, static_cast<unsigned char*>(buf), &md_len);
+  EVP_MD_CTX_copy_ex(ctx_, inner_);  // prepare for future Update()s
+  RTC_DCHECK(md_len == Size());
+  return md_len;
+}
+
 bool OpenSSLDigest::GetDigestEVP(absl::string_view algorithm,
                                  const EVP_MD** mdp) {
   const EVP_MD* md;
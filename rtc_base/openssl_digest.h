@@ -46,6 +46,28 @@ class OpenSSLDigest final : public MessageDigest {
   const EVP_MD* md_;
 };
 
+// An HMAC with a fixed key, using OpenSSL digests. The digest states after
+// hashing the inner and outer padded keys are computed once and copied for
+// each HMAC.
+class OpenSSLHmac final : public MessageDigest {
+ public:
+  OpenSSLHmac(absl::string_view algorithm, absl::string_view key);
+  ~OpenSSLHmac() override;
+  // Returns the HMAC output size, i.e. the digest size.
+  size_t Size() const override;
+  // Updates the HMAC with `len` bytes from `buf`.
+  void Update(const void* buf, size_t len) override;
+  // Outputs the HMAC of the input since the last Finish() to `buf` with length
+  // `len`.
+  size_t Finish(void* buf, size_t len) override;
+
+ private:
+  const EVP_MD* md_ = nullptr;
+  EVP_MD_CTX* inner_ = nullptr;
+  EVP_MD_CTX* outer_ = nullptr;
+  EVP_MD_CTX* ctx_ = nullptr;
+};
+
 }  // namespace rtc
 
 #endif  // RTC_BASE_OPENSSL_DIGEST_H_
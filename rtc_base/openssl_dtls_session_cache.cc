@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/openssl_dtls_session_cache.h"
+
+#include <openssl/rand.h>
+#include <openssl/ssl.h>
+
+#include "absl/strings/string_view.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/openssl.h"
+
+namespace rtc {
+
+namespace {
+
+// A session with its certificate chain takes a few kilobytes.
+constexpr size_t kMaxSessions = 1024;
+
+}  // namespace
+
+// static
+OpenSSLDtlsSessionCache* OpenSSLDtlsSessionCache::Get() {
+  static OpenSSLDtlsSessionCache* const cache =
+      new OpenSSLDtlsSessionCache(kMaxSessions);
+  return cache;
+}
+
+OpenSSLDtlsSessionCache::OpenSSLDtlsSessionCache(size_t max_sessions)
+    : max_sessions_(max_sessions) {
+  RTC_DCHECK_GT(max_sessions_, 0);
+  RTC_CHECK_EQ(RAND_bytes(ticket_keys_, sizeof(ticket_keys_)), 1);
+}
+
+OpenSSLDtlsSessionCache::~OpenSSLDtlsSessionCache() {
+  for (const Entry& entry : sessions_) {
+    SSL_SESSION_free(entry.session);
+  }
+}
+
+SSL_SESSION* OpenSSLDtlsSessionCache::LookupSession(absl::string_view key) {
+  webrtc::MutexLock lock(&mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  sessions_.splice(sessions_.begin(), sessions_, it->second);
+  SSL_SESSION* session = it->second->session;
+  SSL_SESSION_up_ref(session);
+  return session;
+}
+
+void OpenSSLDtlsSessionCache::AddSession(absl::string_view key,
+                                         SSL_SESSION* session) {
+  RTC_DCHECK(session);
+  webrtc::MutexLock lock(&mutex_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    SSL_SESSION_free(it->second->session);
+    it->second->session = session;
+    sessions_.splice(sessions_.begin(), sessions_, it->second);
+    return;
+  }
+  if (sessions_.size() == max_sessions_) {
+    index_.erase(sessions_.back().key);
+    SSL_SESSION_free(sessions_.back().session);
+    sessions_.pop_back();
+  }
+  sessions_.push_front({std::string(key), session});
+  index_.emplace(sessions_.front().key, sessions_.begin());
+}
+
+void OpenSSLDtlsSessionCache::RemoveSession(absl::string_view key) {
+  webrtc::MutexLock lock(&mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return;
+  }
+  SSL_SESSION_free(it->second->session);
+  sessions_.erase(it->second);
+  index_.erase(it);
+}
+
+size_t OpenSSLDtlsSessionCache::size() const {
+  webrtc::MutexLock lock(&mutex_);
+  return sessions_.size();
+}
+
+}  // namespace rtc
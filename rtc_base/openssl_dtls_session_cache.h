@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_OPENSSL_DTLS_SESSION_CACHE_H_
+#define RTC_BASE_OPENSSL_DTLS_SESSION_CACHE_H_
+
+#include <openssl/ossl_typ.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+#include <map>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "rtc_base/string_utils.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+#ifndef OPENSSL_IS_BORINGSSL
+typedef struct ssl_session_st SSL_SESSION;
+#endif
+
+namespace rtc {
+
+// Holds the sessions of the OpenSSLStreamAdapters that enable session
+// resumption. Unlike the OpenSSLSessionCache of the TLS adapters, it is not
+// tied to an SSL_CTX, since each stream adapter has its own, and it is shared
+// by the whole process so that sessions survive the transports being
+// recreated. The least recently used sessions are evicted when the cache is
+// full. It also holds the keys that session tickets are encrypted with, so
+// that a ticket issued by one stream adapter can be accepted by another.
+// The cache is thread-safe.
+class OpenSSLDtlsSessionCache final {
+ public:
+  // Returns the cache shared by the stream adapters of the process.
+  static OpenSSLDtlsSessionCache* Get();
+
+  explicit OpenSSLDtlsSessionCache(size_t max_sessions);
+  // Frees the cached SSL_SESSIONs.
+  ~OpenSSLDtlsSessionCache();
+
+  OpenSSLDtlsSessionCache(const OpenSSLDtlsSessionCache&) = delete;
+  OpenSSLDtlsSessionCache& operator=(const OpenSSLDtlsSessionCache&) = delete;
+
+  // Looks up a session by key. The returned SSL_SESSION is up_refed, and must
+  // be freed by the caller.
+  SSL_SESSION* LookupSession(absl::string_view key);
+  // Adds a session to the cache, taking over the reference of the caller. Any
+  // existing session with the same key is replaced.
+  void AddSession(absl::string_view key, SSL_SESSION* session);
+  void RemoveSession(absl::string_view key);
+  size_t size() const;
+
+  // Keys to pass to SSL_CTX_set_tlsext_ticket_keys. They are random for each
+  // process.
+  const uint8_t* ticket_keys() const { return ticket_keys_; }
+  size_t ticket_keys_size() const { return sizeof(ticket_keys_); }
+
+ private:
+  struct Entry {
+    std::string key;
+    SSL_SESSION* session;
+  };
+
+  const size_t max_sessions_;
+  mutable webrtc::Mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> sessions_ RTC_GUARDED_BY(mutex_);
+  std::map<std::string, std::list<Entry>::iterator, AbslStringViewCmp> index_
+      RTC_GUARDED_BY(mutex_);
+#ifdef OPENSSL_IS_BORINGSSL
+  uint8_t ticket_keys_[48];
+#else
+  uint8_t ticket_keys_[80];
+#endif
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_OPENSSL_DTLS_SESSION_CACHE_H_
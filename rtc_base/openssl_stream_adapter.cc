@@ -30,10 +30,12 @@
 
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/message_digest.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/openssl.h"
 #include "rtc_base/openssl_adapter.h"
 #include "rtc_base/openssl_digest.h"
+#include "rtc_base/openssl_dtls_session_cache.h"
 #ifdef OPENSSL_IS_BORINGSSL
 #include "rtc_base/boringssl_identity.h"
 #else
@@ -155,6 +157,37 @@ void TimeCallbackForTesting(const SSL* ssl, struct timeval* out_clock) {
 }
 #endif
 
+// Returns the certificate chain that the peer presented, which for a resumed
+// session is the one from the handshake that established it.
+std::unique_ptr<SSLCertChain> GetPeerCertChain(SSL* ssl) {
+#ifdef OPENSSL_IS_BORINGSSL
+  const STACK_OF(CRYPTO_BUFFER)* chain = SSL_get0_peer_certificates(ssl);
+  if (!chain) {
+    return nullptr;
+  }
+  // Creates certificate chain.
+  std::vector<std::unique_ptr<SSLCertificate>> cert_chain;
+  for (CRYPTO_BUFFER* cert : chain) {
+    cert_chain.emplace_back(new BoringSSLCertificate(bssl::UpRef(cert)));
+  }
+  return std::make_unique<SSLCertChain>(std::move(cert_chain));
+#else
+  X509* cert = SSL_get_peer_certificate(ssl);
+  if (!cert) {
+    return nullptr;
+  }
+  auto certificate = std::make_unique<OpenSSLCertificate>(cert);
+  X509_free(cert);
+  return std::make_unique<SSLCertChain>(std::move(certificate));
+#endif
+}
+
+std::string ServerSessionKey(const uint8_t* id, size_t id_length) {
+  return "server/" +
+         hex_encode(absl::string_view(reinterpret_cast<const char*>(id),
+                                      id_length));
+}
+
 }  // namespace
 
 //////////////////////////////////////////////////////////////////////
@@ -518,6 +551,10 @@ bool OpenSSLStreamAdapter::IsTlsConnected() {
   return state_ == SSL_CONNECTED;
 }
 
+SSLHandshakeStats OpenSSLStreamAdapter::GetHandshakeStats() const {
+  return handshake_stats_;
+}
+
 int OpenSSLStreamAdapter::StartSSL() {
   // Don't allow StartSSL to be called twice.
   if (state_ != SSL_NONE) {
@@ -553,6 +590,11 @@ void OpenSSLStreamAdapter::SetInitialRetransmissionTimeout(int timeout_ms) {
   dtls_handshake_timeout_ms_ = timeout_ms;
 }
 
+void OpenSSLStreamAdapter::SetSessionResumptionEnabled(bool enabled) {
+  RTC_DCHECK(ssl_ctx_ == nullptr);
+  session_resumption_enabled_ = enabled;
+}
+
 //
 // StreamInterface Implementation
 //
@@ -841,6 +883,8 @@ void OpenSSLStreamAdapter::SetTimeout(int delay_ms) {
           int res = DTLSv1_handle_timeout(ssl_);
           if (res > 0) {
             RTC_LOG(LS_INFO) << "DTLS retransmission";
+            ++handshake_stats_.retransmissions;
+            handshake_bytes_written_ = BIO_number_written(SSL_get_wbio(ssl_));
           } else if (res < 0) {
             RTC_LOG(LS_INFO) << "DTLSv1_handle_timeout() return -1";
             Error("DTLSv1_handle_timeout", res, -1, true);
@@ -881,6 +925,9 @@ int OpenSSLStreamAdapter::BeginSSL() {
   }
 
   SSL_set_app_data(ssl_, this);
+  if (session_resumption_enabled_) {
+    SetupSessionResumption();
+  }
 
   SSL_set_bio(ssl_, bio, bio);  // the SSL object owns the bio now.
   if (ssl_mode_ == SSL_MODE_DTLS) {
@@ -900,6 +947,37 @@ int OpenSSLStreamAdapter::BeginSSL() {
   return ContinueSSL();
 }
 
+void OpenSSLStreamAdapter::SetupSessionResumption() {
+  // Sessions are only resumed with the same local certificate: the server
+  // checks the session ID context, and the client looks up sessions by it.
+  unsigned char local_digest[EVP_MAX_MD_SIZE];
+  size_t local_digest_length;
+  if (!identity_ || !identity_->certificate().ComputeDigest(
+                        DIGEST_SHA_256, local_digest, sizeof(local_digest),
+                        &local_digest_length)) {
+    return;
+  }
+  SSL_set_session_id_context(ssl_, local_digest, local_digest_length);
+  if (role_ != SSL_CLIENT || !HasPeerCertificateDigest()) {
+    return;
+  }
+
+  session_cache_key_ = "client/" +
+                       hex_encode(absl::string_view(
+                           reinterpret_cast<const char*>(local_digest),
+                           local_digest_length)) +
+                       "/" + peer_certificate_digest_algorithm_ + "/" +
+                       hex_encode(absl::string_view(
+                           peer_certificate_digest_value_.data<char>(),
+                           peer_certificate_digest_value_.size()));
+  SSL_SESSION* session =
+      OpenSSLDtlsSessionCache::Get()->LookupSession(session_cache_key_);
+  if (session) {
+    SSL_set_session(ssl_, session);
+    SSL_SESSION_free(session);
+  }
+}
+
 int OpenSSLStreamAdapter::ContinueSSL() {
   RTC_DLOG(LS_VERBOSE) << "ContinueSSL";
   RTC_DCHECK(state_ == SSL_CONNECTING);
@@ -907,12 +985,27 @@ int OpenSSLStreamAdapter::ContinueSSL() {
   // Clear the DTLS timer
   timeout_task_.Stop();
 
+  const int64_t start_us = TimeMicros();
   const int code = (role_ == SSL_CLIENT) ? SSL_connect(ssl_) : SSL_accept(ssl_);
   const int ssl_error = SSL_get_error(ssl_, code);
+  handshake_stats_.processing_time_us += TimeMicros() - start_us;
 
   switch (ssl_error) {
     case SSL_ERROR_NONE:
       RTC_DLOG(LS_VERBOSE) << " -- success";
+      handshake_stats_.session_resumed = SSL_session_reused(ssl_);
+      if (handshake_stats_.session_resumed && !peer_cert_chain_) {
+        // The verify callback does not run when a session is resumed, so the
+        // certificate presented when the session was established is checked
+        // here instead.
+        peer_cert_chain_ = GetPeerCertChain(ssl_);
+        if (!peer_cert_chain_ ||
+            (HasPeerCertificateDigest() && !VerifyPeerCertificate())) {
+          RTC_LOG(LS_WARNING) << "Rejected certificate of resumed session.";
+          SignalSSLHandshakeError(SSLHandshakeError::UNKNOWN);
+          return -1;
+        }
+      }
       // By this point, OpenSSL should have given us a certificate, or errored
       // out if one was missing.
       RTC_DCHECK(peer_cert_chain_ || !GetClientAuthEnabled());
@@ -933,6 +1026,12 @@ int OpenSSLStreamAdapter::ContinueSSL() {
 
     case SSL_ERROR_WANT_READ: {
       RTC_DLOG(LS_VERBOSE) << " -- error want read";
+      // Waiting for the answer to a new flight is a round trip.
+      const uint64_t bytes_written = BIO_number_written(SSL_get_wbio(ssl_));
+      if (bytes_written != handshake_bytes_written_) {
+        ++handshake_stats_.round_trips;
+        handshake_bytes_written_ = bytes_written;
+      }
       struct timeval timeout;
       if (DTLSv1_get_timeout(ssl_, &timeout)) {
         int delay = timeout.tv_sec * 1000 + timeout.tv_usec / 1000;
@@ -1111,6 +1210,26 @@ SSL_CTX* OpenSSLStreamAdapter::SetupSSLContext() {
     }
   }
 
+  if (session_resumption_enabled_) {
+    // Sessions are stored in the process-wide cache rather than in `ctx`,
+    // which lives only as long as this adapter.
+    OpenSSLDtlsSessionCache* cache = OpenSSLDtlsSessionCache::Get();
+    SSL_CTX_set_session_cache_mode(
+        ctx, (role_ == SSL_CLIENT ? SSL_SESS_CACHE_CLIENT
+                                  : SSL_SESS_CACHE_SERVER) |
+                 SSL_SESS_CACHE_NO_INTERNAL);
+    SSL_CTX_sess_set_new_cb(ctx, NewSessionCallback);
+    SSL_CTX_sess_set_get_cb(ctx, GetSessionCallback);
+    // Tickets are issued by the server and resumed without any server state,
+    // as long as they are encrypted with keys shared by the adapters.
+    if (!SSL_CTX_set_tlsext_ticket_keys(
+            ctx, const_cast<uint8_t*>(cache->ticket_keys()),
+            cache->ticket_keys_size())) {
+      SSL_CTX_free(ctx);
+      return nullptr;
+    }
+  }
+
   return ctx;
 }
 
@@ -1159,13 +1278,7 @@ enum ssl_verify_result_t OpenSSLStreamAdapter::SSLVerifyCallback(
   // Get our OpenSSLStreamAdapter from the context.
   OpenSSLStreamAdapter* stream =
       reinterpret_cast<OpenSSLStreamAdapter*>(SSL_get_app_data(ssl));
-  const STACK_OF(CRYPTO_BUFFER)* chain = SSL_get0_peer_certificates(ssl);
-  // Creates certificate chain.
-  std::vector<std::unique_ptr<SSLCertificate>> cert_chain;
-  for (CRYPTO_BUFFER* cert : chain) {
-    cert_chain.emplace_back(new BoringSSLCertificate(bssl::UpRef(cert)));
-  }
-  stream->peer_cert_chain_.reset(new SSLCertChain(std::move(cert_chain)));
+  stream->peer_cert_chain_ = GetPeerCertChain(ssl);
 
   // If the peer certificate digest isn't known yet, we'll wait to verify
   // until it's known, and for now just return a success status.
@@ -1210,6 +1323,37 @@ int OpenSSLStreamAdapter::SSLVerifyCallback(X509_STORE_CTX* store, void* arg) {
 }
 #endif  // !OPENSSL_IS_BORINGSSL
 
+int OpenSSLStreamAdapter::NewSessionCallback(SSL* ssl, SSL_SESSION* session) {
+  OpenSSLStreamAdapter* stream =
+      reinterpret_cast<OpenSSLStreamAdapter*>(SSL_get_app_data(ssl));
+  std::string key;
+  if (stream->role_ == SSL_CLIENT) {
+    key = stream->session_cache_key_;
+  } else {
+    unsigned int id_length;
+    const uint8_t* id = SSL_SESSION_get_id(session, &id_length);
+    if (id_length > 0) {
+      key = ServerSessionKey(id, id_length);
+    }
+  }
+  if (key.empty()) {
+    return 0;
+  }
+  // Returning 1 takes over the reference to `session`.
+  OpenSSLDtlsSessionCache::Get()->AddSession(key, session);
+  return 1;
+}
+
+SSL_SESSION* OpenSSLStreamAdapter::GetSessionCallback(SSL* ssl,
+                                                      const uint8_t* id,
+                                                      int id_len,
+                                                      int* copy) {
+  // The returned session is up_refed already.
+  *copy = 0;
+  return OpenSSLDtlsSessionCache::Get()->LookupSession(
+      ServerSessionKey(id, id_len));
+}
+
 bool OpenSSLStreamAdapter::IsBoringSsl() {
 #ifdef OPENSSL_IS_BORINGSSL
   return true;
@@ -34,6 +34,10 @@
 #include "rtc_base/system/rtc_export.h"
 #include "rtc_base/task_utils/repeating_task.h"
 
+#ifndef OPENSSL_IS_BORINGSSL
+typedef struct ssl_session_st SSL_SESSION;
+#endif
+
 namespace rtc {
 
 // This class was written with OpenSSLAdapter (a socket adapter) as a
@@ -94,6 +98,7 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   void SetMode(SSLMode mode) override;
   void SetMaxProtocolVersion(SSLProtocolVersion version) override;
   void SetInitialRetransmissionTimeout(int timeout_ms) override;
+  void SetSessionResumptionEnabled(bool enabled) override;
 
   StreamResult Read(void* data,
                     size_t data_len,
@@ -126,6 +131,7 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   bool GetDtlsSrtpCryptoSuite(int* crypto_suite) override;
 
   bool IsTlsConnected() override;
+  SSLHandshakeStats GetHandshakeStats() const override;
 
   // Capabilities interfaces.
   static bool IsBoringSsl();
@@ -163,6 +169,8 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   int BeginSSL();
   // Perform SSL negotiation steps.
   int ContinueSSL();
+  // Sets the session ID context and offers a cached session, if any.
+  void SetupSessionResumption();
 
   // Error handler helper. signal is given as true for errors in
   // asynchronous contexts (when an error method was not returned
@@ -194,6 +202,14 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   static int SSLVerifyCallback(X509_STORE_CTX* store, void* arg);
 #endif
 
+  // Session cache callbacks. See SSL_CTX_sess_set_new_cb and
+  // SSL_CTX_sess_set_get_cb.
+  static int NewSessionCallback(SSL* ssl, SSL_SESSION* session);
+  static SSL_SESSION* GetSessionCallback(SSL* ssl,
+                                         const uint8_t* id,
+                                         int id_len,
+                                         int* copy);
+
   bool WaitingToVerifyPeerCertificate() const {
     return GetClientAuthEnabled() && !peer_certificate_verified_;
   }
@@ -247,6 +263,15 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   // be too aggressive for low bandwidth links.
   int dtls_handshake_timeout_ms_ = 50;
 
+  bool session_resumption_enabled_ = false;
+  // Key of the session in the OpenSSLDtlsSessionCache, in the client role.
+  // Empty if the session cannot be resumed later.
+  std::string session_cache_key_;
+  SSLHandshakeStats handshake_stats_;
+  // Bytes written by the handshake until the last round trip or
+  // retransmission.
+  uint64_t handshake_bytes_written_ = 0;
+
   // TODO(https://bugs.webrtc.org/10261): Completely remove this option in M84.
   const bool support_legacy_tls_protocols_flag_;
 };
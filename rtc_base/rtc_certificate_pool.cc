@@ -0,0 +1,198 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/rtc_certificate_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "api/make_ref_counted.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+
+namespace rtc {
+
+namespace {
+
+// Matches the limit RTCCertificateGenerator applies to `expires_ms`.
+constexpr int64_t kMaxCertificateLifetimeMs = 365LL * 24 * 60 * 60 * 1000;
+// Expiration times have a resolution of one second.
+constexpr int64_t kExpirationResolutionMs = 1000;
+
+int64_t CertificateLifetimeMs(const absl::optional<uint64_t>& expires_ms) {
+  if (!expires_ms) {
+    return int64_t{kDefaultCertificateLifetimeInSeconds} * 1000;
+  }
+  return static_cast<int64_t>(std::min<uint64_t>(
+      *expires_ms / 1000 * 1000, kMaxCertificateLifetimeMs));
+}
+
+bool KeyParamsEqual(const KeyParams& a, const KeyParams& b) {
+  if (a.type() != b.type()) {
+    return false;
+  }
+  switch (a.type()) {
+    case KT_RSA:
+      return a.rsa_params().mod_size == b.rsa_params().mod_size &&
+             a.rsa_params().pub_exp == b.rsa_params().pub_exp;
+    case KT_ECDSA:
+      return a.ec_curve() == b.ec_curve();
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+// static
+scoped_refptr<RTCCertificatePool> RTCCertificatePool::Create(
+    const Config& config,
+    webrtc::TaskQueueFactory* task_queue_factory) {
+  return rtc::make_ref_counted<RTCCertificatePool>(config, task_queue_factory);
+}
+
+RTCCertificatePool::RTCCertificatePool(
+    const Config& config,
+    webrtc::TaskQueueFactory* task_queue_factory)
+    : config_(config),
+      min_remaining_lifetime_ms_(CertificateLifetimeMs(config.expires_ms) -
+                                 config.max_age_ms - kExpirationResolutionMs),
+      task_queue_(task_queue_factory->CreateTaskQueue(
+          "RTCCertificatePool",
+          webrtc::TaskQueueFactory::Priority::LOW)) {
+  RTC_DCHECK(config_.key_params.IsValid());
+  RTC_DCHECK_LE(config_.refill_threshold, config_.size);
+  RTC_DCHECK_GT(config_.max_age_ms, 0);
+  if (config_.expires_ms) {
+    RTC_DCHECK_LT(config_.max_age_ms, *config_.expires_ms);
+  }
+  {
+    webrtc::MutexLock lock(&mutex_);
+    Refill();
+  }
+  ScheduleRotation();
+}
+
+RTCCertificatePool::~RTCCertificatePool() = default;
+
+scoped_refptr<RTCCertificate> RTCCertificatePool::Take(
+    const KeyParams& key_params,
+    const absl::optional<uint64_t>& expires_ms) {
+  if (!KeyParamsEqual(key_params, config_.key_params) ||
+      expires_ms != config_.expires_ms) {
+    return nullptr;
+  }
+  webrtc::MutexLock lock(&mutex_);
+  DropOldCertificates();
+  scoped_refptr<RTCCertificate> certificate;
+  if (!certificates_.empty()) {
+    certificate = std::move(certificates_.front().certificate);
+    certificates_.pop_front();
+  }
+  MaybeRefill();
+  return certificate;
+}
+
+size_t RTCCertificatePool::size() const {
+  webrtc::MutexLock lock(&mutex_);
+  return certificates_.size();
+}
+
+void RTCCertificatePool::Refill() {
+  while (certificates_.size() + num_pending_ < config_.size) {
+    ++num_pending_;
+    task_queue_.PostTask([this] { GenerateCertificate(); });
+  }
+}
+
+void RTCCertificatePool::MaybeRefill() {
+  if (certificates_.size() + num_pending_ < config_.refill_threshold) {
+    Refill();
+  }
+}
+
+void RTCCertificatePool::DropOldCertificates() {
+  const int64_t now_ms = TimeMillis();
+  const int64_t now_utc_ms = TimeUTCMillis();
+  // Checks the remaining lifetime as well as the age, as the wall clock the
+  // expiration time is based on may jump relative to the monotonic one.
+  certificates_.erase(
+      std::remove_if(certificates_.begin(), certificates_.end(),
+                     [&](const Entry& entry) {
+                       return now_ms - entry.created_ms >= config_.max_age_ms ||
+                              static_cast<int64_t>(
+                                  entry.certificate->Expires()) -
+                                      now_utc_ms <
+                                  min_remaining_lifetime_ms_;
+                     }),
+      certificates_.end());
+}
+
+void RTCCertificatePool::GenerateCertificate() {
+  RTC_DCHECK(task_queue_.IsCurrent());
+  scoped_refptr<RTCCertificate> certificate =
+      RTCCertificateGenerator::GenerateCertificate(config_.key_params,
+                                                   config_.expires_ms);
+  webrtc::MutexLock lock(&mutex_);
+  --num_pending_;
+  if (!certificate) {
+    // Not retried until the next take or rotation, to avoid spinning.
+    RTC_LOG(LS_WARNING) << "Failed to generate a pooled certificate.";
+    return;
+  }
+  certificates_.push_back({std::move(certificate), TimeMillis()});
+}
+
+void RTCCertificatePool::Rotate() {
+  RTC_DCHECK(task_queue_.IsCurrent());
+  {
+    webrtc::MutexLock lock(&mutex_);
+    DropOldCertificates();
+    Refill();
+  }
+  ScheduleRotation();
+}
+
+void RTCCertificatePool::ScheduleRotation() {
+  // Checking four times per `max_age_ms` bounds the age of pooled certificates
+  // by 1.25 times that.
+  task_queue_.PostDelayedTask(
+      [this] { Rotate(); },
+      webrtc::TimeDelta::Millis(std::max<int64_t>(config_.max_age_ms / 4, 1)));
+}
+
+PooledRTCCertificateGenerator::PooledRTCCertificateGenerator(
+    scoped_refptr<RTCCertificatePool> pool,
+    std::unique_ptr<RTCCertificateGeneratorInterface> fallback)
+    : pool_(std::move(pool)), fallback_(std::move(fallback)) {
+  RTC_DCHECK(pool_);
+  RTC_DCHECK(fallback_);
+}
+
+PooledRTCCertificateGenerator::~PooledRTCCertificateGenerator() = default;
+
+void PooledRTCCertificateGenerator::GenerateCertificateAsync(
+    const KeyParams& key_params,
+    const absl::optional<uint64_t>& expires_ms,
+    Callback callback) {
+  RTC_DCHECK(callback);
+  scoped_refptr<RTCCertificate> certificate =
+      pool_->Take(key_params, expires_ms);
+  if (certificate) {
+    std::move(callback)(std::move(certificate));
+    return;
+  }
+  fallback_->GenerateCertificateAsync(key_params, expires_ms,
+                                      std::move(callback));
+}
+
+}  // namespace rtc
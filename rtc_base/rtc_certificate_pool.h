@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_RTC_CERTIFICATE_POOL_H_
+#define RTC_BASE_RTC_CERTIFICATE_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <memory>
+
+#include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "rtc_base/ref_count.h"
+#include "rtc_base/rtc_certificate.h"
+#include "rtc_base/rtc_certificate_generator.h"
+#include "rtc_base/ssl_identity.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace rtc {
+
+// Keeps certificates generated ahead of time on a low priority task queue, so
+// that a PeerConnection does not wait for key generation before its first
+// offer. The pool is refilled when it runs low and certificates that waited
+// too long are replaced. It is thread-safe and may be shared by all the
+// PeerConnectionFactories of a process.
+class RTC_EXPORT RTCCertificatePool : public RefCountInterface {
+ public:
+  struct Config {
+    KeyParams key_params = KeyParams::ECDSA();
+    // Passed to `RTCCertificateGenerator::GenerateCertificate`.
+    absl::optional<uint64_t> expires_ms;
+    // Number of certificates kept ready.
+    size_t size = 8;
+    // The pool is topped up when fewer certificates than this are left,
+    // counting those being generated.
+    size_t refill_threshold = 4;
+    // Certificates are replaced after waiting this long in the pool, or once
+    // they have less than their lifetime minus this left, so that the ones
+    // handed out have most of their lifetime left. Must be shorter than
+    // `expires_ms`.
+    int64_t max_age_ms = 24 * 60 * 60 * 1000;
+  };
+
+  static scoped_refptr<RTCCertificatePool> Create(
+      const Config& config,
+      webrtc::TaskQueueFactory* task_queue_factory);
+
+  // Returns a pooled certificate, or null if the pool is empty or the
+  // arguments do not match the config.
+  scoped_refptr<RTCCertificate> Take(
+      const KeyParams& key_params,
+      const absl::optional<uint64_t>& expires_ms);
+
+  // Number of certificates ready to be taken.
+  size_t size() const;
+  const Config& config() const { return config_; }
+
+ protected:
+  RTCCertificatePool(const Config& config,
+                     webrtc::TaskQueueFactory* task_queue_factory);
+  ~RTCCertificatePool() override;
+
+ private:
+  struct Entry {
+    scoped_refptr<RTCCertificate> certificate;
+    int64_t created_ms;
+  };
+
+  void Refill() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void MaybeRefill() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void DropOldCertificates() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Run on `task_queue_`.
+  void GenerateCertificate();
+  void Rotate();
+  void ScheduleRotation();
+
+  const Config config_;
+  // Certificates with less validity left than this are not handed out.
+  const int64_t min_remaining_lifetime_ms_;
+  mutable webrtc::Mutex mutex_;
+  // Oldest first.
+  std::deque<Entry> certificates_ RTC_GUARDED_BY(mutex_);
+  size_t num_pending_ RTC_GUARDED_BY(mutex_) = 0;
+  // Destroyed first, so that running tasks do not outlive the members above.
+  TaskQueue task_queue_;
+};
+
+// Serves certificate requests from `pool` when it has a matching certificate,
+// and from `fallback` otherwise. Pooled certificates are handed to the
+// callback right away, without a thread hop.
+class RTC_EXPORT PooledRTCCertificateGenerator
+    : public RTCCertificateGeneratorInterface {
+ public:
+  PooledRTCCertificateGenerator(
+      scoped_refptr<RTCCertificatePool> pool,
+      std::unique_ptr<RTCCertificateGeneratorInterface> fallback);
+  ~PooledRTCCertificateGenerator() override;
+
+  void GenerateCertificateAsync(const KeyParams& key_params,
+                                const absl::optional<uint64_t>& expires_ms,
+                                Callback callback) override;
+
+ private:
+  const scoped_refptr<RTCCertificatePool> pool_;
+  const std::unique_ptr<RTCCertificateGeneratorInterface> fallback_;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_RTC_CERTIFICATE_POOL_H_
@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/rtc_certificate_pool.h"
+
+#include <memory>
+
+#include "absl/types/optional.h"
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/fake_clock.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+constexpr int kGenerationTimeoutMs = 10000;
+
+class RTCCertificatePoolTest : public ::testing::Test {
+ protected:
+  RTCCertificatePoolTest()
+      : task_queue_factory_(webrtc::CreateDefaultTaskQueueFactory()) {
+    config_.size = 3;
+    config_.refill_threshold = 2;
+  }
+
+  AutoThread main_thread_;
+  std::unique_ptr<webrtc::TaskQueueFactory> task_queue_factory_;
+  RTCCertificatePool::Config config_;
+};
+
+TEST_F(RTCCertificatePoolTest, FillsAndRefillsWhenLow) {
+  scoped_refptr<RTCCertificatePool> pool =
+      RTCCertificatePool::Create(config_, task_queue_factory_.get());
+  EXPECT_EQ_WAIT(3u, pool->size(), kGenerationTimeoutMs);
+
+  // Going down to the threshold does not refill.
+  scoped_refptr<RTCCertificate> first =
+      pool->Take(KeyParams::ECDSA(), absl::nullopt);
+  ASSERT_TRUE(first);
+  EXPECT_EQ(2u, pool->size());
+  scoped_refptr<RTCCertificate> second =
+      pool->Take(KeyParams::ECDSA(), absl::nullopt);
+  ASSERT_TRUE(second);
+  EXPECT_NE(first->ToPEM().certificate(), second->ToPEM().certificate());
+  EXPECT_EQ_WAIT(3u, pool->size(), kGenerationTimeoutMs);
+}
+
+TEST_F(RTCCertificatePoolTest, OnlyHandsOutConfiguredCertificates) {
+  scoped_refptr<RTCCertificatePool> pool =
+      RTCCertificatePool::Create(config_, task_queue_factory_.get());
+  EXPECT_EQ_WAIT(3u, pool->size(), kGenerationTimeoutMs);
+  EXPECT_FALSE(pool->Take(KeyParams::RSA(), absl::nullopt));
+  EXPECT_FALSE(pool->Take(KeyParams::ECDSA(), 1000));
+  EXPECT_EQ(3u, pool->size());
+}
+
+TEST_F(RTCCertificatePoolTest, DropsCertificatesWithLittleLifetimeLeft) {
+  config_.expires_ms = 2 * 24 * 60 * 60 * 1000;
+  config_.max_age_ms = 24 * 60 * 60 * 1000;
+  // Run the pool on a wall clock 12 hours ahead of the one the certificates
+  // are generated with, so that they run short of lifetime before they get
+  // too old.
+  const int64_t now_ms = TimeUTCMillis();
+  ScopedBaseFakeClock clock;
+  clock.SetTime(webrtc::Timestamp::Millis(now_ms) +
+                webrtc::TimeDelta::Seconds(12 * 60 * 60));
+  scoped_refptr<RTCCertificatePool> pool =
+      RTCCertificatePool::Create(config_, task_queue_factory_.get());
+  EXPECT_EQ_WAIT(3u, pool->size(), kGenerationTimeoutMs);
+  EXPECT_TRUE(pool->Take(KeyParams::ECDSA(), config_.expires_ms));
+
+  // 13 hours later the certificates have less than a day left, while still
+  // being younger than `max_age_ms`.
+  clock.AdvanceTime(webrtc::TimeDelta::Seconds(13 * 60 * 60));
+  EXPECT_FALSE(pool->Take(KeyParams::ECDSA(), config_.expires_ms));
+}
+
+TEST_F(RTCCertificatePoolTest, GeneratorTakesFromPoolSynchronously) {
+  scoped_refptr<RTCCertificatePool> pool =
+      RTCCertificatePool::Create(config_, task_queue_factory_.get());
+  EXPECT_EQ_WAIT(3u, pool->size(), kGenerationTimeoutMs);
+  std::unique_ptr<Thread> worker_thread = Thread::Create();
+  ASSERT_TRUE(worker_thread->Start());
+  PooledRTCCertificateGenerator generator(
+      pool, std::make_unique<RTCCertificateGenerator>(Thread::Current(),
+                                                      worker_thread.get()));
+
+  scoped_refptr<RTCCertificate> pooled;
+  generator.GenerateCertificateAsync(
+      KeyParams(), absl::nullopt,
+      [&](scoped_refptr<RTCCertificate> certificate) {
+        pooled = std::move(certificate);
+      });
+  EXPECT_TRUE(pooled);
+
+  // Requests the pool cannot serve are generated on the worker thread.
+  scoped_refptr<RTCCertificate> generated;
+  generator.GenerateCertificateAsync(
+      KeyParams::ECDSA(), 1000, [&](scoped_refptr<RTCCertificate> certificate) {
+        generated = std::move(certificate);
+      });
+  EXPECT_FALSE(generated);
+  EXPECT_TRUE_WAIT(generated, kGenerationTimeoutMs);
+}
+
+}  // namespace
+}  // namespace rtc
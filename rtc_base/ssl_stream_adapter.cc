@@ -117,6 +117,10 @@ bool SSLStreamAdapter::GetDtlsSrtpCryptoSuite(int* crypto_suite) {
   return false;
 }
 
+SSLHandshakeStats SSLStreamAdapter::GetHandshakeStats() const {
+  return SSLHandshakeStats();
+}
+
 bool SSLStreamAdapter::IsBoringSsl() {
   return OpenSSLStreamAdapter::IsBoringSsl();
 }
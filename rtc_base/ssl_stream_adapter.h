@@ -112,6 +112,21 @@ enum { SSE_MSG_TRUNC = 0xff0001 };
 // Used to send back UMA histogram value. Logged when Dtls handshake fails.
 enum class SSLHandshakeError { UNKNOWN, INCOMPATIBLE_CIPHERSUITE, MAX_VALUE };
 
+// Cost of the handshake of an SSLStreamAdapter, for metrics.
+struct SSLHandshakeStats {
+  // True if an earlier session was resumed, skipping key exchange and
+  // certificate signatures.
+  bool session_resumed = false;
+  // Time spent in the SSL library processing the handshake. The processing is
+  // synchronous, so this approximates its CPU cost.
+  int64_t processing_time_us = 0;
+  // Number of flights sent that the handshake then waited for the peer to
+  // answer, i.e. its round trips. Retransmissions are not counted.
+  int round_trips = 0;
+  // Number of flights retransmitted after a timeout.
+  int retransmissions = 0;
+};
+
 class SSLStreamAdapter : public StreamInterface, public sigslot::has_slots<> {
  public:
   // Instantiate an SSLStreamAdapter wrapping the given stream,
@@ -151,6 +166,15 @@ class SSLStreamAdapter : public StreamInterface, public sigslot::has_slots<> {
   // This should only be called before StartSSL().
   virtual void SetInitialRetransmissionTimeout(int timeout_ms) = 0;
 
+  // Enables DTLS session resumption. The session of a completed handshake is
+  // cached for the process, and a later handshake between the same local
+  // identity and peer certificate digest resumes it instead of doing a full
+  // handshake. The peer certificate is still verified against the digest.
+  // In the client role, the peer certificate digest must be set before the
+  // handshake starts for a session to be offered.
+  // This should only be called before StartSSL().
+  virtual void SetSessionResumptionEnabled(bool enabled) {}
+
   // StartSSL starts negotiation with a peer, whose certificate is verified
   // using the certificate digest. Generally, SetIdentity() and possibly
   // SetServerRole() should have been called before this.
@@ -227,6 +251,9 @@ class SSLStreamAdapter : public StreamInterface, public sigslot::has_slots<> {
   // SS_OPENING but IsTlsConnected should return true.
   virtual bool IsTlsConnected() = 0;
 
+  // Returns the stats of the handshake so far.
+  virtual SSLHandshakeStats GetHandshakeStats() const;
+
   // Capabilities testing.
   // Used to have "DTLS supported", "DTLS-SRTP supported" etc. methods, but now
   // that's assumed.
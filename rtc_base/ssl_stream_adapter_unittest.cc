@@ -1587,6 +1587,97 @@ INSTANTIATE_TEST_SUITE_P(
                    rtc::KeyParams::RSA(1152, 65537),
                    rtc::KeyParams::ECDSA(rtc::EC_NIST_P256))));
 
+// Tests for DTLS session resumption.
+class SSLStreamAdapterTestDTLSResumption
+    : public SSLStreamAdapterTestDTLSBase {
+ public:
+  SSLStreamAdapterTestDTLSResumption()
+      : SSLStreamAdapterTestDTLSBase(rtc::KeyParams::ECDSA(rtc::EC_NIST_P256),
+                                     rtc::KeyParams::ECDSA(rtc::EC_NIST_P256)) {
+  }
+
+  void SetUp() override {
+    SSLStreamAdapterTestDTLSBase::SetUp();
+    client_ssl_->SetSessionResumptionEnabled(true);
+    server_ssl_->SetSessionResumptionEnabled(true);
+  }
+
+  // Replaces the stream adapters with new ones, like a DtlsTransport that is
+  // set up again after an ICE restart. The client keeps its identity, and the
+  // server gets `server_identity`, or keeps its own if null.
+  void Reconnect(std::unique_ptr<rtc::SSLIdentity> server_identity = nullptr) {
+    std::unique_ptr<rtc::SSLIdentity> client_identity =
+        this->client_identity()->Clone();
+    if (!server_identity) {
+      server_identity = this->server_identity()->Clone();
+    }
+    client_ssl_.reset();
+    server_ssl_.reset();
+
+    CreateStreams();
+    client_ssl_ =
+        rtc::SSLStreamAdapter::Create(absl::WrapUnique(client_stream_));
+    server_ssl_ =
+        rtc::SSLStreamAdapter::Create(absl::WrapUnique(server_stream_));
+    client_ssl_->SignalEvent.connect(
+        static_cast<SSLStreamAdapterTestBase*>(this),
+        &SSLStreamAdapterTestBase::OnEvent);
+    server_ssl_->SignalEvent.connect(
+        static_cast<SSLStreamAdapterTestBase*>(this),
+        &SSLStreamAdapterTestBase::OnEvent);
+    client_ssl_->SetIdentity(std::move(client_identity));
+    server_ssl_->SetIdentity(std::move(server_identity));
+    client_ssl_->SetSessionResumptionEnabled(true);
+    server_ssl_->SetSessionResumptionEnabled(true);
+    identities_set_ = false;
+  }
+};
+
+TEST_F(SSLStreamAdapterTestDTLSResumption, ResumesSessionAfterReconnect) {
+  TestHandshake();
+  rtc::SSLHandshakeStats full_handshake = client_ssl_->GetHandshakeStats();
+  EXPECT_FALSE(full_handshake.session_resumed);
+  EXPECT_FALSE(server_ssl_->GetHandshakeStats().session_resumed);
+  EXPECT_EQ(2, full_handshake.round_trips);
+
+  Reconnect();
+  TestHandshake();
+  rtc::SSLHandshakeStats resumed = client_ssl_->GetHandshakeStats();
+  EXPECT_TRUE(resumed.session_resumed);
+  EXPECT_TRUE(server_ssl_->GetHandshakeStats().session_resumed);
+  EXPECT_EQ(1, resumed.round_trips);
+
+  // The peer certificates are still available.
+  std::unique_ptr<rtc::SSLCertChain> server_chain =
+      client_ssl_->GetPeerSSLCertChain();
+  ASSERT_TRUE(server_chain);
+  EXPECT_EQ(server_identity()->certificate().ToPEMString(),
+            server_chain->Get(0).ToPEMString());
+  std::unique_ptr<rtc::SSLCertChain> client_chain =
+      server_ssl_->GetPeerSSLCertChain();
+  ASSERT_TRUE(client_chain);
+  EXPECT_EQ(client_identity()->certificate().ToPEMString(),
+            client_chain->Get(0).ToPEMString());
+  TestTransfer(10);
+}
+
+TEST_F(SSLStreamAdapterTestDTLSResumption,
+       DoesNotResumeWithDifferentPeerCertificate) {
+  TestHandshake();
+  Reconnect(rtc::SSLIdentity::Create("server", server_key_type_));
+  TestHandshake();
+  EXPECT_FALSE(client_ssl_->GetHandshakeStats().session_resumed);
+  EXPECT_FALSE(server_ssl_->GetHandshakeStats().session_resumed);
+}
+
+TEST_F(SSLStreamAdapterTestDTLSResumption, DoesNotResumeWhenDisabled) {
+  TestHandshake();
+  Reconnect();
+  client_ssl_->SetSessionResumptionEnabled(false);
+  TestHandshake();
+  EXPECT_FALSE(client_ssl_->GetHandshakeStats().session_resumed);
+}
+
 // Tests for enabling / disabling legacy TLS protocols in DTLS.
 class SSLStreamAdapterTestDTLSLegacyProtocols
     : public SSLStreamAdapterTestDTLSBase {
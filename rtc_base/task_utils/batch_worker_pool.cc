@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_utils/batch_worker_pool.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/strings/string_builder.h"
+
+namespace webrtc {
+
+BatchWorkerPool::BatchWorkerPool(TaskQueueFactory* task_queue_factory,
+                                 absl::string_view name_prefix,
+                                 int num_workers) {
+  RTC_DCHECK_GE(num_workers, 0);
+  RTC_DCHECK(num_workers == 0 || task_queue_factory);
+  for (int i = 0; i < num_workers; ++i) {
+    rtc::StringBuilder name;
+    name << name_prefix << i;
+    workers_.push_back(task_queue_factory->CreateTaskQueue(
+        name.str(), TaskQueueFactory::Priority::HIGH));
+  }
+}
+
+BatchWorkerPool::~BatchWorkerPool() {
+  // Destroying the task queues waits for any running task.
+  workers_.clear();
+}
+
+void BatchWorkerPool::ProcessRanges(
+    size_t num_items,
+    rtc::FunctionView<void(size_t worker, size_t begin, size_t end)>
+        process_range) {
+  const size_t num_ranges = std::min(workers_.size(), num_items);
+  if (num_ranges == 0) {
+    process_range(0, 0, num_items);
+    return;
+  }
+  std::atomic<size_t> remaining_ranges(num_ranges);
+  rtc::Event done;
+  for (size_t worker = 0; worker < num_ranges; ++worker) {
+    const size_t begin = worker * num_items / num_ranges;
+    const size_t end = (worker + 1) * num_items / num_ranges;
+    workers_[worker]->PostTask(
+        [worker, begin, end, process_range, &remaining_ranges, &done] {
+          process_range(worker, begin, end);
+          if (remaining_ranges.fetch_sub(1) == 1) {
+            done.Set();
+          }
+        });
+  }
+  done.Wait(rtc::Event::kForever);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TASK_UTILS_BATCH_WORKER_POOL_H_
+#define RTC_BASE_TASK_UTILS_BATCH_WORKER_POOL_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/function_view.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+
+namespace webrtc {
+
+// Fixed set of high priority task queues that process a batch of items, e.g.
+// one 10 ms frame of many audio streams, by splitting it into contiguous
+// ranges that run in parallel. The caller blocks until the whole batch is
+// done, so the ranges may refer to state on the caller's stack.
+//
+// ProcessRanges() must not be called concurrently, nor from one of the
+// workers.
+class BatchWorkerPool {
+ public:
+  // The workers are named `name_prefix` followed by their index. With
+  // `num_workers` set to zero, batches are processed on the calling thread.
+  BatchWorkerPool(TaskQueueFactory* task_queue_factory,
+                  absl::string_view name_prefix,
+                  int num_workers);
+  // Waits for any running task.
+  ~BatchWorkerPool();
+
+  BatchWorkerPool(const BatchWorkerPool&) = delete;
+  BatchWorkerPool& operator=(const BatchWorkerPool&) = delete;
+
+  size_t num_workers() const { return workers_.size(); }
+
+  // Splits [0, `num_items`) into at most num_workers() ranges of near equal
+  // size, calls `process_range(worker, begin, end)` for each range on worker
+  // number `worker`, and returns when all of them are done. Without workers,
+  // or without items, `process_range(0, 0, num_items)` runs on the calling
+  // thread.
+  void ProcessRanges(
+      size_t num_items,
+      rtc::FunctionView<void(size_t worker, size_t begin, size_t end)>
+          process_range);
+
+ private:
+  std::vector<std::unique_ptr<TaskQueueBase, TaskQueueDeleter>> workers_;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TASK_UTILS_BATCH_WORKER_POOL_H_
@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_utils/batch_worker_pool.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/task_queue/task_queue_base.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+class BatchWorkerPoolTest : public ::testing::TestWithParam<int> {
+ protected:
+  BatchWorkerPoolTest()
+      : task_queue_factory_(CreateDefaultTaskQueueFactory()),
+        pool_(task_queue_factory_.get(), "BatchWorker", GetParam()) {}
+
+  std::unique_ptr<TaskQueueFactory> task_queue_factory_;
+  BatchWorkerPool pool_;
+};
+
+TEST_P(BatchWorkerPoolTest, ProcessesEveryItemOnce) {
+  for (size_t num_items : {0, 1, 2, 7, 100}) {
+    std::vector<int> counts(num_items, 0);
+    std::vector<int> num_ranges_by_worker(
+        std::max<size_t>(pool_.num_workers(), 1), 0);
+    pool_.ProcessRanges(num_items, [&](size_t worker, size_t begin,
+                                       size_t end) {
+      ASSERT_LT(worker, num_ranges_by_worker.size());
+      ++num_ranges_by_worker[worker];
+      for (size_t i = begin; i < end; ++i) {
+        ++counts[i];
+      }
+    });
+    for (int count : counts) {
+      EXPECT_EQ(count, 1);
+    }
+    // No worker gets more than one range.
+    for (int num_ranges : num_ranges_by_worker) {
+      EXPECT_LE(num_ranges, 1);
+    }
+  }
+}
+
+TEST_P(BatchWorkerPoolTest, RunsRangesOnWorkers) {
+  const size_t num_items = 10;
+  // Not a vector<bool>, which packs the flags of neighbouring items.
+  std::vector<int> on_caller(num_items, 0);
+  pool_.ProcessRanges(num_items, [&](size_t worker, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      on_caller[i] = TaskQueueBase::Current() == nullptr;
+    }
+  });
+  for (int value : on_caller) {
+    EXPECT_EQ(value != 0, pool_.num_workers() == 0);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(NumWorkers,
+                         BatchWorkerPoolTest,
+                         ::testing::Values(0, 1, 3));
+
+}  // namespace
+}  // namespace webrtc
@@ -55,10 +55,26 @@ void EncoderRtcpFeedback::OnReceivedIntraFrameRequest(uint32_t ssrc) {
 
   time_last_packet_delivery_queue_ = now;
 
+  std::function<void()> key_frame_request_callback;
+  {
+    MutexLock lock(&callback_lock_);
+    key_frame_request_callback = key_frame_request_callback_;
+  }
+  if (key_frame_request_callback) {
+    key_frame_request_callback();
+    return;
+  }
+
   // Always produce key frame for all streams.
   video_stream_encoder_->SendKeyFrame();
 }
 
+void EncoderRtcpFeedback::SetKeyFrameRequestCallback(
+    std::function<void()> callback) {
+  MutexLock lock(&callback_lock_);
+  key_frame_request_callback_ = std::move(callback);
+}
+
 void EncoderRtcpFeedback::OnReceivedLossNotification(
     uint32_t ssrc,
     uint16_t seq_num_of_last_decodable,
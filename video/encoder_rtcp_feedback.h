@@ -19,6 +19,7 @@
 #include "api/video/video_stream_encoder_interface.h"
 #include "call/rtp_video_sender_interface.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/system/no_unique_address.h"
 #include "system_wrappers/include/clock.h"
 
@@ -42,6 +43,10 @@ class EncoderRtcpFeedback : public RtcpIntraFrameObserver,
 
   void OnReceivedIntraFrameRequest(uint32_t ssrc) override;
 
+  // While set, key frame requests are passed to `callback` instead of the
+  // encoder. Used when the stream sends frames encoded elsewhere.
+  void SetKeyFrameRequestCallback(std::function<void()> callback);
+
   // Implements RtcpLossNotificationObserver.
   void OnReceivedLossNotification(uint32_t ssrc,
                                   uint16_t seq_num_of_last_decodable,
@@ -57,6 +62,10 @@ class EncoderRtcpFeedback : public RtcpIntraFrameObserver,
       get_packet_infos_;
   VideoStreamEncoderInterface* const video_stream_encoder_;
 
+  Mutex callback_lock_;
+  std::function<void()> key_frame_request_callback_
+      RTC_GUARDED_BY(callback_lock_);
+
   RTC_NO_UNIQUE_ADDRESS SequenceChecker packet_delivery_queue_;
   Timestamp time_last_packet_delivery_queue_
       RTC_GUARDED_BY(packet_delivery_queue_);
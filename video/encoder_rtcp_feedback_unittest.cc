@@ -42,6 +42,21 @@ TEST_F(VieKeyRequestTest, CreateAndTriggerRequests) {
   encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc);
 }
 
+TEST_F(VieKeyRequestTest, RequestsKeyFrameFromCallbackWhenSet) {
+  int num_key_frame_requests = 0;
+  encoder_rtcp_feedback_.SetKeyFrameRequestCallback(
+      [&num_key_frame_requests] { ++num_key_frame_requests; });
+  EXPECT_CALL(encoder_, SendKeyFrame()).Times(0);
+  encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc);
+  EXPECT_EQ(num_key_frame_requests, 1);
+
+  encoder_rtcp_feedback_.SetKeyFrameRequestCallback(nullptr);
+  EXPECT_CALL(encoder_, SendKeyFrame()).Times(1);
+  simulated_clock_.AdvanceTimeMilliseconds(300);
+  encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc);
+  EXPECT_EQ(num_key_frame_requests, 1);
+}
+
 TEST_F(VieKeyRequestTest, TooManyOnReceivedIntraFrameRequest) {
   EXPECT_CALL(encoder_, SendKeyFrame()).Times(1);
   encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc);
@@ -36,6 +36,7 @@
 #include "system_wrappers/include/clock.h"
 #include "system_wrappers/include/metrics.h"
 #include "system_wrappers/include/ntp_time.h"
+#include "video/update_rect_detector.h"
 
 namespace webrtc {
 namespace {
@@ -99,7 +100,8 @@ class ZeroHertzAdapterMode : public AdapterMode {
   ZeroHertzAdapterMode(TaskQueueBase* queue,
                        Clock* clock,
                        FrameCadenceAdapterInterface::Callback* callback,
-                       double max_fps);
+                       double max_fps,
+                       bool ignore_static_frames);
 
   // Reconfigures according to parameters.
   // All spatial layer trackers are initialized as unconverged by this method.
@@ -198,6 +200,8 @@ class ZeroHertzAdapterMode : public AdapterMode {
   const double max_fps_;
   // How much the incoming frame sequence is delayed by.
   const TimeDelta frame_delay_ = TimeDelta::Seconds(1) / max_fps_;
+  // If true, frames with an empty update rect don't restart the cadence.
+  const bool ignore_static_frames_;
 
   RTC_NO_UNIQUE_ADDRESS SequenceChecker sequence_checker_;
   // A queue of incoming frames and repeated frames.
@@ -269,6 +273,11 @@ class FrameCadenceAdapterImpl : public FrameCadenceAdapterInterface {
   // 0 Hz.
   const bool zero_hertz_screenshare_enabled_;
 
+  // True if static frames should be detected in zero-hertz mode, by computing
+  // the update rect of frames from sources that don't report one.
+  const bool static_frame_detection_enabled_;
+  UpdateRectDetector update_rect_detector_ RTC_GUARDED_BY(queue_);
+
   // The two possible modes we're under.
   absl::optional<PassthroughAdapterMode> passthrough_adapter_;
   absl::optional<ZeroHertzAdapterMode> zero_hertz_adapter_;
@@ -304,8 +313,13 @@ ZeroHertzAdapterMode::ZeroHertzAdapterMode(
     TaskQueueBase* queue,
     Clock* clock,
     FrameCadenceAdapterInterface::Callback* callback,
-    double max_fps)
-    : queue_(queue), clock_(clock), callback_(callback), max_fps_(max_fps) {
+    double max_fps,
+    bool ignore_static_frames)
+    : queue_(queue),
+      clock_(clock),
+      callback_(callback),
+      max_fps_(max_fps),
+      ignore_static_frames_(ignore_static_frames) {
   sequence_checker_.Detach();
   MaybeStartRefreshFrameRequester();
 }
@@ -359,6 +373,19 @@ void ZeroHertzAdapterMode::OnFrame(Timestamp post_time,
   RTC_DCHECK_RUN_ON(&sequence_checker_);
   RTC_DLOG(LS_VERBOSE) << "ZeroHertzAdapterMode::" << __func__ << " this "
                        << this;
+  // A frame that is known to be identical to the previous one carries no new
+  // information. Keep the current cadence (including any idle repeat) rather
+  // than restarting it and resetting quality convergence. It doesn't end a
+  // capture freeze either, so keep requesting refresh frames.
+  if (ignore_static_frames_ && !queued_frames_.empty() &&
+      frame.has_update_rect() && frame.update_rect().IsEmpty() &&
+      frame.width() == queued_frames_.back().width() &&
+      frame.height() == queued_frames_.back().height()) {
+    RTC_DLOG(LS_VERBOSE) << __func__ << " this " << this
+                         << " ignoring static frame";
+    return;
+  }
+
   refresh_frame_requester_.Stop();
 
   // Assume all enabled layers are unconverged after frame entry.
@@ -588,7 +615,9 @@ FrameCadenceAdapterImpl::FrameCadenceAdapterImpl(
     : clock_(clock),
       queue_(queue),
       zero_hertz_screenshare_enabled_(
-          !field_trials.IsDisabled("WebRTC-ZeroHertzScreenshare")) {}
+          !field_trials.IsDisabled("WebRTC-ZeroHertzScreenshare")),
+      static_frame_detection_enabled_(
+          field_trials.IsEnabled("WebRTC-ZeroHertzStaticFrameDetection")) {}
 
 FrameCadenceAdapterImpl::~FrameCadenceAdapterImpl() {
   RTC_DLOG(LS_VERBOSE) << __func__ << " this " << this;
@@ -701,6 +730,18 @@ void FrameCadenceAdapterImpl::OnFrameOnMainQueue(
     int frames_scheduled_for_processing,
     const VideoFrame& frame) {
   RTC_DCHECK_RUN_ON(queue_);
+  if (static_frame_detection_enabled_ && zero_hertz_adapter_.has_value() &&
+      !frame.has_update_rect()) {
+    absl::optional<VideoFrame::UpdateRect> update_rect =
+        update_rect_detector_.Detect(frame);
+    if (update_rect.has_value()) {
+      VideoFrame frame_with_update_rect = frame;
+      frame_with_update_rect.set_update_rect(*update_rect);
+      current_adapter_mode_->OnFrame(post_time, frames_scheduled_for_processing,
+                                     frame_with_update_rect);
+      return;
+    }
+  }
   current_adapter_mode_->OnFrame(post_time, frames_scheduled_for_processing,
                                  frame);
 }
@@ -720,7 +761,9 @@ void FrameCadenceAdapterImpl::MaybeReconfigureAdapters(
   if (is_zero_hertz_enabled) {
     if (!was_zero_hertz_enabled) {
       zero_hertz_adapter_.emplace(queue_, clock_, callback_,
-                                  source_constraints_->max_fps.value());
+                                  source_constraints_->max_fps.value(),
+                                  static_frame_detection_enabled_);
+      update_rect_detector_.Reset();
       RTC_LOG(LS_INFO) << "Zero hertz mode activated.";
       zero_hertz_adapter_created_timestamp_ = clock_->CurrentTime();
     }
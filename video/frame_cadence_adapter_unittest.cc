@@ -361,6 +361,78 @@ TEST(FrameCadenceAdapterTest, StopsRepeatingFramesDelayed) {
   time_controller.AdvanceTime(TimeDelta::Seconds(1));
 }
 
+TEST(FrameCadenceAdapterTest, KeepsRepeatingOnDetectedStaticFrame) {
+  test::ScopedKeyValueConfig field_trials(
+      "WebRTC-ZeroHertzScreenshare/Enabled/"
+      "WebRTC-ZeroHertzStaticFrameDetection/Enabled/");
+  MockCallback callback;
+  GlobalSimulatedTimeController time_controller(Timestamp::Zero());
+  auto adapter = CreateAdapter(field_trials, time_controller.GetClock());
+  adapter->Initialize(&callback);
+  adapter->SetZeroHertzModeEnabled(
+      FrameCadenceAdapterInterface::ZeroHertzModeParams{});
+  adapter->OnConstraintsChanged(VideoTrackSourceConstraints{0, 1});
+  auto create_black_frame = [] {
+    auto buffer = NV12Buffer::Create(/*width=*/64, /*height=*/64);
+    buffer->InitializeData();
+    return VideoFrame::Builder().set_video_frame_buffer(buffer).build();
+  };
+
+  // The first frame is a full update, and is sent after 1s.
+  adapter->OnFrame(create_black_frame());
+  EXPECT_CALL(callback, OnFrame)
+      .WillOnce(Invoke([](Timestamp, int, const VideoFrame& frame) {
+        EXPECT_EQ(frame.update_rect(), (VideoFrame::UpdateRect{0, 0, 64, 64}));
+      }));
+  time_controller.AdvanceTime(TimeDelta::Seconds(1.5));
+  Mock::VerifyAndClearExpectations(&callback);
+
+  // An identical frame without an update rect doesn't restart the cadence, so
+  // the repeat scheduled at 2s still happens.
+  adapter->OnFrame(create_black_frame());
+  EXPECT_CALL(callback, OnFrame)
+      .WillOnce(Invoke([](Timestamp, int, const VideoFrame& frame) {
+        EXPECT_TRUE(frame.update_rect().IsEmpty());
+      }));
+  time_controller.AdvanceTime(TimeDelta::Seconds(0.5));
+}
+
+TEST(FrameCadenceAdapterTest, KeepsRequestingRefreshFramesOnStaticFrame) {
+  test::ScopedKeyValueConfig field_trials(
+      "WebRTC-ZeroHertzScreenshare/Enabled/"
+      "WebRTC-ZeroHertzStaticFrameDetection/Enabled/");
+  MockCallback callback;
+  GlobalSimulatedTimeController time_controller(Timestamp::Zero());
+  auto adapter = CreateAdapter(field_trials, time_controller.GetClock());
+  adapter->Initialize(&callback);
+  adapter->SetZeroHertzModeEnabled(
+      FrameCadenceAdapterInterface::ZeroHertzModeParams{});
+  constexpr int kMaxFps = 10;
+  adapter->OnConstraintsChanged(VideoTrackSourceConstraints{0, kMaxFps});
+  auto create_black_frame = [] {
+    auto buffer = NV12Buffer::Create(/*width=*/64, /*height=*/64);
+    buffer->InitializeData();
+    return VideoFrame::Builder().set_video_frame_buffer(buffer).build();
+  };
+  constexpr TimeDelta kRefreshDelay =
+      TimeDelta::Seconds(1) *
+      FrameCadenceAdapterInterface::kOnDiscardedFrameRefreshFramePeriod /
+      kMaxFps;
+
+  EXPECT_CALL(callback, RequestRefreshFrame).Times(0);
+  adapter->OnFrame(create_black_frame());
+  time_controller.AdvanceTime(TimeDelta::Seconds(1));
+  Mock::VerifyAndClearExpectations(&callback);
+
+  // A frame identical to the previous one arriving after a frame drop doesn't
+  // end the freeze, so the refresh frame is still requested.
+  adapter->OnDiscardedFrame();
+  time_controller.AdvanceTime(kRefreshDelay / 2);
+  adapter->OnFrame(create_black_frame());
+  EXPECT_CALL(callback, RequestRefreshFrame).Times(1);
+  time_controller.AdvanceTime(kRefreshDelay / 2);
+}
+
 TEST(FrameCadenceAdapterTest, RequestsRefreshFrameOnKeyFrameRequestWhenNew) {
   ZeroHertzFieldTrialEnabler enabler;
   MockCallback callback;
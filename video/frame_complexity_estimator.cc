@@ -0,0 +1,156 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/frame_complexity_estimator.h"
+
+#include <algorithm>
+
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/checks.h"
+#include "third_party/libyuv/include/libyuv/compare.h"
+#include "third_party/libyuv/include/libyuv/scale.h"
+
+namespace webrtc {
+
+namespace {
+
+// Each thumbnail pixel covers kDownscaleFactor x kDownscaleFactor source
+// pixels. Keeps the per-frame cost to a single read of the luma plane.
+constexpr int kDownscaleFactor = 8;
+// Added to the complexity before applying the ratio so that static content
+// still predicts a small, non-zero frame size.
+constexpr double kComplexityOffset = 1.0;
+constexpr float kBytesPerComplexityAlpha = 0.9f;
+// Number of encoded delta frames needed before predictions are made.
+constexpr int kMinModelUpdates = 5;
+
+struct LumaPlane {
+  const uint8_t* data;
+  int stride;
+};
+
+absl::optional<LumaPlane> GetLumaPlane(const VideoFrameBuffer& buffer) {
+  switch (buffer.type()) {
+    case VideoFrameBuffer::Type::kI420:
+    case VideoFrameBuffer::Type::kI420A: {
+      const I420BufferInterface* i420 = buffer.GetI420();
+      return LumaPlane{i420->DataY(), i420->StrideY()};
+    }
+    case VideoFrameBuffer::Type::kNV12: {
+      const NV12BufferInterface* nv12 = buffer.GetNV12();
+      return LumaPlane{nv12->DataY(), nv12->StrideY()};
+    }
+    default:
+      return absl::nullopt;
+  }
+}
+
+}  // namespace
+
+FrameComplexityEstimator::FrameComplexityEstimator()
+    : bytes_per_complexity_(kBytesPerComplexityAlpha) {}
+
+FrameComplexityEstimator::~FrameComplexityEstimator() = default;
+
+absl::optional<FrameComplexityEstimator::Estimate>
+FrameComplexityEstimator::OnFrame(const VideoFrame& frame) {
+  has_thumbnail_ = false;
+  candidate_frame_.reset();
+
+  absl::optional<LumaPlane> luma = GetLumaPlane(*frame.video_frame_buffer());
+  if (!luma) {
+    return absl::nullopt;
+  }
+
+  if (frame.width() != source_width_ || frame.height() != source_height_) {
+    source_width_ = frame.width();
+    source_height_ = frame.height();
+    thumbnail_width_ = std::max(1, source_width_ / kDownscaleFactor);
+    thumbnail_height_ = std::max(1, source_height_ / kDownscaleFactor);
+    thumbnail_.assign(thumbnail_width_ * thumbnail_height_, 0);
+    previous_thumbnail_.clear();
+  }
+
+  libyuv::ScalePlane(luma->data, luma->stride, source_width_, source_height_,
+                     thumbnail_.data(), thumbnail_width_, thumbnail_width_,
+                     thumbnail_height_, libyuv::kFilterBox);
+  has_thumbnail_ = true;
+
+  absl::optional<Estimate> estimate;
+  if (!previous_thumbnail_.empty()) {
+    const uint64_t sse = libyuv::ComputeSumSquareErrorPlane(
+        thumbnail_.data(), thumbnail_width_, previous_thumbnail_.data(),
+        thumbnail_width_, thumbnail_width_, thumbnail_height_);
+    estimate.emplace();
+    estimate->temporal_complexity =
+        static_cast<double>(sse) / (thumbnail_width_ * thumbnail_height_);
+    if (num_model_updates_ >= kMinModelUpdates) {
+      estimate->predicted_size = DataSize::Bytes(static_cast<int64_t>(
+          bytes_per_complexity_.filtered() *
+          (estimate->temporal_complexity + kComplexityOffset)));
+    }
+    candidate_frame_ = PendingFrame{frame.timestamp(),
+                                    estimate->temporal_complexity,
+                                    DataSize::Zero(), /*key_frame=*/false};
+  }
+  return estimate;
+}
+
+void FrameComplexityEstimator::OnFrameSentToEncoder() {
+  if (!has_thumbnail_) {
+    return;
+  }
+  UpdateModel();
+  pending_frame_ = candidate_frame_;
+  candidate_frame_.reset();
+  has_thumbnail_ = false;
+  thumbnail_.swap(previous_thumbnail_);
+  if (thumbnail_.size() != previous_thumbnail_.size()) {
+    thumbnail_.resize(previous_thumbnail_.size());
+  }
+}
+
+void FrameComplexityEstimator::OnEncodedFrame(uint32_t rtp_timestamp,
+                                              DataSize size,
+                                              bool key_frame) {
+  if (!pending_frame_ || pending_frame_->rtp_timestamp != rtp_timestamp) {
+    return;
+  }
+  pending_frame_->encoded_size += size;
+  pending_frame_->key_frame |= key_frame;
+}
+
+void FrameComplexityEstimator::Reset() {
+  previous_thumbnail_.clear();
+  has_thumbnail_ = false;
+  candidate_frame_.reset();
+  pending_frame_.reset();
+  bytes_per_complexity_.Reset(kBytesPerComplexityAlpha);
+  num_model_updates_ = 0;
+}
+
+void FrameComplexityEstimator::UpdateModel() {
+  if (!pending_frame_) {
+    return;
+  }
+  // Key frames are coded without reference to the previous frame, so their
+  // size says nothing about the temporal complexity. Frames the encoder
+  // dropped are skipped too.
+  if (!pending_frame_->key_frame && !pending_frame_->encoded_size.IsZero()) {
+    bytes_per_complexity_.Apply(
+        1.0f, static_cast<float>(
+                  pending_frame_->encoded_size.bytes() /
+                  (pending_frame_->temporal_complexity + kComplexityOffset)));
+    ++num_model_updates_;
+  }
+  pending_frame_.reset();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_FRAME_COMPLEXITY_ESTIMATOR_H_
+#define VIDEO_FRAME_COMPLEXITY_ESTIMATOR_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/units/data_size.h"
+#include "api/video/video_frame.h"
+#include "rtc_base/numerics/exp_filter.h"
+
+namespace webrtc {
+
+// Cheap pre-encode estimate of how many bytes a frame will cost to encode.
+//
+// The luma plane is box filtered down to a small thumbnail and compared with
+// the thumbnail of the previous frame. The mean squared difference between
+// the two (the "temporal complexity") is mapped to an expected encoded size
+// through a bytes-per-unit-of-complexity ratio that is learned from the actual
+// size of previously encoded delta frames. Both the downscale and the
+// comparison run on libyuv's SIMD kernels.
+class FrameComplexityEstimator {
+ public:
+  struct Estimate {
+    // Mean squared luma difference per thumbnail pixel against the previous
+    // frame.
+    double temporal_complexity = 0.0;
+    // Expected encoded size of the frame, if enough frames have been encoded
+    // to calibrate the model.
+    absl::optional<DataSize> predicted_size;
+  };
+
+  FrameComplexityEstimator();
+  ~FrameComplexityEstimator();
+
+  // Computes the estimate for `frame`. Returns nullopt for frames whose luma
+  // plane cannot be read without a conversion (e.g. native buffers) and for
+  // the first frame after a reset or a resolution change. The frame only
+  // becomes the reference for the next estimate once OnFrameSentToEncoder()
+  // is called, so that dropped frames are not compared against.
+  absl::optional<Estimate> OnFrame(const VideoFrame& frame);
+
+  // Called when the frame last passed to OnFrame() is sent to the encoder.
+  void OnFrameSentToEncoder();
+
+  // Reports the encoded size of (one layer of) the frame with the given RTP
+  // timestamp. Sizes of layers sharing a timestamp are summed.
+  void OnEncodedFrame(uint32_t rtp_timestamp, DataSize size, bool key_frame);
+
+  void Reset();
+
+ private:
+  void UpdateModel();
+
+  // Thumbnail of the frame last passed to OnFrame(), valid until it is either
+  // sent to the encoder or replaced by the next frame.
+  std::vector<uint8_t> thumbnail_;
+  bool has_thumbnail_ = false;
+  std::vector<uint8_t> previous_thumbnail_;
+  int thumbnail_width_ = 0;
+  int thumbnail_height_ = 0;
+  int source_width_ = 0;
+  int source_height_ = 0;
+
+  // The most recently encoded frame, used to pair encoder output with the
+  // complexity that was predicted for it.
+  struct PendingFrame {
+    uint32_t rtp_timestamp;
+    double temporal_complexity;
+    DataSize encoded_size;
+    bool key_frame;
+  };
+  absl::optional<PendingFrame> candidate_frame_;
+  absl::optional<PendingFrame> pending_frame_;
+  rtc::ExpFilter bytes_per_complexity_;
+  int num_model_updates_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_FRAME_COMPLEXITY_ESTIMATOR_H_
@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/frame_complexity_estimator.h"
+
+#include <string.h>
+
+#include "api/scoped_refptr.h"
+#include "api/units/data_size.h"
+#include "api/video/i420_buffer.h"
+#include "api/video/video_frame.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kWidth = 320;
+constexpr int kHeight = 240;
+
+VideoFrame CreateFrame(uint32_t rtp_timestamp, uint8_t luma, int width = kWidth,
+                       int height = kHeight) {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width, height);
+  I420Buffer::SetBlack(buffer.get());
+  memset(buffer->MutableDataY(), luma, buffer->StrideY() * height);
+  return VideoFrame::Builder()
+      .set_video_frame_buffer(buffer)
+      .set_timestamp_rtp(rtp_timestamp)
+      .build();
+}
+
+TEST(FrameComplexityEstimatorTest, NoEstimateForFirstFrame) {
+  FrameComplexityEstimator estimator;
+  EXPECT_FALSE(estimator.OnFrame(CreateFrame(0, 16)));
+  estimator.OnFrameSentToEncoder();
+  EXPECT_TRUE(estimator.OnFrame(CreateFrame(3000, 16)));
+}
+
+TEST(FrameComplexityEstimatorTest, StaticContentHasZeroComplexity) {
+  FrameComplexityEstimator estimator;
+  estimator.OnFrame(CreateFrame(0, 100));
+  estimator.OnFrameSentToEncoder();
+  absl::optional<FrameComplexityEstimator::Estimate> estimate =
+      estimator.OnFrame(CreateFrame(3000, 100));
+  ASSERT_TRUE(estimate);
+  EXPECT_EQ(estimate->temporal_complexity, 0.0);
+  EXPECT_FALSE(estimate->predicted_size);
+}
+
+TEST(FrameComplexityEstimatorTest, ComplexityIsMeanSquaredLumaDifference) {
+  FrameComplexityEstimator estimator;
+  estimator.OnFrame(CreateFrame(0, 100));
+  estimator.OnFrameSentToEncoder();
+  absl::optional<FrameComplexityEstimator::Estimate> estimate =
+      estimator.OnFrame(CreateFrame(3000, 110));
+  ASSERT_TRUE(estimate);
+  EXPECT_DOUBLE_EQ(estimate->temporal_complexity, 100.0);
+}
+
+TEST(FrameComplexityEstimatorTest, DroppedFrameDoesNotBecomeReference) {
+  FrameComplexityEstimator estimator;
+  estimator.OnFrame(CreateFrame(0, 100));
+  estimator.OnFrameSentToEncoder();
+  // Not sent to the encoder.
+  estimator.OnFrame(CreateFrame(3000, 110));
+  absl::optional<FrameComplexityEstimator::Estimate> estimate =
+      estimator.OnFrame(CreateFrame(6000, 100));
+  ASSERT_TRUE(estimate);
+  EXPECT_EQ(estimate->temporal_complexity, 0.0);
+}
+
+TEST(FrameComplexityEstimatorTest, ResetClearsReference) {
+  FrameComplexityEstimator estimator;
+  estimator.OnFrame(CreateFrame(0, 100));
+  estimator.OnFrameSentToEncoder();
+  estimator.Reset();
+  EXPECT_FALSE(estimator.OnFrame(CreateFrame(3000, 100)));
+}
+
+TEST(FrameComplexityEstimatorTest, ResolutionChangeResetsReference) {
+  FrameComplexityEstimator estimator;
+  estimator.OnFrame(CreateFrame(0, 100));
+  estimator.OnFrameSentToEncoder();
+  EXPECT_FALSE(estimator.OnFrame(CreateFrame(3000, 100, kWidth / 2,
+                                             kHeight / 2)));
+}
+
+TEST(FrameComplexityEstimatorTest, PredictsSizeFromEncodedDeltaFrames) {
+  FrameComplexityEstimator estimator;
+  constexpr DataSize kFrameSize = DataSize::Bytes(1000);
+  uint32_t rtp_timestamp = 0;
+  uint8_t luma = 0;
+  estimator.OnFrame(CreateFrame(rtp_timestamp, luma));
+  estimator.OnFrameSentToEncoder();
+  absl::optional<FrameComplexityEstimator::Estimate> estimate;
+  for (int i = 0; i < 20; ++i) {
+    // Constant complexity of 10^2 per frame.
+    rtp_timestamp += 3000;
+    luma += 10;
+    estimate = estimator.OnFrame(CreateFrame(rtp_timestamp, luma));
+    ASSERT_TRUE(estimate);
+    estimator.OnFrameSentToEncoder();
+    estimator.OnEncodedFrame(rtp_timestamp, kFrameSize, /*key_frame=*/false);
+  }
+  ASSERT_TRUE(estimate->predicted_size);
+  EXPECT_NEAR(estimate->predicted_size->bytes(), kFrameSize.bytes(), 10);
+}
+
+TEST(FrameComplexityEstimatorTest, KeyFramesDoNotCalibrateModel) {
+  FrameComplexityEstimator estimator;
+  uint32_t rtp_timestamp = 0;
+  estimator.OnFrame(CreateFrame(rtp_timestamp, 0));
+  estimator.OnFrameSentToEncoder();
+  absl::optional<FrameComplexityEstimator::Estimate> estimate;
+  for (int i = 0; i < 20; ++i) {
+    rtp_timestamp += 3000;
+    estimate = estimator.OnFrame(CreateFrame(rtp_timestamp, 0));
+    ASSERT_TRUE(estimate);
+    estimator.OnFrameSentToEncoder();
+    estimator.OnEncodedFrame(rtp_timestamp, DataSize::Bytes(10000),
+                             /*key_frame=*/true);
+  }
+  EXPECT_FALSE(estimate->predicted_size);
+}
+
+}  // namespace
+}  // namespace webrtc
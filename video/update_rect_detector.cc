@@ -0,0 +1,191 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/update_rect_detector.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "api/video/video_frame_buffer.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr uint64_t kHashSeed = 0xcbf29ce484222325;
+constexpr uint64_t kHashMultiplier = 0x9e3779b97f4a7c15;
+
+struct PlaneView {
+  const uint8_t* data;
+  int stride;
+  // Horizontal and vertical subsampling shift relative to luma.
+  int shift_x;
+  int shift_y;
+  // Bytes per sample, 2 for interleaved UV.
+  int bytes_per_sample;
+};
+
+// Returns the planes of `buffer`, or an empty vector if it can't be read
+// directly.
+std::vector<PlaneView> GetPlanes(const VideoFrameBuffer& buffer) {
+  switch (buffer.type()) {
+    case VideoFrameBuffer::Type::kI420:
+    case VideoFrameBuffer::Type::kI420A: {
+      const I420BufferInterface* i420 = buffer.GetI420();
+      return {{i420->DataY(), i420->StrideY(), 0, 0, 1},
+              {i420->DataU(), i420->StrideU(), 1, 1, 1},
+              {i420->DataV(), i420->StrideV(), 1, 1, 1}};
+    }
+    case VideoFrameBuffer::Type::kNV12: {
+      const NV12BufferInterface* nv12 = buffer.GetNV12();
+      return {{nv12->DataY(), nv12->StrideY(), 0, 0, 1},
+              {nv12->DataUV(), nv12->StrideUV(), 1, 1, 2}};
+    }
+    default:
+      return {};
+  }
+}
+
+// The part of a block that lies in one plane.
+struct PlaneBlock {
+  // Offset of the first byte.
+  int offset;
+  int row_bytes;
+  int rows;
+};
+
+PlaneBlock GetPlaneBlock(const PlaneView& plane,
+                         int x,
+                         int y,
+                         int width,
+                         int height) {
+  const int plane_x = x >> plane.shift_x;
+  const int plane_y = y >> plane.shift_y;
+  const int plane_width =
+      ((x + width + plane.shift_x) >> plane.shift_x) - plane_x;
+  const int plane_height =
+      ((y + height + plane.shift_y) >> plane.shift_y) - plane_y;
+  return {plane_y * plane.stride + plane_x * plane.bytes_per_sample,
+          plane_width * plane.bytes_per_sample, plane_height};
+}
+
+// Both steps are bijective, so a block that differs from the previous one in
+// a single word always gets a new hash.
+uint64_t Mix(uint64_t hash) {
+  hash *= kHashMultiplier;
+  return hash ^ (hash >> 32);
+}
+
+// Hashes `size` bytes a word at a time.
+uint64_t HashBytes(const uint8_t* data, int size, uint64_t hash) {
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t word;
+    memcpy(&word, data + i, sizeof(word));
+    hash = Mix(hash ^ word);
+  }
+  if (i < size) {
+    uint64_t word = 0;
+    memcpy(&word, data + i, size - i);
+    hash = Mix(hash ^ word);
+  }
+  return hash;
+}
+
+uint64_t HashBlock(const std::vector<PlaneView>& planes,
+                   int x,
+                   int y,
+                   int width,
+                   int height) {
+  uint64_t hash = kHashSeed;
+  for (const PlaneView& plane : planes) {
+    const PlaneBlock block = GetPlaneBlock(plane, x, y, width, height);
+    const uint8_t* row = plane.data + block.offset;
+    for (int i = 0; i < block.rows; ++i, row += plane.stride) {
+      hash = HashBytes(row, block.row_bytes, hash);
+    }
+  }
+  return hash;
+}
+
+}  // namespace
+
+UpdateRectDetector::UpdateRectDetector() = default;
+
+UpdateRectDetector::~UpdateRectDetector() = default;
+
+absl::optional<VideoFrame::UpdateRect> UpdateRectDetector::Detect(
+    const VideoFrame& frame) {
+  std::vector<PlaneView> planes = GetPlanes(*frame.video_frame_buffer());
+  if (planes.empty()) {
+    Reset();
+    return absl::nullopt;
+  }
+
+  bool full_update = false;
+  if (!type_ || frame.width() != width_ || frame.height() != height_ ||
+      *type_ != frame.video_frame_buffer()->type()) {
+    type_ = frame.video_frame_buffer()->type();
+    width_ = frame.width();
+    height_ = frame.height();
+    blocks_x_ = (width_ + kBlockSize - 1) / kBlockSize;
+    blocks_y_ = (height_ + kBlockSize - 1) / kBlockSize;
+    block_hashes_.assign(blocks_x_ * blocks_y_, 0);
+    full_update = true;
+  }
+
+  int min_block_x = blocks_x_;
+  int min_block_y = blocks_y_;
+  int max_block_x = -1;
+  int max_block_y = -1;
+  for (int block_y = 0; block_y < blocks_y_; ++block_y) {
+    const int y = block_y * kBlockSize;
+    const int height = std::min(kBlockSize, height_ - y);
+    for (int block_x = 0; block_x < blocks_x_; ++block_x) {
+      const int x = block_x * kBlockSize;
+      const int width = std::min(kBlockSize, width_ - x);
+      uint64_t hash = HashBlock(planes, x, y, width, height);
+      uint64_t& previous_hash = block_hashes_[block_y * blocks_x_ + block_x];
+      if (hash != previous_hash) {
+        previous_hash = hash;
+        min_block_x = std::min(min_block_x, block_x);
+        min_block_y = std::min(min_block_y, block_y);
+        max_block_x = std::max(max_block_x, block_x);
+        max_block_y = std::max(max_block_y, block_y);
+      }
+    }
+  }
+
+  VideoFrame::UpdateRect update_rect;
+  if (full_update) {
+    update_rect = VideoFrame::UpdateRect{0, 0, width_, height_};
+  } else if (max_block_x < 0) {
+    update_rect.MakeEmptyUpdate();
+  } else {
+    const int left = min_block_x * kBlockSize;
+    const int top = min_block_y * kBlockSize;
+    const int right = std::min(width_, (max_block_x + 1) * kBlockSize);
+    const int bottom = std::min(height_, (max_block_y + 1) * kBlockSize);
+    update_rect = VideoFrame::UpdateRect{left, top, right - left, bottom - top};
+  }
+  return update_rect;
+}
+
+void UpdateRectDetector::Reset() {
+  width_ = 0;
+  height_ = 0;
+  blocks_x_ = 0;
+  blocks_y_ = 0;
+  block_hashes_.clear();
+  type_ = absl::nullopt;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_UPDATE_RECT_DETECTOR_H_
+#define VIDEO_UPDATE_RECT_DETECTOR_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/video/video_frame.h"
+#include "api/video/video_frame_buffer.h"
+
+namespace webrtc {
+
+// Computes the changed region between consecutive frames for sources that do
+// not report damage themselves. The frame is split into blocks of
+// kBlockSize x kBlockSize pixels, each block is hashed (luma and chroma) a
+// word at a time into 64 bits, and the hashes are compared with those of the
+// previous frame, which is not kept. The result is the bounding box of all
+// changed blocks, which is empty for a static frame.
+class UpdateRectDetector {
+ public:
+  static constexpr int kBlockSize = 32;
+
+  UpdateRectDetector();
+  ~UpdateRectDetector();
+
+  // Returns the update rect of `frame` relative to the previous frame passed
+  // to this method. The first frame, and any frame with a new resolution or
+  // buffer type, yields a full-frame update. Returns nullopt, and forgets the
+  // previous frame, if the buffer can not be inspected without a conversion
+  // (e.g. native buffers).
+  absl::optional<VideoFrame::UpdateRect> Detect(const VideoFrame& frame);
+
+  void Reset();
+
+ private:
+  int width_ = 0;
+  int height_ = 0;
+  int blocks_x_ = 0;
+  int blocks_y_ = 0;
+  std::vector<uint64_t> block_hashes_;
+  absl::optional<VideoFrameBuffer::Type> type_;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_UPDATE_RECT_DETECTOR_H_
@@ -0,0 +1,115 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/update_rect_detector.h"
+
+#include "api/scoped_refptr.h"
+#include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
+#include "api/video/video_frame.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kWidth = 100;
+constexpr int kHeight = 70;
+constexpr int kBlockSize = UpdateRectDetector::kBlockSize;
+
+rtc::scoped_refptr<I420Buffer> CreateBlackI420Buffer() {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(kWidth, kHeight);
+  I420Buffer::SetBlack(buffer.get());
+  return buffer;
+}
+
+VideoFrame CreateFrame(rtc::scoped_refptr<VideoFrameBuffer> buffer) {
+  return VideoFrame::Builder().set_video_frame_buffer(buffer).build();
+}
+
+TEST(UpdateRectDetectorTest, FirstFrameIsFullUpdate) {
+  UpdateRectDetector detector;
+  EXPECT_EQ(detector.Detect(CreateFrame(CreateBlackI420Buffer())),
+            (VideoFrame::UpdateRect{0, 0, kWidth, kHeight}));
+}
+
+TEST(UpdateRectDetectorTest, IdenticalFrameIsEmptyUpdate) {
+  UpdateRectDetector detector;
+  detector.Detect(CreateFrame(CreateBlackI420Buffer()));
+  absl::optional<VideoFrame::UpdateRect> update_rect =
+      detector.Detect(CreateFrame(CreateBlackI420Buffer()));
+  ASSERT_TRUE(update_rect);
+  EXPECT_TRUE(update_rect->IsEmpty());
+}
+
+TEST(UpdateRectDetectorTest, ReportsBoundingBoxOfChangedBlocks) {
+  UpdateRectDetector detector;
+  detector.Detect(CreateFrame(CreateBlackI420Buffer()));
+
+  // Change one luma pixel in the second block row, first block column, and
+  // one chroma sample in the last (partial) block of the last block row.
+  rtc::scoped_refptr<I420Buffer> buffer = CreateBlackI420Buffer();
+  buffer->MutableDataY()[(kBlockSize + 1) * buffer->StrideY() + 1] = 255;
+  buffer->MutableDataU()[((kHeight - 1) / 2) * buffer->StrideU() +
+                         (kWidth - 1) / 2] = 0;
+  EXPECT_EQ(detector.Detect(CreateFrame(buffer)),
+            (VideoFrame::UpdateRect{0, kBlockSize, kWidth,
+                                    kHeight - kBlockSize}));
+}
+
+TEST(UpdateRectDetectorTest, DetectsCompensatingChanges) {
+  UpdateRectDetector detector;
+  // The luma pairs (1, 0) and (0, 33) at the start of the second block would
+  // hash the same with a byte-wise h * 33 + c hash such as DJB2.
+  rtc::scoped_refptr<I420Buffer> buffer = CreateBlackI420Buffer();
+  buffer->MutableDataY()[kBlockSize] = 1;
+  detector.Detect(CreateFrame(buffer));
+
+  buffer = CreateBlackI420Buffer();
+  buffer->MutableDataY()[kBlockSize + 1] = 33;
+  EXPECT_EQ(detector.Detect(CreateFrame(buffer)),
+            (VideoFrame::UpdateRect{kBlockSize, 0, kBlockSize, kBlockSize}));
+}
+
+TEST(UpdateRectDetectorTest, DetectsChangesInNv12Chroma) {
+  UpdateRectDetector detector;
+  rtc::scoped_refptr<NV12Buffer> buffer = NV12Buffer::Create(kWidth, kHeight);
+  buffer->InitializeData();
+  detector.Detect(CreateFrame(buffer));
+
+  rtc::scoped_refptr<NV12Buffer> changed_buffer =
+      NV12Buffer::Create(kWidth, kHeight);
+  changed_buffer->InitializeData();
+  // Modify the V sample of the chroma pixel at (kBlockSize, 0).
+  changed_buffer->MutableDataUV()[kBlockSize + 1] = 1;
+  EXPECT_EQ(detector.Detect(CreateFrame(changed_buffer)),
+            (VideoFrame::UpdateRect{kBlockSize, 0, kBlockSize, kBlockSize}));
+}
+
+TEST(UpdateRectDetectorTest, BufferTypeChangeIsFullUpdate) {
+  UpdateRectDetector detector;
+  detector.Detect(CreateFrame(CreateBlackI420Buffer()));
+  rtc::scoped_refptr<NV12Buffer> buffer = NV12Buffer::Create(kWidth, kHeight);
+  buffer->InitializeData();
+  EXPECT_EQ(detector.Detect(CreateFrame(buffer)),
+            (VideoFrame::UpdateRect{0, 0, kWidth, kHeight}));
+}
+
+TEST(UpdateRectDetectorTest, ResolutionChangeIsFullUpdate) {
+  UpdateRectDetector detector;
+  detector.Detect(CreateFrame(CreateBlackI420Buffer()));
+  rtc::scoped_refptr<I420Buffer> buffer =
+      I420Buffer::Create(kWidth / 2, kHeight / 2);
+  I420Buffer::SetBlack(buffer.get());
+  EXPECT_EQ(detector.Detect(CreateFrame(buffer)),
+            (VideoFrame::UpdateRect{0, 0, kWidth / 2, kHeight / 2}));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -304,6 +304,25 @@ void VideoSendStream::SetSource(
   video_stream_encoder_->SetSource(source, degradation_preference);
 }
 
+void VideoSendStream::SendEncodedFrame(
+    const EncodedImage& encoded_image,
+    const CodecSpecificInfo& codec_specific_info) {
+  // Mirror what VideoStreamEncoder reports for its own output so that send
+  // stats stay meaningful for forwarded frames.
+  stats_proxy_.OnSendEncodedImage(encoded_image, &codec_specific_info);
+  send_stream_.SendEncodedFrame(encoded_image, codec_specific_info);
+}
+
+void VideoSendStream::SetKeyFrameRequestCallback(
+    std::function<void()> callback) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  encoder_feedback_.SetKeyFrameRequestCallback(callback);
+  rtp_transport_queue_->PostTask(
+      SafeTask(transport_queue_safety_, [this, callback = std::move(callback)] {
+        send_stream_.SetKeyFrameRequestCallback(std::move(callback));
+      }));
+}
+
 void VideoSendStream::ReconfigureVideoEncoder(VideoEncoderConfig config) {
   RTC_DCHECK_RUN_ON(&thread_checker_);
   RTC_DCHECK_EQ(content_type_, config.content_type);
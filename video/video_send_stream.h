@@ -11,6 +11,7 @@
 #ifndef VIDEO_VIDEO_SEND_STREAM_H_
 #define VIDEO_VIDEO_SEND_STREAM_H_
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <vector>
@@ -86,6 +87,9 @@ class VideoSendStream : public webrtc::VideoSendStream {
 
   void SetSource(rtc::VideoSourceInterface<webrtc::VideoFrame>* source,
                  const DegradationPreference& degradation_preference) override;
+  void SendEncodedFrame(const EncodedImage& encoded_image,
+                        const CodecSpecificInfo& codec_specific_info) override;
+  void SetKeyFrameRequestCallback(std::function<void()> callback) override;
 
   void ReconfigureVideoEncoder(VideoEncoderConfig) override;
   Stats GetStats() override;
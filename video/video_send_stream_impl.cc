@@ -21,6 +21,7 @@
 #include "api/rtp_parameters.h"
 #include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
+#include "api/transport/rtp/dependency_descriptor.h"
 #include "api/video_codecs/video_codec.h"
 #include "call/rtp_transport_controller_send_interface.h"
 #include "call/video_send_stream.h"
@@ -236,6 +237,9 @@ VideoSendStreamImpl::VideoSendStreamImpl(
       video_stream_encoder_(video_stream_encoder),
       bandwidth_observer_(transport->GetBandwidthObserver()),
       rtp_video_sender_(rtp_video_sender),
+      content_type_(content_type),
+      initial_encoder_max_bitrate_bps_(encoder_max_bitrate_bps_),
+      initial_encoder_bitrate_priority_(initial_encoder_bitrate_priority),
       configured_pacing_factor_(
           GetConfiguredPacingFactor(*config_, content_type, pacing_config_)) {
   RTC_DCHECK_GE(config_->rtp.payload_type, 0);
@@ -362,7 +366,11 @@ void VideoSendStreamImpl::StartupVideoSendStream() {
         });
   }
 
-  video_stream_encoder_->SendKeyFrame();
+  if (key_frame_request_callback_) {
+    key_frame_request_callback_();
+  } else {
+    video_stream_encoder_->SendKeyFrame();
+  }
 }
 
 void VideoSendStreamImpl::Stop() {
@@ -585,6 +593,60 @@ EncodedImageCallback::Result VideoSendStreamImpl::OnEncodedImage(
   return result;
 }
 
+void VideoSendStreamImpl::SendEncodedFrame(
+    const EncodedImage& encoded_image,
+    const CodecSpecificInfo& codec_specific_info) {
+  TRACE_EVENT0("webrtc", "VideoSendStreamImpl::SendEncodedFrame");
+  // Only key frames of the lowest layer are guaranteed to carry the
+  // resolution and the full dependency structure.
+  if (encoded_image._frameType == VideoFrameType::kVideoFrameKey &&
+      encoded_image.SpatialIndex().value_or(0) == 0 &&
+      encoded_image._encodedWidth > 0 && encoded_image._encodedHeight > 0) {
+    InjectedFrameFormat format = {encoded_image._encodedWidth,
+                                  encoded_image._encodedHeight,
+                                  /*num_temporal_layers=*/1};
+    if (codec_specific_info.template_structure) {
+      for (const FrameDependencyTemplate& frame_template :
+           codec_specific_info.template_structure->templates) {
+        format.num_temporal_layers =
+            std::max(format.num_temporal_layers,
+                     static_cast<size_t>(frame_template.temporal_id + 1));
+      }
+    }
+    bool format_changed;
+    {
+      MutexLock lock(&injected_frame_lock_);
+      format_changed =
+          !injected_frame_format_ ||
+          injected_frame_format_->width != format.width ||
+          injected_frame_format_->height != format.height ||
+          injected_frame_format_->num_temporal_layers !=
+              format.num_temporal_layers;
+      injected_frame_format_ = format;
+    }
+    if (format_changed) {
+      // Configure the stream as if the encoder had produced a single stream
+      // of this format, within the bitrate limits the stream was created
+      // with.
+      VideoStream stream;
+      stream.width = format.width;
+      stream.height = format.height;
+      stream.max_bitrate_bps = initial_encoder_max_bitrate_bps_;
+      stream.num_temporal_layers = format.num_temporal_layers;
+      stream.bitrate_priority = initial_encoder_bitrate_priority_;
+      OnEncoderConfigurationChanged({stream}, /*is_svc=*/false, content_type_,
+                                    /*min_transmit_bitrate_bps=*/0);
+    }
+  }
+  OnEncodedImage(encoded_image, &codec_specific_info);
+}
+
+void VideoSendStreamImpl::SetKeyFrameRequestCallback(
+    std::function<void()> callback) {
+  RTC_DCHECK_RUN_ON(rtp_transport_queue_);
+  key_frame_request_callback_ = std::move(callback);
+}
+
 void VideoSendStreamImpl::OnDroppedFrame(
     EncodedImageCallback::DropReason reason) {
   activity_ = true;
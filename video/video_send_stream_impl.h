@@ -14,6 +14,7 @@
 #include <stdint.h>
 
 #include <atomic>
+#include <functional>
 #include <map>
 #include <memory>
 #include <vector>
@@ -36,6 +37,7 @@
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/system/no_unique_address.h"
 #include "rtc_base/task_utils/repeating_task.h"
 #include "rtc_base/thread_annotations.h"
@@ -83,6 +85,17 @@ class VideoSendStreamImpl : public webrtc::BitrateAllocatorObserver,
   void Start();
   void Stop();
 
+  // Routes a frame that was encoded elsewhere to the RTP sender exactly like
+  // output from the encoder. The resolution and number of temporal layers of
+  // the injected frames stand in for the encoder configuration when setting
+  // up the RTP sender and the bitrate allocator. May be called on any thread.
+  void SendEncodedFrame(const EncodedImage& encoded_image,
+                        const CodecSpecificInfo& codec_specific_info);
+
+  // While set, key frames needed when the stream starts are requested through
+  // `callback` instead of the encoder.
+  void SetKeyFrameRequestCallback(std::function<void()> callback);
+
   // TODO(holmer): Move these to RtpTransportControllerSend.
   std::map<uint32_t, RtpState> GetRtpStates() const;
 
@@ -162,6 +175,23 @@ class VideoSendStreamImpl : public webrtc::BitrateAllocatorObserver,
   RtcpBandwidthObserver* const bandwidth_observer_;
   RtpVideoSenderInterface* const rtp_video_sender_;
 
+  std::function<void()> key_frame_request_callback_
+      RTC_GUARDED_BY(rtp_transport_queue_);
+
+  // Format of the injected frames last used to configure the stream, see
+  // SendEncodedFrame().
+  struct InjectedFrameFormat {
+    uint32_t width;
+    uint32_t height;
+    size_t num_temporal_layers;
+  };
+  Mutex injected_frame_lock_;
+  absl::optional<InjectedFrameFormat> injected_frame_format_
+      RTC_GUARDED_BY(injected_frame_lock_);
+  const VideoEncoderConfig::ContentType content_type_;
+  const uint32_t initial_encoder_max_bitrate_bps_;
+  const double initial_encoder_bitrate_priority_;
+
   rtc::scoped_refptr<PendingTaskSafetyFlag> transport_queue_safety_ =
       PendingTaskSafetyFlag::CreateDetached();
 
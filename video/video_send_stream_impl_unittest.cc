@@ -23,6 +23,7 @@
 #include "modules/rtp_rtcp/source/rtp_sequence_number_map.h"
 #include "modules/video_coding/fec_controller_default.h"
 #include "rtc_base/experiments/alr_experiment.h"
+#include "rtc_base/experiments/min_video_bitrate_experiment.h"
 #include "rtc_base/fake_clock.h"
 #include "rtc_base/task_queue_for_test.h"
 #include "test/gmock.h"
@@ -48,6 +49,7 @@ using ::testing::AllOf;
 using ::testing::Field;
 using ::testing::Invoke;
 using ::testing::NiceMock;
+using ::testing::Property;
 using ::testing::Return;
 
 constexpr int64_t kDefaultInitialBitrateBps = 333000;
@@ -898,6 +900,113 @@ TEST_F(VideoSendStreamImplTest, KeepAliveOnDroppedFrame) {
   ASSERT_TRUE(done.Wait(TimeDelta::Seconds(5)));
 }
 
+TEST_F(VideoSendStreamImplTest, ForwardsInjectedEncodedFrameToRtpSender) {
+  std::unique_ptr<VideoSendStreamImpl> vss_impl = CreateVideoSendStreamImpl(
+      kDefaultInitialBitrateBps, kDefaultBitratePriority,
+      VideoEncoderConfig::ContentType::kRealtimeVideo);
+  test_queue_.SendTask([&] {
+    vss_impl->Start();
+
+    EncodedImage encoded_image;
+    encoded_image.SetTimestamp(90000);
+    encoded_image._frameType = VideoFrameType::kVideoFrameKey;
+    CodecSpecificInfo codec_specific;
+    codec_specific.codecType = kVideoCodecGeneric;
+    codec_specific.generic_frame_info =
+        GenericFrameInfo::Builder().S(0).T(0).Dtis("S").Build();
+    codec_specific.generic_frame_info->encoder_buffers = {{0, false, true}};
+    codec_specific.template_structure.emplace();
+    codec_specific.template_structure->num_decode_targets = 1;
+
+    EXPECT_CALL(rtp_video_sender_,
+                OnEncodedImage(Property(&EncodedImage::Timestamp, 90000u),
+                               Field(&CodecSpecificInfo::template_structure,
+                                     ::testing::Ne(absl::nullopt))))
+        .WillOnce(Return(
+            EncodedImageCallback::Result(EncodedImageCallback::Result::OK)));
+    vss_impl->SendEncodedFrame(encoded_image, codec_specific);
+
+    vss_impl->Stop();
+  });
+}
+
+TEST_F(VideoSendStreamImplTest, ConfiguresStreamFromInjectedKeyFrames) {
+  std::unique_ptr<VideoSendStreamImpl> vss_impl = CreateVideoSendStreamImpl(
+      kDefaultInitialBitrateBps, kDefaultBitratePriority,
+      VideoEncoderConfig::ContentType::kRealtimeVideo);
+  test_queue_.SendTask([&] {
+    vss_impl->Start();
+
+    EncodedImage encoded_image;
+    encoded_image._frameType = VideoFrameType::kVideoFrameKey;
+    encoded_image._encodedWidth = 640;
+    encoded_image._encodedHeight = 360;
+    CodecSpecificInfo codec_specific;
+    codec_specific.codecType = kVideoCodecGeneric;
+    codec_specific.template_structure.emplace();
+    codec_specific.template_structure->num_decode_targets = 2;
+    codec_specific.template_structure->templates = {
+        FrameDependencyTemplate().T(0), FrameDependencyTemplate().T(1)};
+
+    ON_CALL(rtp_video_sender_, OnEncodedImage)
+        .WillByDefault(Return(
+            EncodedImageCallback::Result(EncodedImageCallback::Result::OK)));
+    EXPECT_CALL(rtp_video_sender_, SetEncodingData(640, 360, 2));
+    EXPECT_CALL(bitrate_allocator_, AddObserver(vss_impl.get(), _))
+        .WillOnce(Invoke(
+            [&](BitrateAllocatorObserver*, MediaStreamAllocationConfig config) {
+              EXPECT_EQ(config.min_bitrate_bps,
+                        static_cast<uint32_t>(kDefaultMinVideoBitrateBps));
+              EXPECT_EQ(config.max_bitrate_bps, kDefaultInitialBitrateBps);
+              EXPECT_EQ(config.bitrate_priority, kDefaultBitratePriority);
+            }));
+    vss_impl->SendEncodedFrame(encoded_image, codec_specific);
+    ::testing::Mock::VerifyAndClearExpectations(&rtp_video_sender_);
+    ::testing::Mock::VerifyAndClearExpectations(&bitrate_allocator_);
+
+    // Delta frames and key frames of the same format leave the configuration
+    // alone.
+    EXPECT_CALL(rtp_video_sender_, SetEncodingData).Times(0);
+    EXPECT_CALL(bitrate_allocator_, AddObserver).Times(0);
+    vss_impl->SendEncodedFrame(encoded_image, codec_specific);
+    encoded_image._frameType = VideoFrameType::kVideoFrameDelta;
+    encoded_image._encodedWidth = 0;
+    encoded_image._encodedHeight = 0;
+    vss_impl->SendEncodedFrame(encoded_image, codec_specific);
+    ::testing::Mock::VerifyAndClearExpectations(&rtp_video_sender_);
+
+    // A new resolution reconfigures the stream.
+    encoded_image._frameType = VideoFrameType::kVideoFrameKey;
+    encoded_image._encodedWidth = 1280;
+    encoded_image._encodedHeight = 720;
+    EXPECT_CALL(rtp_video_sender_, SetEncodingData(1280, 720, 2));
+    vss_impl->SendEncodedFrame(encoded_image, codec_specific);
+
+    vss_impl->Stop();
+  });
+}
+
+TEST_F(VideoSendStreamImplTest, RequestsKeyFrameFromCallbackOnStart) {
+  std::unique_ptr<VideoSendStreamImpl> vss_impl = CreateVideoSendStreamImpl(
+      kDefaultInitialBitrateBps, kDefaultBitratePriority,
+      VideoEncoderConfig::ContentType::kRealtimeVideo);
+  test_queue_.SendTask([&] {
+    int num_key_frame_requests = 0;
+    vss_impl->SetKeyFrameRequestCallback(
+        [&num_key_frame_requests] { ++num_key_frame_requests; });
+    EXPECT_CALL(video_stream_encoder_, SendKeyFrame).Times(0);
+    vss_impl->Start();
+    EXPECT_EQ(num_key_frame_requests, 1);
+    vss_impl->Stop();
+
+    vss_impl->SetKeyFrameRequestCallback(nullptr);
+    EXPECT_CALL(video_stream_encoder_, SendKeyFrame);
+    vss_impl->Start();
+    EXPECT_EQ(num_key_frame_requests, 1);
+    vss_impl->Stop();
+  });
+}
+
 TEST_F(VideoSendStreamImplTest, ConfiguresBitratesForSvc) {
   struct TestConfig {
     bool screenshare = false;
@@ -64,6 +64,11 @@ const int64_t kFrameLogIntervalMs = 60000;
 const int64_t kPendingFrameTimeoutMs = 1000;
 
 constexpr char kFrameDropperFieldTrial[] = "WebRTC-FrameDropper";
+constexpr char kPredictiveFrameDropperFieldTrial[] =
+    "WebRTC-PredictiveFrameDropper";
+// Upper bound on back-to-back drops based on predicted frame size, so that a
+// miscalibrated model can not starve the encoder.
+constexpr int kMaxConsecutivePredictedFrameDrops = 2;
 
 // TODO(bugs.webrtc.org/13572): Remove this kill switch after deploying the
 // feature.
@@ -662,6 +667,9 @@ VideoStreamEncoder::VideoStreamEncoder(
       fec_controller_override_(nullptr),
       force_disable_frame_dropper_(false),
       pending_frame_drops_(0),
+      predictive_frame_dropping_enabled_(
+          field_trials.IsEnabled(kPredictiveFrameDropperFieldTrial)),
+      consecutive_predicted_frame_drops_(0),
       cwnd_frame_counter_(0),
       next_frame_types_(1, VideoFrameType::kVideoFrameDelta),
       frame_encode_metadata_writer_(this),
@@ -1252,6 +1260,9 @@ void VideoStreamEncoder::ReconfigureEncoder() {
 
   frame_dropper_.Reset();
   frame_dropper_.SetRates(codec.startBitrate, max_framerate_);
+  // The encoder starts over from a key frame, so earlier frames are no longer
+  // a valid reference and the size model may not match the new settings.
+  complexity_estimator_.Reset();
   // Force-disable frame dropper if either:
   //  * We have screensharing with layers.
   //  * "WebRTC-FrameDropper" field trial is "Disabled".
@@ -1750,9 +1761,54 @@ void VideoStreamEncoder::MaybeEncodeVideoFrame(const VideoFrame& video_frame,
     return;
   }
 
+  if (predictive_frame_dropping_enabled_ &&
+      DropDueToPredictedSize(video_frame, frame_dropping_enabled)) {
+    RTC_LOG(LS_VERBOSE) << "Drop Frame: predicted to overshoot target bitrate "
+                        << (last_encoder_rate_settings_
+                                ? last_encoder_rate_settings_->encoder_target
+                                      .bps()
+                                : 0);
+    OnDroppedFrame(
+        EncodedImageCallback::DropReason::kDroppedByMediaOptimizations);
+    accumulated_update_rect_.Union(video_frame.update_rect());
+    accumulated_update_rect_is_valid_ &= video_frame.has_update_rect();
+    return;
+  }
+  if (predictive_frame_dropping_enabled_) {
+    // Only frames that reach the encoder become the reference for the next
+    // complexity estimate.
+    complexity_estimator_.OnFrameSentToEncoder();
+  }
+
   EncodeVideoFrame(video_frame, time_when_posted_us);
 }
 
+bool VideoStreamEncoder::DropDueToPredictedSize(const VideoFrame& video_frame,
+                                                bool frame_dropping_enabled) {
+  RTC_DCHECK_RUN_ON(&encoder_queue_);
+  absl::optional<FrameComplexityEstimator::Estimate> estimate =
+      complexity_estimator_.OnFrame(video_frame);
+  if (!estimate) {
+    return false;
+  }
+  encoder_stats_observer_->OnFrameComplexityEstimated(
+      estimate->temporal_complexity, estimate->predicted_size);
+
+  // Never drop a requested key frame; the estimate only models delta frames.
+  const bool key_frame_requested =
+      absl::c_linear_search(next_frame_types_, VideoFrameType::kVideoFrameKey);
+  if (!frame_dropping_enabled || key_frame_requested ||
+      !estimate->predicted_size ||
+      consecutive_predicted_frame_drops_ >=
+          kMaxConsecutivePredictedFrameDrops ||
+      !frame_dropper_.WouldOverflow(estimate->predicted_size->bytes())) {
+    consecutive_predicted_frame_drops_ = 0;
+    return false;
+  }
+  ++consecutive_predicted_frame_drops_;
+  return true;
+}
+
 void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
                                           int64_t time_when_posted_us) {
   RTC_DCHECK_RUN_ON(&encoder_queue_);
@@ -2298,6 +2354,10 @@ void VideoStreamEncoder::RunPostEncode(const EncodedImage& encoded_image,
   if (!frame_size.IsZero()) {
     frame_dropper_.Fill(frame_size.bytes(), !keyframe);
   }
+  if (predictive_frame_dropping_enabled_) {
+    complexity_estimator_.OnEncodedFrame(encoded_image.Timestamp(), frame_size,
+                                         keyframe);
+  }
 
   stream_resource_manager_.OnEncodeCompleted(encoded_image, time_sent_us,
                                              encode_duration_us, frame_size);
@@ -47,6 +47,7 @@
 #include "video/adaptation/video_stream_encoder_resource_manager.h"
 #include "video/encoder_bitrate_adjuster.h"
 #include "video/frame_cadence_adapter.h"
+#include "video/frame_complexity_estimator.h"
 #include "video/frame_encode_metadata_writer.h"
 #include "video/video_source_sink_controller.h"
 
@@ -219,6 +220,11 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
   // Indicates whether frame should be dropped because the pixel count is too
   // large for the current bitrate configuration.
   bool DropDueToSize(uint32_t pixel_count) const RTC_RUN_ON(&encoder_queue_);
+  // Indicates whether frame should be dropped because its pre-encode
+  // complexity estimate predicts that it would overflow the frame dropper.
+  bool DropDueToPredictedSize(const VideoFrame& video_frame,
+                              bool frame_dropping_enabled)
+      RTC_RUN_ON(&encoder_queue_);
 
   // Implements EncodedImageCallback.
   EncodedImageCallback::Result OnEncodedImage(
@@ -365,6 +371,14 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
   // the worker thread.
   std::atomic<int> pending_frame_drops_;
 
+  // Pre-encode complexity estimate, used to skip frames that would overflow
+  // `frame_dropper_` before spending CPU on encoding them. Enabled by the
+  // "WebRTC-PredictiveFrameDropper" field trial.
+  const bool predictive_frame_dropping_enabled_;
+  FrameComplexityEstimator complexity_estimator_
+      RTC_GUARDED_BY(&encoder_queue_);
+  int consecutive_predicted_frame_drops_ RTC_GUARDED_BY(&encoder_queue_);
+
   // Congestion window frame drop ratio (drop 1 in every
   // cwnd_frame_drop_interval_ frames).
   absl::optional<int> cwnd_frame_drop_interval_ RTC_GUARDED_BY(&encoder_queue_);
@@ -652,6 +652,11 @@ class MockableSendStatisticsProxy : public SendStatisticsProxy {
     on_frame_dropped_ = std::move(callback);
   }
 
+  void SetFrameComplexityEstimatedCallback(
+      std::function<void(double)> callback) {
+    on_frame_complexity_estimated_ = std::move(callback);
+  }
+
  private:
   void OnFrameDropped(DropReason reason) override {
     SendStatisticsProxy::OnFrameDropped(reason);
@@ -659,9 +664,17 @@ class MockableSendStatisticsProxy : public SendStatisticsProxy {
       on_frame_dropped_(reason);
   }
 
+  void OnFrameComplexityEstimated(
+      double temporal_complexity,
+      absl::optional<DataSize> predicted_size) override {
+    if (on_frame_complexity_estimated_)
+      on_frame_complexity_estimated_(temporal_complexity);
+  }
+
   mutable Mutex lock_;
   absl::optional<VideoSendStream::Stats> mock_stats_ RTC_GUARDED_BY(lock_);
   std::function<void(DropReason)> on_frame_dropped_;
+  std::function<void(double)> on_frame_complexity_estimated_;
 };
 
 class SimpleVideoStreamEncoderFactory {
@@ -1725,6 +1738,42 @@ TEST_F(VideoStreamEncoderTest, DropsPendingFramesOnSlowEncode) {
   EXPECT_EQ(1, dropped_count);
 }
 
+TEST_F(VideoStreamEncoderTest, ReconfigurationResetsFrameComplexityEstimate) {
+  webrtc::test::ScopedKeyValueConfig field_trials(
+      field_trials_, "WebRTC-PredictiveFrameDropper/Enabled/");
+  ResetEncoder("VP8", 1, 1, 1, false);
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      kTargetBitrate, kTargetBitrate, kTargetBitrate, 0, 0, 0);
+
+  int num_estimates = 0;
+  stats_proxy_->SetFrameComplexityEstimatedCallback(
+      [&num_estimates](double) { ++num_estimates; });
+
+  // The first frame has nothing to be compared against.
+  video_source_.IncomingCapturedFrame(
+      CreateFrame(1, codec_width_, codec_height_));
+  WaitForEncodedFrame(1);
+  EXPECT_EQ(0, num_estimates);
+  video_source_.IncomingCapturedFrame(
+      CreateFrame(2, codec_width_, codec_height_));
+  WaitForEncodedFrame(2);
+  EXPECT_EQ(1, num_estimates);
+
+  // A reconfigured encoder starts without a reference frame.
+  video_stream_encoder_->ConfigureEncoder(video_encoder_config_.Copy(),
+                                          kMaxPayloadLength);
+  video_source_.IncomingCapturedFrame(
+      CreateFrame(3, codec_width_, codec_height_));
+  WaitForEncodedFrame(3);
+  EXPECT_EQ(1, num_estimates);
+  video_source_.IncomingCapturedFrame(
+      CreateFrame(4, codec_width_, codec_height_));
+  WaitForEncodedFrame(4);
+  EXPECT_EQ(2, num_estimates);
+
+  video_stream_encoder_->Stop();
+}
+
 TEST_F(VideoStreamEncoderTest, NativeFrameWithoutI420SupportGetsDelivered) {
   video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
       kTargetBitrate, kTargetBitrate, kTargetBitrate, 0, 0, 0);